@@ -0,0 +1,205 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_ALLOCATOR_MMAP_HPP
+#define WATER_ALLOCATOR_MMAP_HPP
+#include <water/water.hpp>
+#include <water/throw_if.hpp>
+#include <water/allocator_malloc.hpp>
+#include <sys/mman.h>
+#include <unistd.h>
+namespace water {
+
+/*
+
+Allocators that get memory directly from the operating system with mmap, and give it back with
+munmap. For the large blocks of xml_json::memory (json::memory and xml::memory), temporary::memory
+and fixed::memory_atomic. Only for POSIX systems.
+
+    water::json::memory<water::allocator_mmap<>> json_memory;
+    water::temporary::memory<water::allocator_mmap_nothrow<water::allocator_mmap_populate>> temporary_memory;
+    water::fixed::memory_atomic<water::allocator_mmap_nothrow<water::allocator_mmap_transparent>> atomic_memory{64, 1 << 16};
+
+options_ are bits:
+
+- allocator_mmap_huge uses explicit huge pages, MAP_HUGETLB. Linux only, and the huge pages must be
+  reserved (vm.nr_hugepages). If that fails it uses normal pages. Only for allocations of at least
+  allocator_mmap_huge_page_size, those are rounded up to a multiple of it.
+- allocator_mmap_transparent asks for transparent huge pages with madvise(MADV_HUGEPAGE). Linux only.
+  Allocations of at least allocator_mmap_huge_page_size are aligned to it, so the kernel can use
+  huge pages for all of it.
+- allocator_mmap_populate makes the kernel fault in every page before allocate returns, with
+  MAP_POPULATE. Linux only. Then the program does not page fault when it first writes the memory.
+
+Allocations smaller than allocator_mmap_small use allocator_malloc_nothrow, because mmap uses at
+least one page. free must get the same size as allocate, munmap needs it.
+
+The arenas allocate blocks of their block size, make it large enough for the huge pages to matter.
+
+*/
+
+unsigned constexpr
+    allocator_mmap_huge = 1,
+    allocator_mmap_transparent = 2,
+    allocator_mmap_populate = 4;
+
+size_t constexpr
+    allocator_mmap_small = 64 * 1024,
+    allocator_mmap_huge_page_size = 2 * 1024 * 1024;
+
+namespace _ {
+
+    inline size_t allocator_mmap_page_size() noexcept {
+        static size_t const size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    inline size_t allocator_mmap_round(size_t bytes, size_t to) noexcept {
+        return bytes + (bytes % to ? to - bytes % to : 0);
+    }
+
+    template<unsigned options_>
+    size_t allocator_mmap_size(size_t bytes) noexcept {
+        if((options_ & allocator_mmap_huge) && bytes >= allocator_mmap_huge_page_size)
+            return allocator_mmap_round(bytes, allocator_mmap_huge_page_size);
+        return allocator_mmap_round(bytes, allocator_mmap_page_size());
+    }
+
+    inline void* allocator_mmap_map(size_t bytes, int flags) noexcept {
+        void *r = ::mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+        return r != MAP_FAILED ? r : 0;
+    }
+
+    inline void* allocator_mmap_aligned(size_t bytes, size_t align, int flags) noexcept {
+        // map more, then unmap the parts before and after the aligned part
+        char *m = static_cast<char*>(allocator_mmap_map(bytes + align, flags));
+        if(!m)
+            return 0;
+        size_t before = reinterpret_cast<size_t>(m) % align;
+        if(before)
+            before = align - before;
+        if(before)
+            ::munmap(m, before);
+        ::munmap(m + before + bytes, align - before);
+        return m + before;
+    }
+
+    template<unsigned options_>
+    void* allocator_mmap_allocate(size_t bytes) noexcept {
+        if(bytes < allocator_mmap_small)
+            return allocator_malloc_nothrow{}.allocate(bytes);
+        size_t size = allocator_mmap_size<options_>(bytes);
+        int flags = 0;
+        #ifdef MAP_POPULATE
+        if(options_ & allocator_mmap_populate)
+            flags |= MAP_POPULATE;
+        #endif
+        void *r = 0;
+        #ifdef MAP_HUGETLB
+        if((options_ & allocator_mmap_huge) && bytes >= allocator_mmap_huge_page_size)
+            r = allocator_mmap_map(size, flags | MAP_HUGETLB);
+        if(r)
+            return r;
+        #endif
+        #ifdef MADV_HUGEPAGE
+        if((options_ & allocator_mmap_transparent) && size >= allocator_mmap_huge_page_size) {
+            r = allocator_mmap_aligned(size, allocator_mmap_huge_page_size, flags);
+            if(r)
+                ::madvise(r, size, MADV_HUGEPAGE);
+            return r;
+        }
+        #endif
+        return allocator_mmap_map(size, flags);
+    }
+
+    template<unsigned options_>
+    void allocator_mmap_free(void *pointer, size_t bytes) noexcept {
+        if(bytes < allocator_mmap_small)
+            allocator_malloc_nothrow{}.free(pointer, bytes);
+        else if(pointer)
+            ::munmap(pointer, allocator_mmap_size<options_>(bytes));
+    }
+
+}
+
+
+template<unsigned options_ = 0>
+struct allocator_mmap_nothrow
+{
+    static unsigned constexpr options = options_;
+
+    void* allocate(size_t bytes) noexcept {
+        return _::allocator_mmap_allocate<options_>(bytes);
+    }
+
+    void free(void *pointer, size_t bytes) noexcept {
+        _::allocator_mmap_free<options_>(pointer, bytes);
+    }
+
+    template<typename type_>
+    type_* allocate(size_t count = 1) noexcept {
+        // mmap memory is aligned to the page size
+        if(sizeof(type_) * count < allocator_mmap_small)
+            return allocator_malloc_nothrow{}.template allocate<type_>(count);
+        return static_cast<type_*>(allocate(sizeof(type_) * count));
+    }
+
+    template<typename type_>
+    void free(void *pointer, size_t count = 1) noexcept {
+        if(sizeof(type_) * count < allocator_mmap_small)
+            allocator_malloc_nothrow{}.template free<type_>(pointer, count);
+        else
+            free(pointer, sizeof(type_) * count);
+    }
+
+    constexpr bool operator==(allocator_mmap_nothrow const&) const noexcept {
+        return true;
+    }
+
+    constexpr bool operator!=(allocator_mmap_nothrow const&) const noexcept {
+        return false;
+    }
+};
+
+
+template<unsigned options_ = 0>
+struct allocator_mmap
+{
+    struct exception {};
+
+    static unsigned constexpr options = options_;
+
+    void* allocate(size_t bytes) noexcept(false) {
+        void *r = allocator_mmap_nothrow<options_>{}.allocate(bytes);
+        if(!r) throw_if<exception>();
+        return r;
+    }
+
+    void free(void *pointer, size_t bytes) noexcept {
+        allocator_mmap_nothrow<options_>{}.free(pointer, bytes);
+    }
+
+    template<typename type_>
+    type_* allocate(size_t count = 1) noexcept(false) {
+        type_ *r = allocator_mmap_nothrow<options_>{}.template allocate<type_>(count);
+        if(!r) throw_if<exception>();
+        return r;
+    }
+
+    template<typename type_>
+    void free(void *pointer, size_t count = 1) noexcept {
+        allocator_mmap_nothrow<options_>{}.template free<type_>(pointer, count);
+    }
+
+    constexpr bool operator==(allocator_mmap const&) const noexcept {
+        return true;
+    }
+
+    constexpr bool operator!=(allocator_mmap const&) const noexcept {
+        return false;
+    }
+};
+
+}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2018 Johan Paulsson
+// Copyright 2018-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -7,6 +7,7 @@
 #include <water/water.hpp>
 #include <water/test.hpp>
 #include <water/base64/base64.hpp>
+#include <water/allocator.hpp>
 namespace water { namespace base64 { namespace tests {
 
 inline bool equal(void const* a, void const* b, size_t s) {
@@ -104,6 +105,84 @@ void size() {
     
 }
 
+inline void bulk() {
+    // encode and decode to a pointer can use simd, compare them to encode and decode with a function
+    byte
+        original[300],
+        encode1[encode_size(300)],
+        encode2[encode_size(300)],
+        decode1[300],
+        decode2[300];
+    unsigned random = 1;
+    for(auto& a : original) {
+        random = random * 1103515245u + 12345u;
+        a = static_cast<byte>(random >> 16);
+    }
+    for(size_t size = 0; size <= 300; ++size) {
+        size_t s1 = encode(encode1, original, size);
+        byte *e2 = encode2;
+        encode([&e2](byte a, byte b, byte c = pad, byte d = pad) { e2[0] = a; e2[1] = b; e2[2] = c; e2[3] = d; e2 += 4;}, original, size);
+        ___water_test(s1 == static_cast<size_t>(e2 - encode2) && equal(encode1, encode2, s1));
+        
+        // decode, decode in place, decode in parts
+        s1 = decode(decode1, encode1, s1);
+        ___water_test(s1 == size && equal(original, decode1, size));
+        s1 = decode(encode2, encode2, encode_size(size));
+        ___water_test(s1 == size && equal(original, encode2, size));
+        size_t to = 0, from = 0, left = encode_size(size);
+        while(left) {
+            size_t part = left > 64 ? 64 : left;
+            to += decode(decode2 + to, encode1 + from, part, part != left);
+            from += part;
+            left -= part;
+        }
+        ___water_test(to == size && equal(original, decode2, size));
+    }
+    // a character that is not base64 anywhere
+    byte const not_base64[] = {0, '-', '_', ' ', '\n', '=', 0x80, 0xff};
+    for(size_t size = 1; size <= 120; ++size) {
+        size_t s = encode(encode1, original, size);
+        for(size_t at = 0; at != s; ++at)
+            for(auto n : not_base64) {
+                byte keep = encode1[at];
+                encode1[at] = n;
+                byte *d2 = decode2;
+                size_t s2 = decode([&d2](byte a) { *d2++ = a; }, encode1, s);
+                ___water_test(decode(decode1, encode1, s) == s2);
+                encode1[at] = keep;
+            }
+    }
+}
+
+inline void bulk_exact_size() {
+    // decode to a buffer of exactly decode_size bytes. the input is cut at every length, so it can be
+    // 4n+1 or end in the middle of a group. a buffer of 0 bytes is the end of 1 byte
+    byte original[200];
+    byte encoded[encode_size(200)];
+    unsigned random = 1;
+    for(auto& a : original) {
+        random = random * 1103515245u + 12345u;
+        a = static_cast<byte>(random >> 16);
+    }
+    size_t encoded_size = encode(encoded, original, sizeof(original));
+    byte expect[200];
+    for(size_t size = 1; size <= encoded_size; ++size)
+        for(unsigned m = 0; m != 2; ++m) {
+            bool more = m != 0;
+            size_t
+                to_size = decode_size(size),
+                allocated = to_size ? to_size : 1;
+            auto *to = static_cast<byte*>(allocator{}.allocate(allocated));
+            byte *e = expect;
+            size_t r = decode([&e](byte a) { *e++ = a; }, encoded, size, more);
+            ___water_test(decode(to + (allocated - to_size), encoded, size, more) == r);
+            ___water_test(r <= to_size && equal(expect, to + (allocated - to_size), r));
+            if(size % 4 == 1 || (more && size % 4))
+                ___water_test(r == 0);
+            allocator{}.free(to, allocated);
+        }
+}
+
 inline void all() {
     size<1>();
     size<2>();
@@ -122,6 +201,8 @@ inline void all() {
     size<1022>();
     size<1021>();
     size<1020>();
+    bulk();
+    bulk_exact_size();
 };
 
 }}}
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -20,7 +20,8 @@ class block_atomic
     unsigned_
         mysize, // number of allocations, not size in bytes
         mymask = 0; // number of bits needed for mysize, the rest of my is a change counter
-    block_atomic *mylist;
+    atomic<block_atomic*> mylist;
+    block_atomic *myretired = 0; // memory_atomic::trim list
     void *mymemory;
     void *myallocation;
     size_t myallocation_size;
@@ -101,12 +102,89 @@ public:
         } while(!my.compare_exchange_weak(a, p | count));
     }
 
+    size_t allocate(size_t bytes, void **to, size_t size, bool& more) {
+        // allocate at most size with one compare exchange, return how many
+        unsigned_ a = my.load(memory_order_acquire);
+        unsigned_ at, count;
+        size_t r;
+        do {
+            at = a & mymask;
+            count = a & ~mymask;
+            r = 0;
+            while(r != size && at < mysize) {
+                void *p = static_cast<char*>(memory()) + at * bytes;
+                to[r++] = p;
+                at = static_cast<unsigned_>(*static_cast<size_t*>(p)); // garbage if another thread got p, then compare exchange fails
+            }
+        } while(r && !my.compare_exchange_weak(a, at | count));
+        more = at < mysize;
+        return r;
+    }
+
+    void free(void **from, size_t size, size_t bytes) {
+        // free size pointers that are all inside this, with one compare exchange
+        ___water_assert(size);
+        for(size_t i = 1; i < size; ++i)
+            *static_cast<size_t*>(from[i - 1]) = index(from[i], bytes);
+        unsigned_
+            p = index(from[0], bytes),
+            a = my.load(memory_order_relaxed),
+            next,
+            count;
+        do {
+            next = a & mymask;
+            count = (a & ~mymask) + (mymask + 1);
+            *static_cast<size_t*>(from[size - 1]) = next;
+        } while(!my.compare_exchange_weak(a, p | count));
+    }
+
+    bool take_if_unused(size_t bytes) {
+        // used by memory_atomic::trim, with the memory_atomic mutex locked
+        // take the whole free list. if it has every allocation, nothing is allocated from this and
+        // nothing can be, return true. otherwise give the free list back
+        unsigned_ a = my.load(memory_order_acquire);
+        unsigned_ first, count;
+        do {
+            first = a & mymask;
+            count = a & ~mymask;
+        } while(!my.compare_exchange_weak(a, mysize | count));
+        if(first >= mysize)
+            return false;
+        size_t *last;
+        unsigned_ at = first, taken = 0;
+        do {
+            last = static_cast<size_t*>(static_cast<void*>(static_cast<char*>(memory()) + at * bytes));
+            at = static_cast<unsigned_>(*last);
+            ++taken;
+        } while(at < mysize);
+        if(taken == mysize)
+            return true;
+        a = my.load(memory_order_relaxed);
+        do {
+            count = (a & ~mymask) + (mymask + 1);
+            *last = a & mymask;
+        } while(!my.compare_exchange_weak(a, first | count));
+        return false;
+    }
+
     bool inside(void const *pointer, size_t bytes) {
         return memory() <= pointer && pointer <= static_cast<char*>(memory()) + mysize * bytes;
     }
 
-    block_atomic* list() const {
-        return mylist;
+    block_atomic* list(memory_order order = memory_order_acquire) const {
+        return mylist.load(order);
+    }
+
+    void list(block_atomic *a) {
+        mylist.store(a);
+    }
+
+    block_atomic* retired() const {
+        return myretired;
+    }
+
+    void retired(block_atomic *a) {
+        myretired = a;
     }
 
     size_t size() const {
@@ -120,6 +198,11 @@ public:
     size_t memory_use() const {
         return myallocation_size;
     }
+
+private:
+    unsigned_ index(void const *pointer, size_t bytes) {
+        return static_cast<unsigned_>(static_cast<size_t>(static_cast<char const*>(pointer) - static_cast<char*>(memory())) / bytes);
+    }
 };
 
 }}
@@ -0,0 +1,223 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_BLOCK_INDEX_HPP
+#define WATER_FIXED_BLOCK_INDEX_HPP
+#include <water/fixed/block_atomic.hpp>
+#include <water/numeric_limits.hpp>
+namespace water { namespace fixed {
+
+// this is used by memory_atomic, dont use it alone
+//
+// finds the block_atomic a pointer is inside, without looking at every block.
+//
+// the address space is split in granules, a power of 2 bytes about the size of the first block.
+// a hash table maps each granule to the blocks that overlap it. usually a granule overlaps 1 or 2
+// blocks, so find looks at 1 or 2 entries.
+//
+// add and remove are called with the memory_atomic mutex locked. find is lock free. remove marks
+// entries as removed, they are dropped when add replaces the table. it doubles the size only if the
+// entries that are not removed need it, otherwise the new table has the same size. the old table is
+// kept so find can use it while add replaces it. memory_atomic::trim frees the old tables with
+// free_before after its grace period, without trim they are kept until destroy.
+
+class block_index
+{
+    struct entry {
+        atomic<size_t> granule; // granule + 1, 0 if empty, removed if removed
+        block_atomic *block;
+    };
+
+    struct table {
+        table *previous;
+        size_t
+            size, // power of 2
+            used, // entries that are not 0, including removed
+            live, // entries that are not 0 or removed
+            number; // the first table is 1, each new table is 1 more
+        unsigned bits; // size is 2^bits
+        entry *entries() noexcept {
+            return static_cast<entry*>(static_cast<void*>(this + 1));
+        }
+    };
+
+    static unsigned constexpr
+        digits = numeric_limits<size_t>::digits,
+        size_first = 64;
+
+    static size_t constexpr removed = static_cast<size_t>(-1); // granule + 1 is never this
+
+    atomic<table*> mytable {};
+    unsigned myshift = 0; // granule = address >> myshift
+
+public:
+    constexpr block_index() noexcept = default;
+    block_index(block_index const&) = delete;
+    block_index& operator=(block_index const&) = delete;
+
+    block_atomic* find(void const* pointer, size_t bytes, memory_order order = memory_order_acquire) noexcept {
+        // 0 if not found
+        table *t = mytable.load(order);
+        if(!t)
+            return 0;
+        size_t
+            g = granule(pointer) + 1,
+            mask = t->size - 1,
+            at = hash(g, t);
+        entry *e = t->entries();
+        while(size_t x = e[at].granule.load(order)) {
+            if(x == g && e[at].block->inside(pointer, bytes))
+                return e[at].block;
+            at = (at + 1) & mask;
+        }
+        return 0;
+    }
+
+    template<typename allocator_>
+    bool add(allocator_ *allocator, block_atomic *block, size_t bytes) {
+        // returns false if out of memory, then find will not find block
+        char *begin = static_cast<char*>(block->memory());
+        size_t span = block->size() * bytes;
+        if(!span)
+            return true;
+        table *t = mytable.load(memory_order_relaxed);
+        if(!t) {
+            // granule is the largest power of 2 that is not larger than the first block
+            myshift = 0;
+            while(myshift + 1 < digits && (static_cast<size_t>(1) << (myshift + 1)) <= span)
+                ++myshift;
+        }
+        size_t
+            first = granule(begin),
+            last = granule(begin + span - 1),
+            count = last - first + 1;
+        if(!t || (t->used + count) * 2 > t->size) {
+            t = grow(allocator, t, t ? t->live + count : count);
+            if(!t)
+                return false;
+        }
+        for(size_t g = first; g <= last; ++g)
+            insert(t, g + 1, block);
+        t->used += count;
+        t->live += count;
+        return true;
+    }
+
+    void remove(block_atomic *block, size_t bytes) noexcept {
+        // memory_atomic::trim waits until no thread can be in find before it frees the block
+        table *t = mytable.load(memory_order_relaxed);
+        size_t span = block->size() * bytes;
+        if(!t || !span)
+            return;
+        char *begin = static_cast<char*>(block->memory());
+        size_t
+            first = granule(begin),
+            last = granule(begin + span - 1),
+            mask = t->size - 1;
+        entry *e = t->entries();
+        for(size_t g = first + 1; g <= last + 1; ++g) {
+            size_t at = hash(g, t);
+            while(size_t x = e[at].granule.load(memory_order_relaxed)) {
+                if(x == g && e[at].block == block) {
+                    e[at].granule.store(removed, memory_order_relaxed);
+                    --t->live;
+                    break;
+                }
+                at = (at + 1) & mask;
+            }
+        }
+    }
+
+    size_t tables() const noexcept {
+        // call with the mutex locked before a grace period, and give the result to free_before after it
+        table *t = mytable.load(memory_order_relaxed);
+        return t ? t->number : 0;
+    }
+
+    template<typename allocator_>
+    void free_before(allocator_ *allocator, size_t tables) noexcept {
+        // free the tables add replaced before tables was returned, find cannot use them after the grace
+        // period. call with the mutex locked. the number is used, not the pointer, because another trim
+        // can have freed the table and add can have allocated a new table at the same address
+        table *t = mytable.load(memory_order_relaxed);
+        while(t && t->previous && t->previous->number >= tables)
+            t = t->previous;
+        if(!t || !t->previous)
+            return;
+        table *p = t->previous;
+        t->previous = 0;
+        free(allocator, p);
+    }
+
+    template<typename allocator_>
+    void destroy(allocator_ *allocator) noexcept {
+        table *t = mytable.load(memory_order_acquire);
+        mytable.store(0, memory_order_relaxed);
+        free(allocator, t);
+    }
+
+private:
+    template<typename allocator_>
+    static void free(allocator_ *allocator, table *t) noexcept {
+        while(t) {
+            table *p = t->previous;
+            allocator->free(t, sizeof(table) + t->size * sizeof(entry));
+            t = p;
+        }
+    }
+
+    size_t granule(void const* pointer) const noexcept {
+        return reinterpret_cast<size_t>(pointer) >> myshift;
+    }
+
+    static size_t hash(size_t g, table const* t) noexcept {
+        // fibonacci hashing, the high bits of g * 2^digits / golden ratio
+        return (g * static_cast<size_t>(0x9e3779b97f4a7c15ull)) >> (digits - t->bits);
+    }
+
+    static void insert(table *t, size_t g, block_atomic *block) noexcept {
+        size_t
+            mask = t->size - 1,
+            at = hash(g, t);
+        entry *e = t->entries();
+        while(e[at].granule.load(memory_order_relaxed))
+            at = (at + 1) & mask;
+        e[at].block = block;
+        e[at].granule.store(g, memory_order_release);
+    }
+
+    template<typename allocator_>
+    table* grow(allocator_ *allocator, table *old, size_t live) {
+        // the new table has the same size as old, or larger if live needs it
+        size_t size = old ? old->size : size_first;
+        unsigned bits = 0;
+        while(live * 2 > size)
+            size *= 2;
+        while((static_cast<size_t>(1) << bits) < size)
+            ++bits;
+        void *m = allocator->allocate(sizeof(table) + size * sizeof(entry));
+        if(!m)
+            return 0;
+        table *t = new(here(m)) table{old, size, 0, 0, old ? old->number + 1 : 1, bits};
+        entry *e = t->entries();
+        for(size_t i = 0; i != size; ++i)
+            new(here(e + i)) entry{{0}, 0};
+        if(old) {
+            entry *o = old->entries();
+            for(size_t i = 0; i != old->size; ++i) {
+                size_t g = o[i].granule.load(memory_order_relaxed);
+                if(g && g != removed) {
+                    insert(t, g, o[i].block);
+                    ++t->used;
+                    ++t->live;
+                }
+            }
+        }
+        mytable.store(t, memory_order_release);
+        return t;
+    }
+};
+
+}}
+#endif
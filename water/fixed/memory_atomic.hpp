@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -10,6 +10,14 @@
 #include <water/types.hpp>
 #include <water/fixed/allocator.hpp>
 #include <water/fixed/block_atomic.hpp>
+#include <water/fixed/block_index.hpp>
+#include <water/hardware_interference_size.hpp>
+#include <water/thread_number.hpp>
+#if defined(WATER_NO_STD) || defined(WATER_USE_WATER_THREADS)
+    #include <water/threads/yield.hpp>
+#else
+    #include <thread>
+#endif
 namespace water { namespace fixed {
 
 unsigned constexpr memory_atomic_block_size = 512;
@@ -24,7 +32,9 @@ struct memory_atomic_statistics {
         allocate_locked, // means a new block was allocated
         allocate_locked_failed, // block allocation failed
         free,
-        allocations_now;
+        allocations_now,
+        reclaimed_bytes, // memory returned to the allocator by trim
+        reclaimed_blocks;
 };
 
 template<bool>
@@ -47,6 +57,8 @@ struct memory_atomic_statistics_if {
             allocate_locked.load(memory_order_relaxed),
             allocate_locked_failed.load(memory_order_relaxed),
             free.load(memory_order_relaxed),
+            0,
+            0,
             0
         };
     }
@@ -59,20 +71,109 @@ struct memory_atomic_statistics_if<false> {
     }
 };
 
+namespace _ {
+
+    inline void memory_atomic_yield() noexcept {
+        #if defined(WATER_NO_STD) || defined(WATER_USE_WATER_THREADS)
+        threads::yield();
+        #else
+        std::this_thread::yield();
+        #endif
+    }
+
+}
+
+// memory_atomic<allocator_, statistics_, true> can trim
+//
+// each thread counts itself in a slot while it is inside a memory_atomic function. the slot has two
+// counters, myphase selects which one. grace flips myphase and waits until the old counters are 0,
+// then every thread that could have seen a block before trim removed it has left
+
+template<bool>
+struct memory_atomic_reclaim_if {
+    static unsigned constexpr slots = 16;
+
+    struct alignas(hardware_destructive_interference_size) slot {
+        atomic_uint count[2] {};
+    };
+
+    slot myslots[slots] {};
+    atomic<unsigned> myphase {};
+    size_t // locked
+        reclaimed_bytes = 0,
+        reclaimed_blocks = 0;
+
+    class guard
+    {
+        atomic_uint *my;
+
+    public:
+        explicit guard(memory_atomic_reclaim_if& a) noexcept :
+            my{a.myslots[thread_number() % slots].count + (a.myphase.load(memory_order_seq_cst) & 1)}
+        {
+            my->fetch_add(1, memory_order_seq_cst);
+        }
+
+        ~guard() {
+            my->fetch_sub(1, memory_order_release);
+        }
+
+        guard(guard const&) = delete;
+        guard& operator=(guard const&) = delete;
+    };
+
+    void grace() noexcept {
+        unsigned old = myphase.fetch_add(1, memory_order_seq_cst) & 1;
+        for(auto& s : myslots)
+            while(s.count[old].load(memory_order_seq_cst))
+                _::memory_atomic_yield();
+    }
+
+    void copy(memory_atomic_statistics& to) const noexcept {
+        to.reclaimed_bytes = reclaimed_bytes;
+        to.reclaimed_blocks = reclaimed_blocks;
+    }
+};
+
+template<>
+struct memory_atomic_reclaim_if<false> {
+    struct guard {
+        explicit constexpr guard(memory_atomic_reclaim_if const&) noexcept {}
+    };
+
+    void copy(memory_atomic_statistics&) const noexcept {}
+};
+
 
 // allocator_ must not throw
+//
+// memory_atomic never frees a block before it is destroyed, unless reclaim_ is true. then trim() frees
+// blocks where nothing is allocated. every function that looks at the blocks counts the thread in a
+// counter before, and trim waits for the counters. this costs two more atomic operations in each
+// allocate and free
 
-template<typename allocator_ = void, bool statistics_ = false>
+template<typename allocator_ = void, bool statistics_ = false, bool reclaim_ = false>
 class memory_atomic
 {
 public:
     using allocator_type = if_not_void<allocator_, water::allocator_nothrow>;
     static unsigned constexpr align = sizeof(size_t);
+    static bool constexpr reclaim = reclaim_;
 
 private:
+    using reclaim_type = memory_atomic_reclaim_if<reclaim_>;
+    using guard = typename reclaim_type::guard;
+
+    // with trim, a block can leave the list. seq_cst so a thread that counted itself after trim
+    // flipped the phase does not see the block
+    static memory_order constexpr
+        order_list = reclaim_ ? memory_order_seq_cst : memory_order_acquire,
+        order_hint = reclaim_ ? memory_order_seq_cst : memory_order_relaxed;
+
     atomic<block_atomic*>
         mylist {},
         myhint {}; // last seen block with free space
+    block_index myindex; // finds the block in free
     mutex mymutex;
     allocator_type *myallocator = 0;
     char myallocator_memory[sizeof(allocator_type)] {}; // need {} for constexpr constructor
@@ -80,6 +181,7 @@ private:
         mybytes,
         myblocksize;
     memory_atomic_statistics_if<statistics_> mystatistics;
+    mutable reclaim_type myreclaim;
 
 public:
     constexpr memory_atomic(size_t bytes, size_t block_size = 0) :
@@ -91,14 +193,16 @@ public:
     memory_atomic& operator=(memory_atomic const&) = delete;
 
     ~memory_atomic() {
-        block_atomic *list = mylist.load(memory_order_acquire);
-        if(list) {
-            lock_guard lock{mymutex};
-            do {
+        // myallocator is set when the first block is allocated. trim can have freed every block
+        lock_guard lock{mymutex};
+        if(myallocator) {
+            block_atomic *list = mylist.load(memory_order_acquire);
+            while(list) {
                 block_atomic *f = list;
                 list = list->list();
                 f->destroy(myallocator);
-            } while(list);
+            }
+            myindex.destroy(myallocator);
             myallocator->~allocator_type();
         }
     }
@@ -119,17 +223,18 @@ public:
     }
 
     void* allocate() {
+        guard g{myreclaim};
         return allocate(false);
     }
 
     void* allocate_lock_free() {
+        guard g{myreclaim};
         return allocate(true);
     }
 
     void free(void* pointer) {
-        block_atomic *list = mylist.load(memory_order_acquire);
-        while(list && !list->inside(pointer, mybytes))
-            list = list->list();
+        guard g{myreclaim};
+        block_atomic *list = block_of(pointer);
         if(list) {
             list->free(pointer, mybytes);
             myhint.store(list, memory_order_relaxed);
@@ -138,6 +243,38 @@ public:
         ___water_assert(list);
     }
 
+    size_t allocate(void **to, size_t size) {
+        // allocate at most size, return how many. used by memory_atomic_cache
+        guard g{myreclaim};
+        return allocate(to, size, false);
+    }
+
+    size_t allocate_lock_free(void **to, size_t size) {
+        guard g{myreclaim};
+        return allocate(to, size, true);
+    }
+
+    void free(void **from, size_t size) {
+        // pointers next to each other in from that are in the same block are freed with one compare exchange
+        guard g{myreclaim};
+        size_t at = 0;
+        while(at != size) {
+            block_atomic *list = block_of(from[at]);
+            ___water_assert(list);
+            if(!list) {
+                ++at;
+                continue;
+            }
+            size_t end = at + 1;
+            while(end != size && list->inside(from[end], mybytes))
+                ++end;
+            list->free(from + at, end - at, mybytes);
+            myhint.store(list, memory_order_relaxed);
+            statistics_free(mystatistics, end - at);
+            at = end;
+        }
+    }
+
     bool allocate_block(size_t block_size = 0) {
         // could throw
         lock_guard lock{mymutex};
@@ -163,42 +300,137 @@ public:
     }
 
     size_t memory_use() {
-        block_atomic *list = mylist.load(memory_order_acquire);
+        guard g{myreclaim};
+        block_atomic *list = mylist.load(order_list);
         size_t r = 0;
         while(list) {
             r += list->memory_use();
-            list = list->list();
+            list = list->list(order_list);
         }
         return r;
     }
 
     memory_atomic_statistics statistics() {
-        block_atomic *list = mylist.load(memory_order_acquire);
         memory_atomic_statistics r = mystatistics.copy();
+        if(reclaim_) {
+            lock_guard lock{mymutex};
+            myreclaim.copy(r);
+        }
+        guard g{myreclaim};
+        block_atomic *list = mylist.load(order_list);
         while(list) {
             ++r.blocks;
             r.memory_use += list->memory_use();
-            list = list->list();
+            list = list->list(order_list);
         }
         // allocations now is sum of all allocations - free
         r.allocations_now = (r.allocate_quick + r.allocate_lock_free + r.allocate_locked) - r.free;
         return r;
     }
 
+    template<bool reclaim2_ = reclaim_>
+    size_t trim() {
+        // free the blocks where nothing is allocated, return the bytes freed. other threads can use this
+        // at the same time, trim waits until no thread can be using the blocks it removed.
+        // memory_atomic_cache holds allocations, flush it first. lookup numbers change
+        static_assert(reclaim2_, "trim needs memory_atomic<allocator_, statistics_, true>");
+        block_atomic *retired = 0;
+        size_t tables;
+        {
+            lock_guard lock{mymutex};
+            tables = myindex.tables();
+            block_atomic
+                *previous = 0,
+                *list = mylist.load(memory_order_relaxed);
+            while(list) {
+                block_atomic *next = list->list(memory_order_relaxed);
+                if(list->take_if_unused(mybytes)) {
+                    // threads looking at list go on to next
+                    if(previous)
+                        previous->list(next);
+                    else
+                        mylist.store(next);
+                    myindex.remove(list, mybytes);
+                    list->retired(retired);
+                    retired = list;
+                }
+                else
+                    previous = list;
+                list = next;
+            }
+        }
+        if(!retired)
+            return 0;
+        // a thread that found a retired block before it was removed can still store it in the hint.
+        // after the first grace no thread can, after the second no thread can have read it
+        unhint(retired);
+        myreclaim.grace();
+        unhint(retired);
+        myreclaim.grace();
+        lock_guard lock{mymutex};
+        myindex.free_before(myallocator, tables);
+        size_t r = 0;
+        while(retired) {
+            block_atomic *f = retired;
+            retired = retired->retired();
+            r += f->memory_use();
+            ++myreclaim.reclaimed_blocks;
+            f->destroy(myallocator);
+        }
+        myreclaim.reclaimed_bytes += r;
+        return r;
+    }
+
 private:
     static constexpr size_t align_bytes(size_t a) {
         return a + (a % align ? align - (a % align) : 0);
     }
 
+    block_atomic* block_of(void const* pointer) {
+        block_atomic *list = myindex.find(pointer, mybytes, order_list);
+        if(!list) {
+            // only if block_index could not allocate memory
+            list = mylist.load(order_list);
+            while(list && !list->inside(pointer, mybytes))
+                list = list->list(order_list);
+        }
+        return list;
+    }
+
+    void unhint(block_atomic *retired) {
+        for(; retired; retired = retired->retired()) {
+            block_atomic *h = retired;
+            myhint.compare_exchange_strong(h, 0);
+        }
+    }
+
+    size_t allocate(void **to, size_t size, bool lock_free) {
+        size_t r = 0;
+        while(r != size) {
+            bool more;
+            auto block = myhint.load(order_hint);
+            size_t got = block ? block->allocate(mybytes, to + r, size - r, more) : 0;
+            if(got) {
+                statistics_allocate_quick(mystatistics, got);
+                r += got;
+            }
+            else if(void *a = allocate(lock_free)) // finds or makes a block with space, and updates the hint
+                to[r++] = a;
+            else
+                break;
+        }
+        return r;
+    }
+
     void* allocate(bool lock_free) {
         bool more;
-        auto block = myhint.load(memory_order_relaxed);
+        auto block = myhint.load(order_hint);
         if(block)
             if(void *r = block->allocate(mybytes, more)) {
                 statistics_allocate_quick(mystatistics);
                 return r;
             }
-        auto list = mylist.load(memory_order_acquire);
+        auto list = mylist.load(order_list);
         block = list;
         bool did_lock = false;
         while(true) {
@@ -210,7 +442,7 @@ private:
                     statistics_allocate(mystatistics, did_lock);
                     return r;
                 }
-                block = block->list();
+                block = block->list(order_list);
             }
             if(lock_free)
                 break;
@@ -245,18 +477,22 @@ private:
         block_atomic *b = block_atomic::create(myallocator, mybytes, block_size, list);
         if(!b)
             return 0;
+        myindex.add(myallocator, b, mybytes); // if this fails, free will look at every block
         mylist.store(b, memory_order_release);
         return b;
     }
 
     size_t lookup(void const* find, memory_order order) const {
+        guard g{myreclaim};
+        if(reclaim_)
+            order = memory_order_seq_cst;
         block_atomic *list = mylist.load(order);
         while(list && !list->inside(find, mybytes))
-            list = list->list();
+            list = list->list(order_list);
         if(!list)
             return 0;
         size_t r = 1 + static_cast<size_t>(static_cast<char const*>(find) - static_cast<char const*>(list->memory())) / mybytes;
-        while((list = list->list()) != 0)
+        while((list = list->list(order_list)) != 0)
             r += list->size();
         return r;
     }
@@ -265,23 +501,26 @@ private:
         if(!find)
             return 0;
         --find;
+        guard g{myreclaim};
+        if(reclaim_)
+            order = memory_order_seq_cst;
         block_atomic
             *list = mylist.load(order),
             *l = list;
         size_t size = 0;
         while(l) {
             size += l->size();
-            l = l->list();
+            l = l->list(order_list);
         }
         if(find >= size)
             return 0;
         while(find < (size -= list->size()))
-            list = list->list();
+            list = list->list(order_list);
         return static_cast<char*>(list->memory()) + (find - size) * mybytes;
     }
 
-    static void statistics_allocate_quick(memory_atomic_statistics_if<true>& s) {
-        s.allocate_quick.fetch_add(1, memory_order_relaxed);
+    static void statistics_allocate_quick(memory_atomic_statistics_if<true>& s, size_t count = 1) {
+        s.allocate_quick.fetch_add(count, memory_order_relaxed);
     }
 
     static void statistics_allocate(memory_atomic_statistics_if<true>& s, bool did_lock) {
@@ -292,33 +531,33 @@ private:
         lock_free ? s.allocate_lock_free_failed.fetch_add(1, memory_order_relaxed) : s.allocate_locked_failed.fetch_add(1, memory_order_relaxed);
     }
 
-    static void statistics_free(memory_atomic_statistics_if<true>& s) {
-        s.free.fetch_add(1, memory_order_relaxed);
+    static void statistics_free(memory_atomic_statistics_if<true>& s, size_t count = 1) {
+        s.free.fetch_add(count, memory_order_relaxed);
     }
 
-    static void statistics_allocate_quick(memory_atomic_statistics_if<false> const&) {}
+    static void statistics_allocate_quick(memory_atomic_statistics_if<false> const&, size_t = 1) {}
     static void statistics_allocate(memory_atomic_statistics_if<false> const&, bool) {}
     static void statistics_allocate_failed(memory_atomic_statistics_if<false> const&, bool) {}
-    static void statistics_free(memory_atomic_statistics_if<false> const&) {}
+    static void statistics_free(memory_atomic_statistics_if<false> const&, size_t = 1) {}
 };
 
-template<typename allocator_, bool statistics_>
-allocator_throw<memory_atomic<allocator_, statistics_>> allocator_for(memory_atomic<allocator_, statistics_>& a) noexcept {
+template<typename allocator_, bool statistics_, bool reclaim_>
+allocator_throw<memory_atomic<allocator_, statistics_, reclaim_>> allocator_for(memory_atomic<allocator_, statistics_, reclaim_>& a) noexcept {
     return a;
 }
 
-template<typename allocator_, bool statistics_>
-allocator_nothrow<memory_atomic<allocator_, statistics_>> allocator_nothrow_for(memory_atomic<allocator_, statistics_>& a) noexcept {
+template<typename allocator_, bool statistics_, bool reclaim_>
+allocator_nothrow<memory_atomic<allocator_, statistics_, reclaim_>> allocator_nothrow_for(memory_atomic<allocator_, statistics_, reclaim_>& a) noexcept {
     return a;
 }
 
-template<typename allocator_, bool statistics_>
-allocator_throw_lock_free<memory_atomic<allocator_, statistics_>> allocator_lock_free_for(memory_atomic<allocator_, statistics_>& a) noexcept {
+template<typename allocator_, bool statistics_, bool reclaim_>
+allocator_throw_lock_free<memory_atomic<allocator_, statistics_, reclaim_>> allocator_lock_free_for(memory_atomic<allocator_, statistics_, reclaim_>& a) noexcept {
     return a;
 }
 
-template<typename allocator_, bool statistics_>
-allocator_nothrow_lock_free<memory_atomic<allocator_, statistics_>> allocator_nothrow_lock_free_for(memory_atomic<allocator_, statistics_>& a) noexcept {
+template<typename allocator_, bool statistics_, bool reclaim_>
+allocator_nothrow_lock_free<memory_atomic<allocator_, statistics_, reclaim_>> allocator_nothrow_lock_free_for(memory_atomic<allocator_, statistics_, reclaim_>& a) noexcept {
     return a;
 }
 
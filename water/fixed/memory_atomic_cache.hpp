@@ -0,0 +1,125 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_MEMORY_ATOMIC_CACHE_HPP
+#define WATER_FIXED_MEMORY_ATOMIC_CACHE_HPP
+#include <water/fixed/memory_atomic.hpp>
+namespace water { namespace fixed {
+
+/*
+
+A cache of free memory_atomic allocations for one thread.
+
+allocate and free use an array of pointers in this object, without atomics. When the array is empty,
+allocate gets size_ / 2 allocations from the memory_atomic. When the array is full, free gives half
+of it back. Both are one compare exchange for each block.
+
+The memory stays in the memory_atomic, so it is still safe to read freed memory.
+
+Use one cache per thread, for example thread_local. It must be destroyed before the memory_atomic.
+
+    water::fixed::memory_atomic<> memory{64};
+
+    void thread() {
+        water::fixed::memory_atomic_cache<water::fixed::memory_atomic<>> cache{memory};
+        void *pointer = cache.allocate();
+        cache.free(pointer);
+        auto allocator = allocator_for(cache); // like allocator_for(memory)
+    }
+
+Memory allocated from the cache can be freed to the memory_atomic, or to a cache for another thread.
+
+*/
+
+template<typename memory_, unsigned size_ = 64>
+class memory_atomic_cache
+{
+    static_assert(size_ >= 2, "");
+
+public:
+    using memory_type = memory_;
+    static unsigned constexpr size = size_;
+
+private:
+    memory_ *mymemory;
+    unsigned mycount = 0;
+    void *my[size_];
+
+public:
+    explicit memory_atomic_cache(memory_& a) noexcept :
+        mymemory{&a}
+    {}
+
+    memory_atomic_cache(memory_atomic_cache const&) = delete;
+    memory_atomic_cache& operator=(memory_atomic_cache const&) = delete;
+
+    ~memory_atomic_cache() {
+        flush();
+    }
+
+    memory_& memory() const noexcept {
+        return *mymemory;
+    }
+
+    size_t bytes() const {
+        return mymemory->bytes();
+    }
+
+    void* allocate() {
+        if(!mycount)
+            mycount = static_cast<unsigned>(mymemory->allocate(my, size_ / 2));
+        return mycount ? my[--mycount] : 0;
+    }
+
+    void* allocate_lock_free() {
+        if(!mycount)
+            mycount = static_cast<unsigned>(mymemory->allocate_lock_free(my, size_ / 2));
+        return mycount ? my[--mycount] : 0;
+    }
+
+    void free(void *pointer) {
+        if(mycount == size_) {
+            // give back the older half, keep the recently freed ones
+            mymemory->free(my, size_ / 2);
+            for(unsigned i = size_ / 2; i != size_; ++i)
+                my[i - size_ / 2] = my[i];
+            mycount = size_ - size_ / 2;
+        }
+        my[mycount++] = pointer;
+    }
+
+    void flush() {
+        // give back everything
+        if(mycount)
+            mymemory->free(my, mycount);
+        mycount = 0;
+    }
+
+    unsigned cached() const noexcept {
+        return mycount;
+    }
+};
+
+template<typename memory_, unsigned size_>
+allocator_throw<memory_atomic_cache<memory_, size_>> allocator_for(memory_atomic_cache<memory_, size_>& a) noexcept {
+    return a;
+}
+
+template<typename memory_, unsigned size_>
+allocator_nothrow<memory_atomic_cache<memory_, size_>> allocator_nothrow_for(memory_atomic_cache<memory_, size_>& a) noexcept {
+    return a;
+}
+
+template<typename memory_, unsigned size_>
+allocator_throw_lock_free<memory_atomic_cache<memory_, size_>> allocator_lock_free_for(memory_atomic_cache<memory_, size_>& a) noexcept {
+    return a;
+}
+
+template<typename memory_, unsigned size_>
+allocator_nothrow_lock_free<memory_atomic_cache<memory_, size_>> allocator_nothrow_lock_free_for(memory_atomic_cache<memory_, size_>& a) noexcept {
+    return a;
+}
+
+}}
+#endif
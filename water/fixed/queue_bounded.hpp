@@ -0,0 +1,171 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_QUEUE_BOUNDED_HPP
+#define WATER_FIXED_QUEUE_BOUNDED_HPP
+#include <water/allocator_nothrow.hpp>
+#include <water/atomic.hpp>
+#include <water/hardware_interference_size.hpp>
+#include <water/new_here.hpp>
+#include <water/types.hpp>
+namespace water { namespace fixed {
+
+/*
+
+Lock free bounded queue, any number of threads can push and pop at the same time.
+
+The capacity is rounded up to a power of 2. All memory is allocated by the constructor. push returns
+false when the queue is full, pop returns false when the queue is empty.
+
+Each slot has a sequence number that says if it is free for the push at that position, or has a
+value for the pop at that position. A push or pop is one compare exchange on the push or pop
+position and one store to the sequence number. The slots and positions are on their own cache lines.
+This is the bounded queue by Dmitry Vyukov.
+
+pop can return false while another thread is in the middle of push, even if a push that started later
+has finished.
+
+The value_ move constructor should not throw. If it throws, the queue is broken.
+
+    water::fixed::queue_bounded<int> queue{1024};
+    if(!queue)
+        return; // out of memory
+    queue.push(123);
+    int i;
+    if(queue.pop(i))
+        ...
+
+*/
+
+template<typename value_, typename allocator_ = void>
+class queue_bounded
+{
+public:
+    using value_type = value_;
+    using allocator_type = if_not_void<allocator_, water::allocator_nothrow>;
+
+private:
+    struct alignas(hardware_destructive_interference_size) slot {
+        atomic<size_t> sequence;
+        alignas(value_) char value[sizeof(value_)];
+
+        explicit slot(size_t s) noexcept :
+            sequence{s}
+        {}
+
+        value_* pointer() noexcept {
+            return static_cast<value_*>(static_cast<void*>(value));
+        }
+    };
+
+    slot *myslots = 0;
+    size_t mymask = 0;
+    allocator_type myallocator;
+    alignas(hardware_destructive_interference_size) atomic<size_t> mypush{0};
+    alignas(hardware_destructive_interference_size) atomic<size_t> mypop{0};
+
+public:
+    explicit queue_bounded(size_t capacity) {
+        size_t size = 2;
+        while(size < capacity && size * 2 > size)
+            size *= 2;
+        myslots = myallocator.template allocate<slot>(size);
+        if(!myslots)
+            return;
+        mymask = size - 1;
+        for(size_t i = 0; i != size; ++i)
+            new(here(myslots + i)) slot{i};
+    }
+
+    queue_bounded(queue_bounded const&) = delete;
+    queue_bounded& operator=(queue_bounded const&) = delete;
+
+    ~queue_bounded() {
+        if(!myslots)
+            return;
+        size_t
+            pop = mypop.load(memory_order_acquire),
+            push = mypush.load(memory_order_acquire);
+        while(pop != push)
+            myslots[pop++ & mymask].pointer()->~value_();
+        for(size_t i = 0; i <= mymask; ++i)
+            myslots[i].~slot();
+        myallocator.template free<slot>(myslots, mymask + 1);
+    }
+
+    explicit operator bool() const noexcept {
+        // false if the constructor failed to allocate memory
+        return myslots != 0;
+    }
+
+    size_t capacity() const noexcept {
+        return myslots ? mymask + 1 : 0;
+    }
+
+    bool push(value_ const& a) {
+        return emplace(a);
+    }
+
+    bool push(value_&& a) {
+        return emplace(static_cast<value_&&>(a));
+    }
+
+    template<typename ...arguments_>
+    bool emplace(arguments_&& ...arguments) {
+        if(!myslots)
+            return false;
+        size_t at = mypush.load(memory_order_relaxed);
+        slot *s;
+        while(true) {
+            s = myslots + (at & mymask);
+            size_t sequence = s->sequence.load(memory_order_acquire);
+            if(sequence == at) {
+                if(mypush.compare_exchange_weak(at, at + 1, memory_order_relaxed))
+                    break;
+            }
+            else if(static_cast<ptrdiff_t>(sequence - at) < 0)
+                return false; // full
+            else
+                at = mypush.load(memory_order_relaxed);
+        }
+        new(here(s->value)) value_(static_cast<arguments_&&>(arguments)...);
+        s->sequence.store(at + 1, memory_order_release);
+        return true;
+    }
+
+    bool pop(value_& to) {
+        if(!myslots)
+            return false;
+        size_t at = mypop.load(memory_order_relaxed);
+        slot *s;
+        while(true) {
+            s = myslots + (at & mymask);
+            size_t sequence = s->sequence.load(memory_order_acquire);
+            if(sequence == at + 1) {
+                if(mypop.compare_exchange_weak(at, at + 1, memory_order_relaxed))
+                    break;
+            }
+            else if(static_cast<ptrdiff_t>(sequence - (at + 1)) < 0)
+                return false; // empty
+            else
+                at = mypop.load(memory_order_relaxed);
+        }
+        value_ *v = s->pointer();
+        to = static_cast<value_&&>(*v);
+        v->~value_();
+        s->sequence.store(at + mymask + 1, memory_order_release);
+        return true;
+    }
+
+    size_t size() const noexcept {
+        // only a guess when other threads push or pop
+        size_t
+            pop = mypop.load(memory_order_relaxed),
+            push = mypush.load(memory_order_relaxed);
+        return push > pop ? push - pop : 0;
+    }
+};
+
+}}
+#endif
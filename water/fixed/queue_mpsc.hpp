@@ -0,0 +1,136 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_QUEUE_MPSC_HPP
+#define WATER_FIXED_QUEUE_MPSC_HPP
+#include <water/fixed/memory_atomic.hpp>
+namespace water { namespace fixed {
+
+/*
+
+Unbounded queue where many threads can push and one thread can pop.
+
+Each value is in a linked list node allocated from a memory_atomic. push is one exchange and one
+store, pop does not use any atomic read-modify-write. This is the node based MPSC queue by Dmitry
+Vyukov. The first node in the list is always a node that was already popped.
+
+push allocates a node from memory_atomic. That is lock free unless memory_atomic needs a new block.
+Use memory().allocate_block() to allocate blocks before, and push_lock_free() to never lock.
+push returns false if it could not allocate memory.
+
+pop can return false while another thread is in the middle of push, even if a push that started later
+has finished.
+
+The value_ move constructor should not throw. If it throws, the queue is broken.
+
+    water::fixed::queue_mpsc<int> queue;
+    queue.push(123); // any thread
+    int i;
+    if(queue.pop(i)) // only one thread
+        ...
+
+*/
+
+template<typename value_, typename allocator_ = void>
+class queue_mpsc
+{
+public:
+    using value_type = value_;
+    using memory_type = memory_atomic<allocator_>;
+
+private:
+    struct node {
+        atomic<node*> next{};
+        alignas(value_) char value[sizeof(value_)];
+
+        value_* pointer() noexcept {
+            return static_cast<value_*>(static_cast<void*>(value));
+        }
+    };
+
+    memory_type mymemory{sizeof(node)};
+    node mystub;
+    alignas(hardware_destructive_interference_size) atomic<node*> mylast{&mystub}; // push
+    alignas(hardware_destructive_interference_size) node *myfirst = &mystub; // pop
+
+public:
+    queue_mpsc() = default;
+
+    explicit queue_mpsc(size_t block_size) :
+        mymemory{sizeof(node), block_size}
+    {}
+
+    queue_mpsc(queue_mpsc const&) = delete;
+    queue_mpsc& operator=(queue_mpsc const&) = delete;
+
+    ~queue_mpsc() {
+        node *n = myfirst->next.load(memory_order_acquire);
+        while(n) {
+            n->pointer()->~value_();
+            n = n->next.load(memory_order_acquire);
+        }
+        // mymemory frees all nodes
+    }
+
+    memory_type& memory() noexcept {
+        return mymemory;
+    }
+
+    bool push(value_ const& a) {
+        return push_node(mymemory.allocate(), a);
+    }
+
+    bool push(value_&& a) {
+        return push_node(mymemory.allocate(), static_cast<value_&&>(a));
+    }
+
+    bool push_lock_free(value_ const& a) {
+        return push_node(mymemory.allocate_lock_free(), a);
+    }
+
+    bool push_lock_free(value_&& a) {
+        return push_node(mymemory.allocate_lock_free(), static_cast<value_&&>(a));
+    }
+
+    template<typename ...arguments_>
+    bool emplace(arguments_&& ...arguments) {
+        return push_node(mymemory.allocate(), static_cast<arguments_&&>(arguments)...);
+    }
+
+    bool pop(value_& to) {
+        // only one thread at a time
+        node
+            *first = myfirst,
+            *next = first->next.load(memory_order_acquire);
+        if(!next)
+            return false;
+        value_ *v = next->pointer();
+        to = static_cast<value_&&>(*v);
+        v->~value_();
+        myfirst = next; // next is the new stub
+        if(first != &mystub)
+            mymemory.free(first);
+        return true;
+    }
+
+    bool empty() const noexcept {
+        // only from the pop thread. false if a push is in progress, then pop can still return false
+        return mylast.load(memory_order_seq_cst) == myfirst;
+    }
+
+private:
+    template<typename ...arguments_>
+    bool push_node(void *memory, arguments_&& ...arguments) {
+        if(!memory)
+            return false;
+        node *n = new(here(memory)) node;
+        new(here(n->value)) value_(static_cast<arguments_&&>(arguments)...);
+        node *previous = mylast.exchange(n, memory_order_seq_cst); // seq_cst for queue_mpsc_wait
+        previous->next.store(n, memory_order_release);
+        return true;
+    }
+};
+
+}}
+#endif
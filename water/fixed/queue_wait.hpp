@@ -0,0 +1,238 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_QUEUE_WAIT_HPP
+#define WATER_FIXED_QUEUE_WAIT_HPP
+#include <water/fixed/queue_bounded.hpp>
+#include <water/fixed/queue_mpsc.hpp>
+#include <water/threads/semaphore.hpp>
+#include <water/threads/deadline.hpp>
+#include <water/threads/functions.hpp>
+#include <water/threads/spin.hpp>
+namespace water { namespace fixed {
+
+/*
+
+queue_bounded and queue_mpsc with pop that waits until the queue has a value, and for
+queue_bounded_wait a push that waits until the queue has space.
+
+Threads that wait sleep in a threads::semaphore<>. On Linux that is semaphore_futex, so push only
+makes a system call when a thread is sleeping.
+
+queue_bounded_wait has one semaphore that counts the values and one that counts the free space. The
+semaphore maximum can be as low as 32767, so the capacity is at most capacity_max.
+
+queue_mpsc_wait is unbounded, it cannot count the values in a semaphore. When the pop thread has
+nothing to pop, it sets a sleeping flag, looks at the queue again, and sleeps in the semaphore if it
+is still empty. push wakes it only if the flag was set.
+
+When the queue is not empty, the queue pop can still return false for a moment while another thread
+is in the middle of push. Then pop spins until it gets the value, and yields if that takes long.
+
+*/
+
+namespace _ {
+
+    template<typename queue_>
+    void queue_wait_pop(queue_& queue, typename queue_::value_type& to) {
+        // the queue is not empty
+        threads::spin spin{threads::spin_times()};
+        while(!queue.pop(to)) {
+            threads::cpu_pause();
+            spin();
+        }
+    }
+
+}
+
+
+template<typename value_, typename allocator_ = void, typename semaphore_ = threads::semaphore<>>
+class queue_bounded_wait
+{
+public:
+    using value_type = value_;
+    using queue_type = queue_bounded<value_, allocator_>;
+    using semaphore_type = semaphore_;
+
+private:
+    queue_type myqueue;
+    semaphore_type
+        myvalues{0},
+        myspace;
+
+public:
+    static size_t constexpr capacity_max = 1 << 14;
+
+    explicit queue_bounded_wait(size_t capacity) :
+        myqueue{capacity < capacity_max ? capacity : capacity_max},
+        myspace{static_cast<unsigned>(myqueue.capacity())}
+    {}
+
+    explicit operator bool() const noexcept {
+        return myqueue && myvalues && myspace;
+    }
+
+    size_t capacity() const noexcept {
+        return myqueue.capacity();
+    }
+
+    void push(value_ const& a) {
+        threads::down(myspace);
+        push_space(a);
+    }
+
+    void push(value_&& a) {
+        threads::down(myspace);
+        push_space(static_cast<value_&&>(a));
+    }
+
+    bool try_push(value_ const& a) {
+        if(!threads::try_down(myspace))
+            return false;
+        push_space(a);
+        return true;
+    }
+
+    bool try_push(value_&& a) {
+        if(!threads::try_down(myspace))
+            return false;
+        push_space(static_cast<value_&&>(a));
+        return true;
+    }
+
+    void pop(value_& to) {
+        threads::down(myvalues);
+        pop_value(to);
+    }
+
+    bool pop(value_& to, double seconds) {
+        return pop(to, threads::deadline{seconds});
+    }
+
+    bool pop(value_& to, threads::deadline d) {
+        if(!threads::down(myvalues, d))
+            return false;
+        pop_value(to);
+        return true;
+    }
+
+    bool try_pop(value_& to) {
+        if(!threads::try_down(myvalues))
+            return false;
+        pop_value(to);
+        return true;
+    }
+
+private:
+    template<typename a_>
+    void push_space(a_&& a) {
+        // the semaphore said there is space, but a pop could be in the middle of freeing it
+        threads::spin spin{threads::spin_times()};
+        while(!myqueue.push(static_cast<a_&&>(a))) {
+            threads::cpu_pause();
+            spin();
+        }
+        threads::up(myvalues);
+    }
+
+    void pop_value(value_& to) {
+        _::queue_wait_pop(myqueue, to);
+        threads::up(myspace);
+    }
+};
+
+
+template<typename value_, typename allocator_ = void, typename semaphore_ = threads::semaphore<>>
+class queue_mpsc_wait
+{
+public:
+    using value_type = value_;
+    using queue_type = queue_mpsc<value_, allocator_>;
+    using semaphore_type = semaphore_;
+
+private:
+    queue_type myqueue;
+    semaphore_type mywake{0};
+    alignas(hardware_destructive_interference_size) atomic<unsigned> mysleeping{0};
+
+public:
+    queue_mpsc_wait() = default;
+
+    explicit queue_mpsc_wait(size_t block_size) :
+        myqueue{block_size}
+    {}
+
+    explicit operator bool() const noexcept {
+        return static_cast<bool>(mywake);
+    }
+
+    typename queue_type::memory_type& memory() noexcept {
+        return myqueue.memory();
+    }
+
+    bool push(value_ const& a) {
+        // false if out of memory
+        return after_push(myqueue.push(a));
+    }
+
+    bool push(value_&& a) {
+        return after_push(myqueue.push(static_cast<value_&&>(a)));
+    }
+
+    bool push_lock_free(value_ const& a) {
+        return after_push(myqueue.push_lock_free(a));
+    }
+
+    bool push_lock_free(value_&& a) {
+        return after_push(myqueue.push_lock_free(static_cast<value_&&>(a)));
+    }
+
+    void pop(value_& to) {
+        // only one thread at a time
+        while(!try_pop(to))
+            if(sleep_if_empty())
+                threads::down(mywake);
+    }
+
+    bool pop(value_& to, double seconds) {
+        return pop(to, threads::deadline{seconds});
+    }
+
+    bool pop(value_& to, threads::deadline d) {
+        while(!try_pop(to))
+            if(sleep_if_empty() && !threads::down(mywake, d)) {
+                // if the flag is gone, push will up the semaphore. the next pop wakes up once for nothing
+                mysleeping.exchange(0);
+                return try_pop(to);
+            }
+        return true;
+    }
+
+    bool try_pop(value_& to) {
+        if(myqueue.empty())
+            return false;
+        _::queue_wait_pop(myqueue, to);
+        return true;
+    }
+
+private:
+    bool sleep_if_empty() {
+        // seq_cst, so push sees the flag or this sees the pushed value
+        mysleeping.exchange(1);
+        if(!myqueue.empty()) {
+            mysleeping.exchange(0);
+            return false;
+        }
+        return true;
+    }
+
+    bool after_push(bool pushed) {
+        if(pushed && mysleeping.load() && mysleeping.exchange(0))
+            threads::up(mywake);
+        return pushed;
+    }
+};
+
+}}
+#endif
@@ -1,18 +1,26 @@
-// Copyright 2018 Johan Paulsson
+// Copyright 2018-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_FIXED_TESTS_ALL_HPP
 #define WATER_FIXED_TESTS_ALL_HPP
 #include <water/fixed/tests/alignment.hpp>
+#include <water/fixed/tests/free_many_blocks.hpp>
 #include <water/fixed/tests/lookup.hpp>
+#include <water/fixed/tests/memory_atomic_cache.hpp>
 #include <water/fixed/tests/memory_functions.hpp>
+#include <water/fixed/tests/queues.hpp>
+#include <water/fixed/tests/trim.hpp>
 namespace water { namespace fixed { namespace tests {
 
 inline void all() {
     alignment();
+    free_many_blocks();
     lookup();
+    memory_atomic_cache_all();
     memory_functions();
+    queues();
+    trim();
 }
 
 }}}
@@ -0,0 +1,44 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_TESTS_FREE_MANY_BLOCKS_HPP
+#define WATER_FIXED_TESTS_FREE_MANY_BLOCKS_HPP
+#include <water/fixed/tests/bits.hpp>
+#include <water/vector.hpp>
+namespace water { namespace fixed { namespace tests {
+
+/*
+
+test that free finds the right block when there are many blocks of different sizes, so the
+block_index granules overlap many blocks and the index table has to grow
+
+*/
+
+inline void free_many_blocks() {
+    memory_atomic<void, true> memory{24};
+    size_t block_sizes[] {100, 1, 3, 1000, 7, 50, 2, 5000, 13};
+    for(unsigned repeat = 0; repeat != 50; ++repeat)
+        for(auto s : block_sizes)
+            ___water_test(memory.allocate_block(s));
+    vector<void*> list;
+    while(void *a = memory.allocate_lock_free())
+        list.push_back(a);
+    ___water_test(list.size() >= 50 * (100 + 1 + 3 + 1000 + 7 + 50 + 2 + 5000 + 13));
+    // free every 3rd, then the rest
+    for(size_t i = 0; i < list.size(); i += 3)
+        memory.free(list[i]);
+    for(size_t i = 0; i != list.size(); ++i)
+        if(i % 3)
+            memory.free(list[i]);
+    auto statistics = memory.statistics();
+    ___water_test(statistics.allocations_now == 0);
+    ___water_test(statistics.blocks == 50 * sizeof(block_sizes) / sizeof(block_sizes[0]));
+    size_t again = 0;
+    while(memory.allocate_lock_free())
+        ++again;
+    ___water_test(again == list.size());
+}
+
+}}}
+#endif
@@ -0,0 +1,91 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_TESTS_MEMORY_ATOMIC_CACHE_HPP
+#define WATER_FIXED_TESTS_MEMORY_ATOMIC_CACHE_HPP
+#include <water/fixed/tests/bits.hpp>
+#include <water/fixed/memory_atomic_cache.hpp>
+#include <water/threads/tests/run_many.hpp>
+#include <water/vector.hpp>
+namespace water { namespace fixed { namespace tests {
+
+/*
+
+test memory_atomic_cache, and allocate and free of many pointers in memory_atomic
+
+*/
+
+// each thread allocates with its own cache, writes its number in the memory, checks it, and frees
+// half of it to its own cache and half to the memory_atomic
+
+class memory_atomic_cache_threads
+{
+    memory_atomic<void, true> *mymemory;
+    atomic<unsigned> mythread{0};
+
+public:
+    explicit memory_atomic_cache_threads(memory_atomic<void, true>& memory) :
+        mymemory{&memory}
+    {
+        threads::tests::run_many_reference(*this, 4);
+    }
+
+    void operator()() {
+        unsigned t = mythread.fetch_add(1) + 1;
+        memory_atomic_cache<memory_atomic<void, true>, 16> cache{*mymemory};
+        auto allocator = allocator_nothrow_for(cache);
+        void *list[100];
+        for(unsigned repeat = 0; repeat != 200; ++repeat) {
+            for(auto& l : list) {
+                l = allocator.allocate(mymemory->bytes());
+                ___water_test(l);
+                *static_cast<unsigned*>(l) = t;
+            }
+            for(unsigned i = 0; i != 100; ++i) {
+                ___water_test(*static_cast<unsigned*>(list[i]) == t);
+                if(i % 2)
+                    cache.free(list[i]);
+                else
+                    mymemory->free(list[i]);
+            }
+        }
+    }
+};
+
+inline void memory_atomic_cache_all() {
+    {
+        memory_atomic<void, true> memory{16, 10};
+        vector<void*> list;
+        {
+            memory_atomic_cache<memory_atomic<void, true>, 8> cache{memory};
+            for(unsigned i = 0; i != 1000; ++i) {
+                void *a = cache.allocate();
+                ___water_test(a);
+                list.push_back(a);
+            }
+            ___water_test(cache.cached() < 8);
+            for(size_t i = 0; i != list.size(); ++i)
+                for(size_t j = i + 1; j != list.size(); ++j)
+                    ___water_test(list[i] != list[j]);
+            for(auto a : list)
+                cache.free(a);
+            ___water_test(cache.cached() <= 8);
+        }
+        auto statistics = memory.statistics();
+        ___water_test(statistics.allocations_now == 0);
+        // everything can be allocated again
+        size_t again = 0;
+        while(memory.allocate_lock_free())
+            ++again;
+        ___water_test(again >= 1000);
+    }
+    {
+        memory_atomic<void, true> memory{sizeof(unsigned) * 2};
+        memory_atomic_cache_threads{memory};
+        ___water_test(memory.statistics().allocations_now == 0);
+    }
+}
+
+}}}
+#endif
@@ -0,0 +1,134 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_TESTS_QUEUES_HPP
+#define WATER_FIXED_TESTS_QUEUES_HPP
+#include <water/fixed/tests/bits.hpp>
+#include <water/fixed/queue_wait.hpp>
+#include <water/threads/tests/run_many.hpp>
+namespace water { namespace fixed { namespace tests {
+
+/*
+
+test queue_bounded, queue_mpsc and the wait variants
+
+*/
+
+struct queues_value {
+    static atomic<int>& count() {
+        static atomic<int> c{0};
+        return c;
+    }
+    unsigned my = 0;
+    queues_value(unsigned a = 0) : my{a} { ++count(); }
+    queues_value(queues_value const& a) : my{a.my} { ++count(); }
+    queues_value& operator=(queues_value const&) = default;
+    ~queues_value() { --count(); }
+};
+
+template<typename queue_>
+void queues_order(queue_& queue, unsigned size) {
+    queues_value v;
+    ___water_test(!queue.pop(v));
+    for(unsigned i = 1; i <= size; ++i)
+        ___water_test(queue.push(queues_value{i}));
+    for(unsigned i = 1; i <= size; ++i) {
+        ___water_test(queue.pop(v));
+        ___water_test(v.my == i);
+    }
+    ___water_test(!queue.pop(v));
+}
+
+// producers push 1 to values, with the producer number in the high bits. one or more consumers pop.
+// every value must arrive once, and for each consumer the values from one producer must be in order
+
+template<typename queue_>
+class queues_threads
+{
+    queue_ *myqueue;
+    unsigned
+        myproducers,
+        myconsumers,
+        myvalues;
+    atomic<unsigned> mythread{0};
+    atomic<size_t>
+        mysum{0},
+        mypopped{0};
+
+public:
+    queues_threads(queue_& queue, unsigned producers, unsigned consumers, unsigned values) :
+        myqueue{&queue},
+        myproducers{producers},
+        myconsumers{consumers},
+        myvalues{values}
+    {
+        threads::tests::run_many_reference(*this, producers + consumers);
+        size_t sum = static_cast<size_t>(values) * (values + 1) / 2 * producers;
+        ___water_test(mysum.load() == sum);
+        ___water_test(mypopped.load() == static_cast<size_t>(values) * producers);
+    }
+
+    void operator()() {
+        unsigned t = mythread.fetch_add(1);
+        if(t < myproducers) {
+            for(unsigned v = 1; v <= myvalues; ++v)
+                myqueue->push(queues_value{v | (t << 24)});
+            return;
+        }
+        unsigned last[64] {};
+        size_t sum = 0;
+        queues_value v;
+        while(mypopped.load(memory_order_relaxed) != static_cast<size_t>(myvalues) * myproducers)
+            if(myqueue->pop(v, 0.01)) {
+                mypopped.fetch_add(1);
+                unsigned
+                    p = v.my >> 24,
+                    n = v.my & 0xffffff;
+                ___water_test(p < myproducers && last[p] < n);
+                last[p] = n;
+                sum += n;
+            }
+        mysum.fetch_add(sum);
+    }
+};
+
+inline void queues() {
+    {
+        queue_bounded<queues_value> q{5};
+        ___water_test(q && q.capacity() == 8);
+        queues_order(q, 8);
+        for(unsigned i = 0; i != 8; ++i)
+            ___water_test(q.push(queues_value{i}));
+        ___water_test(!q.push(queues_value{}));
+        ___water_test(q.size() == 8);
+        queues_value v;
+        for(unsigned i = 0; i != 8; ++i)
+            ___water_test(q.pop(v) && v.my == i);
+        ___water_test(q.push(queues_value{8})); // the values in the queue are destroyed with it
+    }
+    ___water_test(!queues_value::count());
+    {
+        queue_mpsc<queues_value> q{16};
+        queues_order(q, 100);
+        ___water_test(q.empty());
+        ___water_test(q.memory().allocate_block(100));
+        for(unsigned i = 0; i != 100; ++i)
+            ___water_test(q.push_lock_free(queues_value{i}));
+    }
+    ___water_test(!queues_value::count());
+    {
+        queue_mpsc_wait<queues_value> w;
+        ___water_test(w);
+        queues_threads<queue_mpsc_wait<queues_value>>{w, 4, 1, 10000};
+    }
+    {
+        queue_bounded_wait<queues_value> w{16};
+        ___water_test(w);
+        queues_threads<queue_bounded_wait<queues_value>>{w, 4, 4, 10000};
+    }
+    ___water_test(!queues_value::count());
+}
+
+}}}
+#endif
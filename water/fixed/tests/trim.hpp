@@ -0,0 +1,151 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_FIXED_TESTS_TRIM_HPP
+#define WATER_FIXED_TESTS_TRIM_HPP
+#include <water/fixed/tests/bits.hpp>
+#include <water/threads/tests/run_many.hpp>
+#include <water/vector.hpp>
+namespace water { namespace fixed { namespace tests {
+
+/*
+
+test memory_atomic trim
+
+*/
+
+using trim_memory = memory_atomic<void, true, true>;
+
+// threads allocate, write their number in the memory, check it and free, while trim frees blocks
+
+class trim_threads
+{
+    trim_memory *mymemory;
+    atomic<unsigned> mythread{0};
+    atomic<unsigned> mydone{0};
+
+public:
+    explicit trim_threads(trim_memory& memory) :
+        mymemory{&memory}
+    {
+        threads::tests::run_many_reference(*this, 4);
+    }
+
+    void operator()() {
+        unsigned t = mythread.fetch_add(1) + 1;
+        if(t == 1) {
+            while(mydone.load() != 3)
+                mymemory->trim();
+            return;
+        }
+        void *list[50];
+        for(unsigned repeat = 0; repeat != 300; ++repeat) {
+            for(auto& l : list) {
+                l = mymemory->allocate();
+                ___water_test(l);
+                *static_cast<unsigned*>(l) = t;
+            }
+            for(auto l : list) {
+                ___water_test(*static_cast<unsigned*>(l) == t);
+                mymemory->free(l);
+            }
+        }
+        mydone.fetch_add(1);
+    }
+};
+
+// counts the bytes memory_atomic has allocated, including the block_index tables
+
+struct trim_allocator {
+    static size_t& bytes() {
+        static size_t r = 0;
+        return r;
+    }
+    void* allocate(size_t bytes) noexcept {
+        void *r = water::allocator_nothrow{}.allocate(bytes);
+        if(r)
+            trim_allocator::bytes() += bytes;
+        return r;
+    }
+    void free(void *pointer, size_t bytes) noexcept {
+        trim_allocator::bytes() -= bytes;
+        water::allocator_nothrow{}.free(pointer, bytes);
+    }
+};
+
+inline void trim_repeat() {
+    // fill, free and trim many times. the memory left after trim must not grow
+    trim_allocator::bytes() = 0;
+    {
+        memory_atomic<trim_allocator, true, true> memory{64, 64};
+        vector<void*> list;
+        size_t first = 0;
+        for(unsigned repeat = 0; repeat != 300; ++repeat) {
+            list.clear();
+            for(unsigned i = 0; i != 2000; ++i) {
+                void *a = memory.allocate();
+                ___water_test(a);
+                list.push_back(a);
+            }
+            for(auto a : list)
+                memory.free(a);
+            memory.trim();
+            ___water_test(memory.statistics().blocks == 0);
+            if(!repeat)
+                first = trim_allocator::bytes();
+            ___water_test(trim_allocator::bytes() <= first);
+        }
+    }
+    ___water_test(trim_allocator::bytes() == 0);
+}
+
+inline void trim() {
+    trim_repeat();
+    {
+        // keep one allocation in every 4th block
+        trim_memory memory{16, 10};
+        vector<void*> list, keep;
+        for(unsigned b = 0; b != 40; ++b) {
+            ___water_test(memory.allocate_block());
+            size_t first = list.size();
+            while(void *a = memory.allocate_lock_free())
+                list.push_back(a);
+            ___water_test(list.size() - first >= 10);
+            if(b % 4 == 0) {
+                keep.push_back(list.back());
+                list.pop_back();
+            }
+        }
+        for(auto a : list)
+            memory.free(a);
+        auto before = memory.statistics();
+        ___water_test(before.blocks == 40);
+        size_t bytes = memory.trim();
+        auto after = memory.statistics();
+        ___water_test(bytes && bytes == before.memory_use - after.memory_use);
+        ___water_test(after.reclaimed_bytes == bytes);
+        ___water_test(after.reclaimed_blocks + after.blocks == 40);
+        ___water_test(after.allocations_now == keep.size());
+        ___water_test(memory.trim() == 0);
+        // the blocks that are left still work
+        for(auto a : keep)
+            memory.free(a);
+        ___water_test(memory.trim() == after.memory_use);
+        ___water_test(memory.statistics().blocks == 0);
+        void *a = memory.allocate();
+        ___water_test(a);
+        memory.free(a);
+        ___water_test(memory.statistics().reclaimed_blocks == 40);
+    }
+    {
+        trim_memory memory{sizeof(unsigned), 8};
+        trim_threads{memory};
+        ___water_test(memory.statistics().allocations_now == 0);
+        memory.trim();
+        ___water_test(memory.statistics().blocks == 0);
+    }
+}
+
+}}}
+#endif
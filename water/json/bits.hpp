@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -59,7 +59,7 @@ struct memory_node {
     };
     uint16_t name_size;
     json::type type;
-    uchar_t extra; // used for number, imprecisce
+    uchar_t extra; // used for number, imprecisce. object, 1 if it has an object_index
 };
 
 
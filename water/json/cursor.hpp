@@ -0,0 +1,450 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_CURSOR_HPP
+#define WATER_JSON_CURSOR_HPP
+#include <water/json/read_number.hpp>
+#include <water/json/read_string.hpp>
+#include <water/json/read_scan.hpp>
+#include <water/json/string.hpp>
+namespace water { namespace json {
+
+// cursor
+//
+// read json one value at a time, from the beginning to the end, without creating any nodes or
+// allocating any memory. use this when only a few values from a large document are needed.
+//
+// values that are skipped are checked for errors without converting them, and the text is not changed.
+// strings and numbers are converted when string() or number() is used, and names when the cursor is
+// at a value with a name. like read::parse_in_place this modifies the text where strings and names
+// are converted, the strings returned point into the text.
+//
+// the cursor is always at a value. inside an object the value has a name(). enter() moves inside an
+// array or object, next() moves to the next value and skips everything inside the current one.
+// when there are no more values inside an array or object, next() returns false and the cursor is
+// at the array or object again, so next() moves on to the value after it. name() is empty then.
+//
+//    json::cursor c(text, text + size);
+//    if(c.enter()) // {
+//        do {
+//            if(c.name() == "id")
+//                id = c.number().to_int();
+//            else if(c.name() == "items" && c.enter()) { // [
+//                do {
+//                    items.push_back(c.string());
+//                } while(c.next()); // ]
+//            }
+//        } while(c.next()); // }
+//    if(!c.finish())
+//        trace() << "not valid JSON";
+//
+// arrays and objects can be nested depth_max levels deep, if there are more levels it is an error.
+//
+class cursor
+{
+public:
+    static unsigned constexpr depth_max = 1024;
+
+private:
+    static unsigned constexpr stack_bits = numeric_limits<unsigned>::digits;
+
+    uchar_t
+        *myat = 0,
+        *myend = 0,
+        *myvalue = 0, // where the current value begins
+        *myerror = 0, // where the error is, 0 if no error
+        *myname = 0,
+        *mystring = 0, // decoded string
+        *mystring_end = 0;
+    uint16_t myname_size = 0;
+    json::number mynumber;
+    unsigned mydepth = 0;
+    unsigned mystack[depth_max / stack_bits] {}; // 1 if object
+    json::type mytype = json::type::null;
+    bool
+        myconsumed = true, // myat is after the current value
+        myconverted = false, // the current string or number was converted
+        myskip = false, // skipping everything inside a value, do not convert names
+        myimprecise = false,
+        myoverflow = false,
+        myclip_name = false;
+
+public:
+    cursor() = default;
+
+    cursor(char *begin, char *end) :
+        myat{static_cast<uchar_t*>(static_cast<void*>(begin))},
+        myend{static_cast<uchar_t*>(static_cast<void*>(end))}
+    {
+        value_begin(false);
+    }
+
+    explicit operator bool() const {
+        // false if an error was found
+        return !myerror && myvalue;
+    }
+
+    json::string<char const*> parse_error() const {
+        if(!myerror)
+            return {};
+        return {
+            static_cast<char const*>(static_cast<void const*>(myerror)),
+            static_cast<char const*>(static_cast<void const*>(myend))
+        };
+    }
+
+    unsigned depth() const {
+        // 0 at the first value, 1 inside it
+        return mydepth;
+    }
+
+    json::type type() const {
+        return myerror ? json::type::null : mytype;
+    }
+
+    bool is_array() const {
+        return type() == json::type::array;
+    }
+
+    bool is_boolean() const {
+        return type() == json::type::boolean;
+    }
+
+    bool is_null() const {
+        return type() == json::type::null;
+    }
+
+    bool is_number() const {
+        return type() == json::type::number;
+    }
+
+    bool is_object() const {
+        return type() == json::type::object;
+    }
+
+    bool is_string() const {
+        return type() == json::type::string;
+    }
+
+    json::string<char const*> name() const {
+        // name of the current value if it is in an object
+        if(myerror || !myname)
+            return {};
+        return {static_cast<char const*>(static_cast<void const*>(myname)), myname_size};
+    }
+
+    json::string<char const*> string() {
+        // convert the string. the cursor stays at the string
+        if(!is_string() || !convert())
+            return {};
+        return {
+            static_cast<char const*>(static_cast<void const*>(mystring)),
+            static_cast<char const*>(static_cast<void const*>(mystring_end))
+        };
+    }
+
+    json::number number() {
+        // convert the number. the cursor stays at the number
+        if(!is_number() || !convert())
+            return {};
+        return mynumber;
+    }
+
+    bool boolean() {
+        if(!is_boolean() || !consume())
+            return false;
+        return *myvalue == 't';
+    }
+
+    bool imprecise_numbers() const {
+        // if any number converted so far was imprecise
+        return myimprecise;
+    }
+
+    bool numbers_did_overflow() const {
+        return myoverflow;
+    }
+
+    bool object_name_was_cut() const {
+        return myclip_name;
+    }
+
+    bool enter() {
+        // move to the first value inside the current array or object
+        // returns false if it is not an array or object, or if it is empty
+        if(myerror || myconsumed || (mytype != json::type::array && mytype != json::type::object))
+            return false;
+        ++myat;
+        skip_space();
+        if(myat == myend)
+            return error(myvalue);
+        if(*myat == (mytype == json::type::array ? ']' : '}')) {
+            ++myat;
+            myconsumed = true;
+            return false;
+        }
+        if(mydepth == depth_max)
+            return error(myvalue);
+        unsigned &s = mystack[mydepth / stack_bits];
+        unsigned bit = 1u << (mydepth % stack_bits);
+        if(mytype == json::type::object)
+            s |= bit;
+        else
+            s &= ~bit;
+        ++mydepth;
+        return value_begin(mytype == json::type::object);
+    }
+
+    bool next() {
+        // move to the next value, skipping whatever is inside the current value
+        // returns false if there are no more values in the array or object, then the cursor is at
+        // the array or object again. returns false at the end of the document or if there was an error
+        return consume() && move();
+    }
+
+    bool leave() {
+        // skip the remaining values inside the array or object, the cursor will be at it again
+        // returns false at depth() 0 or if there was an error
+        if(myerror || !mydepth)
+            return false;
+        unsigned depth = mydepth;
+        while(next());
+        return !myerror && mydepth == depth - 1;
+    }
+
+    template<typename iterator_>
+    bool find(iterator_ begin, size_t size) {
+        // move to the first value with the name begin,size starting at the current value, and
+        // return true. if not found the cursor is at the object again, like when next() returns false
+        if(myerror || !in_object())
+            return false;
+        do {
+            if(myname && myname_size == size) {
+                iterator_ b = begin;
+                uchar_t const
+                    *n = myname,
+                    *ne = n + size;
+                while(n != ne && *n == string_compare_cast(*b)) {
+                    ++n;
+                    ++b;
+                }
+                if(n == ne)
+                    return true;
+            }
+        } while(next());
+        return false;
+    }
+
+    template<
+        typename range_,
+        typename = decltype(make_type<range_ const&>().begin() == make_type<range_ const&>().end())
+    >
+    bool find(range_ const& name) {
+        return find(name.begin(), size_from(name));
+    }
+
+    template<typename char_, size_t size_>
+    bool find(char_ const (&name)[size_]) {
+        return find(name, size_ - (name[size_ - 1] ? 0 : 1));
+    }
+
+    bool finish() {
+        // skip everything until the end of the document, return true if the whole document is valid
+        while(mydepth && leave());
+        if(!myerror && mydepth == 0) {
+            consume();
+            if(!myerror) {
+                skip_space();
+                if(myat != myend)
+                    error(myat);
+            }
+        }
+        return !myerror && myvalue;
+    }
+
+private:
+    bool error(uchar_t *at) {
+        if(!myerror)
+            myerror = at ? at : myend;
+        return false;
+    }
+
+    void skip_space() {
+        myat = read_skip_space(myat, myend);
+    }
+
+    bool in_object() const {
+        return mydepth && (mystack[(mydepth - 1) / stack_bits] & (1u << ((mydepth - 1) % stack_bits)));
+    }
+
+    template<unsigned size_>
+    bool is(char const (&a)[size_]) {
+        if(myend - myat < static_cast<ptrdiff_t>(size_ - 1))
+            return false;
+        unsigned i = 0;
+        do {
+            if(myat[i] != static_cast<uchar_t>(a[i]))
+                return false;
+        } while(++i != size_ - 1);
+        myat += size_ - 1;
+        return true;
+    }
+
+    bool value_begin(bool named) {
+        // myat is where a value, or a name and a value, should begin
+        skip_space();
+        myname = 0;
+        myname_size = 0;
+        if(named) {
+            if(myat == myend || *myat != '"')
+                return error(myat);
+            auto begin = ++myat;
+            if(myskip) {
+                if(!read_string_skip(myat, myend))
+                    return error(myat);
+            }
+            else {
+                auto end = read_string(myat, myend);
+                if(!end)
+                    return error(myat);
+                if(string_size_clip(myname_size, begin, end))
+                    myclip_name = true;
+                myname = begin;
+            }
+            skip_space();
+            if(myat == myend || *myat != ':')
+                return error(begin - 1);
+            ++myat;
+            skip_space();
+        }
+        if(myat == myend)
+            return error(myat);
+        myvalue = myat;
+        myconsumed = false;
+        myconverted = false;
+        switch(*myat) {
+            case '"': mytype = json::type::string; break;
+            case '[': mytype = json::type::array; break;
+            case '{': mytype = json::type::object; break;
+            case 't':
+            case 'f': mytype = json::type::boolean; break;
+            case 'n': mytype = json::type::null; break;
+            default:
+                if(*myat != '-' && (*myat < '0' || '9' < *myat))
+                    return error(myat);
+                mytype = json::type::number;
+        }
+        return true;
+    }
+
+    bool convert() {
+        // convert the string or number at myvalue, and move after it if that was not done already.
+        // skipping does not change the text, so a value can be converted after it was skipped
+        ___water_assert(mytype == json::type::string || mytype == json::type::number);
+        if(myerror)
+            return false;
+        if(myconverted)
+            return true;
+        auto at = myvalue;
+        if(mytype == json::type::string) {
+            auto begin = ++at;
+            auto end = read_string(at, myend);
+            if(!end)
+                return error(at);
+            mystring = begin;
+            mystring_end = end;
+        }
+        else {
+            if(!read_number(mynumber, at, myend))
+                return error(myvalue);
+            myimprecise = myimprecise || mynumber.imprecise();
+            myoverflow = myoverflow || mynumber.overflow();
+        }
+        if(!myconsumed) {
+            myat = at;
+            myconsumed = true;
+        }
+        myconverted = true;
+        return true;
+    }
+
+    bool skip_scalar() {
+        // check the string, number, true, false, null at myat and move after it, without converting it
+        ___water_assert(!myconsumed && mytype != json::type::array && mytype != json::type::object);
+        if(mytype == json::type::string) {
+            ++myat;
+            if(!read_string_skip(myat, myend))
+                return error(myat);
+        }
+        else if(mytype == json::type::number) {
+            if(!read_number_skip(myat, myend))
+                return error(myvalue);
+        }
+        else if(!(mytype == json::type::null ? is("null") : *myat == 't' ? is("true") : is("false")))
+            return error(myvalue);
+        myconsumed = true;
+        return true;
+    }
+
+    bool consume() {
+        // move after the current value, without going deeper
+        if(myerror)
+            return false;
+        if(myconsumed)
+            return true;
+        if(mytype != json::type::array && mytype != json::type::object)
+            return skip_scalar();
+        unsigned depth = mydepth;
+        myskip = true;
+        bool r = skip_inside(depth);
+        myskip = false;
+        return r;
+    }
+
+    bool skip_inside(unsigned depth) {
+        // skip everything inside the array or object at depth
+        if(!enter())
+            return !myerror;
+        while(true) {
+            if(!myconsumed && (mytype == json::type::array || mytype == json::type::object)) {
+                enter();
+            }
+            else if(!myconsumed && !skip_scalar())
+                return false;
+            else if(!move() && (myerror || mydepth == depth))
+                return !myerror;
+            if(myerror)
+                return false;
+        }
+    }
+
+    bool move() {
+        // myat is after the current value
+        ___water_assert(myconsumed);
+        skip_space();
+        if(!mydepth) {
+            if(myat != myend)
+                error(myat);
+            return false;
+        }
+        if(myat == myend)
+            return error(myat);
+        bool object = in_object();
+        if(*myat == ',') {
+            ++myat;
+            return value_begin(object);
+        }
+        if(*myat != (object ? '}' : ']'))
+            return error(myat);
+        ++myat;
+        --mydepth;
+        myname = 0; // the name of the array or object is gone
+        mytype = object ? json::type::object : json::type::array;
+        myconsumed = true;
+        return false;
+    }
+};
+
+}}
+#endif
@@ -1,11 +1,13 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_JSON_JSON_HPP
 #define WATER_JSON_JSON_HPP
 #include <water/json/read.hpp>
+#include <water/json/cursor.hpp>
 #include <water/json/encoding.hpp>
 #include <water/json/indent.hpp>
 #include <water/json/write.hpp>
+#include <water/json/write_to.hpp>
 #endif
@@ -1,4 +1,4 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -12,6 +12,10 @@ template<typename allocator_ = water::allocator>
 struct memory :
     xml_json::memory<allocator_>
 {
+private:
+    size_t myindex_objects = 0;
+
+public:
     memory() = default;
 
     memory(typename xml_json::memory<allocator_>::allocator_type const& a) :
@@ -19,22 +23,42 @@ struct memory :
     {}
 
     memory(memory&& a) :
-        xml_json::memory<allocator_>{static_cast<xml_json::memory<allocator_>&&>(a)}
+        xml_json::memory<allocator_>{static_cast<xml_json::memory<allocator_>&&>(a)},
+        myindex_objects{a.myindex_objects}
     {}
 
     memory(memory const& a) = delete;
     memory& operator=(memory const&) = delete;
 
     memory& operator=(memory&& a) {
-        xml_json::memory<allocator_>::operator=(static_cast<xml_json::memory<allocator_>&&>(a));
+        swap(a);
         return *this;
     }
 
+    void swap(memory& a) {
+        xml_json::memory<allocator_>::swap(a);
+        swap_from_swap(myindex_objects, a.myindex_objects);
+    }
+
     node<memory> create() {
         auto n = static_cast<memory_node*>(this->allocate(sizeof(memory_node), alignof(memory_node)));
         if(n) *n = {};
         return {*this, n};
     }
+
+    size_t index_objects() const {
+        return myindex_objects;
+    }
+
+    void index_objects(size_t at_least) {
+        // objects with at least this many nodes get a hash table index to find nodes by name faster.
+        // 0 means never, this is the default.
+        //
+        // read will make the index for objects when it parses. node::find and node::operator[] will
+        // make it the first time they are used on an object that does not have one, so those
+        // functions modify the object. see object_index.hpp
+        myindex_objects = at_least;
+    }
 };
 
 template<typename allocator_>
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -8,6 +8,7 @@
 #include <water/json/number.hpp>
 #include <water/json/string.hpp>
 #include <water/json/iterator.hpp>
+#include <water/json/object_index.hpp>
 namespace water { namespace json {
 
 template<typename memory_, typename other_, typename result_>
@@ -240,8 +241,13 @@ public:
     node find(iterator_ begin, size_t size) const {
         // find first node with name begin,size
         // starts looking at this
+        //
+        // if memory_pointer()->index_objects() says so, this makes an index for in() if it does
+        // not have one. see object_index.hpp
         if(!my || !my->in || my->in->type != type_::object)
             return {mym, 0};
+        if(auto index = index_of(mym, my->in))
+            return {mym, object_index_find(my->in, index, my->me.at, begin, size)};
         auto
             i = my->in->nodes + my->me.at,
             e = my->in->nodes + my->in->size;
@@ -365,6 +371,7 @@ public:
     node_if_mutable pop_back() {
         node r {mym, 0};
         if(my && my->me.capacity && my->size) {
+            my->extra = 0;
             r.my = my->nodes[--my->size];
             my->nodes[my->size] = 0;
             r.my->in = 0;
@@ -416,6 +423,7 @@ public:
     node_if_mutable remove(size_t at) {
         if(!my || !my->me.capacity || at > my->size)
             return {mym, 0};
+        my->extra = 0;
         auto
             i = my->nodes + at,
             e = my->nodes + my->size;
@@ -447,6 +455,8 @@ public:
         // this does not have to be in an object
         if(my && !copy(my->name, my->name_size, begin, size))
             return {mym, 0};
+        if(my && my->in)
+            my->in->extra = 0;
         return *this;
     }
 
@@ -521,6 +531,8 @@ private:
     bool grow(size_t capacity, bool exactly) {
         // when this returns true, at least capacity is available and it is an array or object
         // capacity can be 0, then it cannot fail
+        // this is used before the nodes change, so the object_index is not valid after
+        my->extra = 0;
         if(my->me.capacity < capacity) { // ignores integer size integer overflow
             size_t s = capacity;
             if(!exactly && capacity < static_cast<uint32_t>(-1) / 2) {
@@ -564,6 +576,7 @@ private:
     }
 
     void nodes_clear() {
+        my->extra = 0;
         if(my->me.capacity) {
             auto i = my->nodes, e = i + my->size;
             while(i != e) {
@@ -577,6 +590,26 @@ private:
         }
     }
 
+    static object_index const* index_of(void*, memory_node *a) {
+        return object_index_of(a);
+    }
+
+    template<typename memory2_>
+    static object_index const* index_of(memory2_* m, memory_node *a) {
+        // make the index if it should have one
+        auto r = object_index_of(a);
+        if(!r && a->me.capacity && object_index_should(a, object_index_at_least(m))) {
+            auto nodes = static_cast<memory_node**>(m->allocate(object_index_bytes(a->me.capacity, a->size), alignof(memory_node**)));
+            if(nodes) {
+                for(uint32_t i = 0; i != a->me.capacity; ++i)
+                    nodes[i] = i < a->size ? a->nodes[i] : 0;
+                object_index_make(a, nodes, a->me.capacity);
+                r = object_index_of(a);
+            }
+        }
+        return r;
+    }
+
     template<typename size_, typename iterator_>
     bool copy(uchar_t*& to, size_& to_size, iterator_ from, size_t from_size) {
         if(to_size < from_size && (to = static_cast<uchar_t*>(mym->allocate(from_size, 1))) == 0)
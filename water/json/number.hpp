@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -7,6 +7,7 @@
 #include <water/json/bits.hpp>
 #include <water/numeric_limits.hpp>
 #include <water/cmath.hpp>
+#include <water/numbers/decimal_to_float.hpp>
 namespace water { namespace json {
 
 //
@@ -32,7 +33,7 @@ public:
     number(double a) {
         if(isinf_strict(a) || isnan_strict(a))
             myimprecise = true;
-        else if(a) {
+        else if(a && !shortest(a)) {
             // can still be subnormal
             // this is stolen from ministr
             double m = a;
@@ -70,7 +71,13 @@ public:
     number(unsigned int a) : number{static_cast<int64_t>(a), 0} {}
     number(unsigned long a) : number{static_cast<int64_t>(a), 0} {}
     number(unsigned long long a) : number{static_cast<int64_t>(a), 0} {}
-    number(float a) : number{static_cast<double>(a)} {}
+    number(float a) {
+        // float has its own shortest digits, 0.1f is 0.1 and not 0.100000001490116
+        if(isinf_strict(a) || isnan_strict(a))
+            myimprecise = true;
+        else if(a && !shortest(a))
+            *this = number{static_cast<double>(a)};
+    }
     number(long double a) : number{static_cast<double>(a)} {}
     
     int64_t integer() const {
@@ -97,21 +104,8 @@ public:
     }
 
     double to_double() const {
-        // returns 0 if infinity, nan, subnormal
-        double r = static_cast<double>(myi);
-        if(mye) {
-            auto e = mye;
-            int32_t const e_small = numeric_limits<double>::min_exponent10 + (numeric_limits<double>::digits10 + 2);
-            if(e <= e_small) {
-                // if it's really small do two pow()
-                r *= pow(10., e - e_small);
-                e = e_small;
-            }
-            r *= pow(10., e);
-        }
-        if(!isfinite_strict(r))
-            r = 0;
-        return r;
+        // returns 0 if infinity or nan. see to_float
+        return to_float<double>();
     }
 
     int64_t to_int() const {
@@ -139,9 +133,7 @@ public:
     }
 
     explicit operator float() const {
-        auto r = static_cast<float>(to_double());
-        if(!isfinite_strict(r)) r = 0;
-        return r;
+        return to_float<float>();
     }
 
     explicit operator long double() const {
@@ -193,6 +185,62 @@ public:
     }
 
 private:
+    double to_double_pow() const {
+        // not correctly rounded, and 0 if subnormal
+        double r = static_cast<double>(myi);
+        if(mye) {
+            auto e = mye;
+            int32_t const e_small = numeric_limits<double>::min_exponent10 + (numeric_limits<double>::digits10 + 2);
+            if(e <= e_small) {
+                // if it's really small do two pow()
+                r *= pow(10., e - e_small);
+                e = e_small;
+            }
+            r *= pow(10., e);
+        }
+        if(!isfinite_strict(r))
+            r = 0;
+        return r;
+    }
+
+    template<typename float_>
+    float_ to_float() const {
+        // correctly rounded from integer() and exponent(), if the type can use numbers::decimal_to_float.
+        //
+        // when imprecise() is true the number had more digits than integer() can hold, and json::read
+        // rounded it to 18 or 19 digits. the digits after are gone, so the result can be 1 ulp from what
+        // the whole text would give. use numbers::read<double> on the text if that matters
+        uint64_t u = static_cast<uint64_t>(myi);
+        if(myi < 0)
+            u = 0 - u;
+        numbers::decimal_to_float<float_> d(u, mye);
+        float_ r;
+        if(d) {
+            r = d;
+            if(myi < 0)
+                r = -r;
+        }
+        else
+            r = static_cast<float_>(to_double_pow());
+        if(!isfinite_strict(r))
+            r = 0;
+        return r;
+    }
+
+    template<typename float_>
+    bool shortest(float_ a) {
+        // the fewest digits that convert back to exactly a. false if that is not possible for float_
+        numbers::shortest s{a};
+        if(!s)
+            return false;
+        myi = static_cast<int64_t>(s.digits()); // at most 17 digits
+        if(s.minus())
+            myi = -myi;
+        mye = s.exponent();
+        normalize();
+        return true;
+    }
+
     void normalize() {
         if(!myi)
             mye = 0;
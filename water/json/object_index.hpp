@@ -0,0 +1,154 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_OBJECT_INDEX_HPP
+#define WATER_JSON_OBJECT_INDEX_HPP
+#include <water/json/bits.hpp>
+namespace water { namespace json {
+
+/*
+
+Hash table to find nodes by name in large objects, so node::find and node::operator[] do not have to
+look at every node in the object.
+
+The index is allocated together with the nodes array of the object, right after the capacity of
+nodes, so memory_node does not grow. memory_node::extra is not used by objects otherwise, it is 1
+if the object has an index. Anything that changes the object or the names of its nodes sets extra
+to 0, and the next lookup builds the index again if it should.
+
+Each slot is a hash and the position + 1 of one node, 0 means empty. Duplicate names have one slot
+each, so find can still return the first node with a name at or after any position.
+
+*/
+
+uint32_t constexpr object_index_size_max = 0x10000000;
+
+struct object_index {
+    uint32_t
+        slots, // power of 2
+        size; // size of the object when the index was made
+};
+
+struct object_index_slot {
+    uint32_t
+        hash,
+        at; // position + 1, 0 if empty
+};
+
+template<typename iterator_>
+uint32_t object_index_hash(iterator_ begin, size_t size) {
+    // fnv-1a. the characters are hashed after string_compare_cast, so a name matches the same
+    // way as node::find compares names
+    uint32_t r = 2166136261u;
+    while(size) {
+        r = static_cast<uint32_t>((r ^ static_cast<uint32_t>(string_compare_cast(*begin))) * 16777619u);
+        ++begin;
+        --size;
+    }
+    return r;
+}
+
+inline uint32_t object_index_slots(uint32_t size) {
+    // at most half full
+    uint32_t r = 8;
+    while(r < size * 2u)
+        r *= 2;
+    return r;
+}
+
+inline size_t object_index_bytes(uint32_t capacity, uint32_t size) {
+    // bytes for a nodes array with capacity plus index for size nodes
+    return
+        sizeof(memory_node*) * capacity +
+        sizeof(object_index) +
+        sizeof(object_index_slot) * object_index_slots(size);
+}
+
+static_assert(alignof(memory_node*) % alignof(object_index) == 0 && sizeof(object_index) % alignof(object_index_slot) == 0, "");
+
+inline object_index* object_index_of(memory_node const* a) {
+    // returns 0 if a has no usable index
+    if(!a || a->type != type::object || !a->extra || !a->me.capacity)
+        return 0;
+    auto r = static_cast<object_index*>(static_cast<void*>(a->nodes + a->me.capacity));
+    return r->size == a->size ? r : 0;
+}
+
+inline void object_index_make(memory_node *a, memory_node **nodes, uint32_t capacity) {
+    // nodes must have room for object_index_bytes(capacity, a->size) and contain the a->size nodes
+    // of a. this builds the index after them, and makes them the nodes of a
+    ___water_assert(a->type == type::object && capacity >= a->size && a->size <= object_index_size_max);
+    auto index = static_cast<object_index*>(static_cast<void*>(nodes + capacity));
+    index->slots = object_index_slots(a->size);
+    index->size = a->size;
+    auto slots = static_cast<object_index_slot*>(static_cast<void*>(index + 1));
+    for(uint32_t i = 0; i != index->slots; ++i)
+        slots[i] = {};
+    uint32_t mask = index->slots - 1;
+    for(uint32_t i = 0; i != a->size; ++i) {
+        uint32_t hash = object_index_hash(nodes[i]->name, nodes[i]->name_size);
+        uint32_t s = hash & mask;
+        while(slots[s].at)
+            s = (s + 1) & mask;
+        slots[s] = {hash, i + 1};
+    }
+    a->nodes = nodes;
+    a->extra = 1;
+}
+
+namespace _ {
+    template<typename memory_>
+    auto object_index_at_least_do(memory_ const* a, int) -> decltype(static_cast<size_t>(a->index_objects())) {
+        return a->index_objects();
+    }
+    
+    inline size_t object_index_at_least_do(void const*, ...) {
+        return 0;
+    }
+}
+
+template<typename memory_>
+size_t object_index_at_least(memory_ const* a) {
+    // objects with at least this many nodes should have an index, 0 means never
+    return _::object_index_at_least_do(a, 0);
+}
+
+inline bool object_index_should(memory_node const* a, size_t at_least) {
+    // a must be an object with a valid size, nodes and me.capacity do not matter
+    return at_least && a->type == type::object && a->size >= at_least && a->size <= object_index_size_max;
+}
+
+template<typename iterator_>
+memory_node* object_index_find(memory_node const* a, object_index const* index, uint32_t from, iterator_ begin, size_t size) {
+    // return the first node in a with name begin,size at position from or after, or 0
+    auto slots = static_cast<object_index_slot const*>(static_cast<void const*>(index + 1));
+    uint32_t
+        mask = index->slots - 1,
+        hash = object_index_hash(begin, size),
+        s = hash & mask,
+        found = 0;
+    while(slots[s].at) {
+        uint32_t at = slots[s].at - 1;
+        if(slots[s].hash == hash && at >= from && (!found || at < found - 1)) {
+            auto n = a->nodes[at];
+            if(n->name_size == size) {
+                iterator_ b = begin;
+                uchar_t const
+                    *c = n->name,
+                    *ce = c + size;
+                while(c != ce && *c == string_compare_cast(*b)) {
+                    ++c;
+                    ++b;
+                }
+                if(c == ce)
+                    found = at + 1;
+            }
+        }
+        s = (s + 1) & mask;
+    }
+    return found ? a->nodes[found - 1] : 0;
+}
+
+}}
+#endif
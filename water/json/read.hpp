@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -9,8 +9,91 @@
 #include <water/json/memory.hpp>
 #include <water/json/read_number.hpp>
 #include <water/json/read_string.hpp>
+#include <water/json/read_scan.hpp>
+#include <water/allocator_nothrow.hpp>
+#include <water/swap.hpp>
 namespace water { namespace json {
 
+namespace _ {
+
+    // copy of the token that did not end in the previous part, when parsing in parts. this is not
+    // in the memory object so it can be freed when it grows, and it is reused for each token.
+    // if copying fails, begin is 0 and size is not
+    struct read_carry {
+        uchar_t *begin = 0;
+        size_t
+            size = 0,
+            capacity = 0;
+
+        read_carry() = default;
+
+        read_carry(read_carry const& a) :
+            size{a.size}
+        {
+            if(size && (begin = static_cast<uchar_t*>(allocator_nothrow{}.allocate(size))) != 0) {
+                capacity = size;
+                for(size_t i = 0; i != size; ++i)
+                    begin[i] = a.begin[i];
+            }
+        }
+
+        read_carry(read_carry&& a) noexcept :
+            begin{a.begin},
+            size{a.size},
+            capacity{a.capacity}
+        {
+            a.begin = 0;
+            a.size = a.capacity = 0;
+        }
+
+        ~read_carry() {
+            if(begin)
+                allocator_nothrow{}.free(begin, capacity);
+        }
+
+        read_carry& operator=(read_carry const& a) {
+            read_carry copy{a};
+            swap(copy);
+            return *this;
+        }
+
+        read_carry& operator=(read_carry&& a) noexcept {
+            swap(a);
+            return *this;
+        }
+
+        void swap(read_carry& a) noexcept {
+            swap_from_swap(begin, a.begin);
+            swap_from_swap(size, a.size);
+            swap_from_swap(capacity, a.capacity);
+        }
+
+        bool append(uchar_t const* from, uchar_t const* to) {
+            size_t add = static_cast<size_t>(to - from);
+            if(capacity - size < add) {
+                size_t c = capacity ? capacity * 2 : 64;
+                while(c < size + add)
+                    c *= 2;
+                auto b = static_cast<uchar_t*>(allocator_nothrow{}.allocate(c));
+                if(!b)
+                    return false;
+                for(size_t i = 0; i != size; ++i)
+                    b[i] = begin[i];
+                if(begin)
+                    allocator_nothrow{}.free(begin, capacity);
+                begin = b;
+                capacity = c;
+            }
+            auto at = begin + size;
+            while(from != to)
+                *at++ = *from++;
+            size = static_cast<size_t>(at - begin);
+            return true;
+        }
+    };
+
+}
+
 // read
 //
 // parse json into nodes, using memory_.
@@ -24,13 +107,45 @@ public:
     using memory_type = memory_;
     using node_type = node<memory_type>;
 
+private:
+    enum step_type : unsigned char {
+        step_value, // before a value, or a name inside an object
+        step_colon, // after a name inside an object
+        step_open, // after [ or {
+        step_after // after a value inside an array or object
+    };
+
+    enum parts_type : unsigned char {
+        parts_no,
+        parts_yes,
+        parts_failed
+    };
+
+    struct state {
+        memory_node
+            *previous, // 0 if first inside object/array
+            *in; // inside non-empty object/array
+        uchar_t
+            *name_begin, // object name. empty name is fine
+            *name_end,
+            *error, // where the current value began, this is where the error is if it fails
+            *error_end; // end of the part where error is, when parsing in parts
+        memory_node current; // the [ or { at step_open
+        step_type step;
+    };
+
 private:
     memory_type *mymemory;
     memory_node *my = 0;
     uchar_t
         *myat = 0,
-        *myend = 0;
+        *myend = 0,
+        *mywait = 0; // a token that did not end before myend, when parsing in parts
+    _::read_carry mycarry;
+    state mystate {};
+    parts_type myparts = parts_no;
     bool
+        mycarry_escape = false,
         myimprecise = false, // if any number is imprecise
         myoverflow = false,
         myerror_memory = false,
@@ -105,6 +220,51 @@ public:
         return *this;
     }
 
+    read& parse_in_place_part(char *begin, char *end, bool more) {
+        // parse json that is split in many parts, like when it is read from a file or socket
+        // a little at a time. call this with more = true for each part except the last, and
+        // more = false for the last part. the last part can be empty.
+        //
+        // like parse_in_place this modifies the memory of each part, and the nodes will point to
+        // it. each part must exist for as long as the nodes are used, allocating them from the
+        // memory object is a good idea. only a string, number, true, false or null that is split
+        // between two parts is copied into the memory object. the memory used by the nodes is not
+        // given back if parsing fails after the first part.
+        //
+        // the parts must be UTF-8 without a byte order mark.
+        //
+        // the first call after parse_in_place or operator() starts a new document, and so does the
+        // first call after the last part. if parse_error() or allocation_failed() says something
+        // went wrong before the last part, the following parts are ignored. parse_error() begins
+        // where the value with the error begins, and ends where that part ends.
+        //
+        if(myparts == parts_no) {
+            reset();
+            myparts = parts_yes;
+        }
+        if(myparts == parts_yes) {
+            auto
+                b = static_cast<uchar_t*>(static_cast<void*>(begin)),
+                e = static_cast<uchar_t*>(static_cast<void*>(end));
+            if(mycarry.size)
+                b = carry_continue(b, e, more);
+            if(b) {
+                myat = b;
+                myend = e;
+                myat = parse(!more, more);
+                if(myat == myend && mywait && !carry_begin())
+                    myat = 0;
+            }
+            if(myat != myend)
+                myparts = parts_failed;
+            else if(more)
+                mymemory->no_undo(); // so the memory object can be used to allocate the next part
+        }
+        if(!more)
+            myparts = parts_no;
+        return *this;
+    }
+
     template<typename iterator_>
     read& operator()(iterator_ begin, iterator_ end) {
         reset();
@@ -188,11 +348,69 @@ private:
 
     void reset() {
         my = 0;
-        myat = myend = 0;
+        myat = myend = mywait = 0;
+        mycarry.size = 0;
+        mystate = {};
+        myparts = parts_no;
+        mycarry_escape = false;
         myimprecise = myoverflow = myerror_memory = false;
         myclip_string = myclip_name = false;
     }
 
+    bool carry_begin() {
+        // copy the token at mywait...myend
+        ___water_assert(mywait && !mycarry.size);
+        bool string = *mywait == '"';
+        mycarry_escape = false;
+        if(string)
+            read_token_end(mywait + 1, myend, true, mycarry_escape);
+        myerror_memory = !mycarry.append(mywait, myend);
+        mywait = 0;
+        return !myerror_memory;
+    }
+
+    uchar_t* carry_continue(uchar_t *begin, uchar_t *end, bool more) {
+        // the token in mycarry continues at begin. returns where to continue parsing, or 0 if it
+        // failed or if all of begin,end was copied and the token still has not ended
+        if(!mycarry.begin) {
+            // copying this read failed to copy mycarry
+            myerror_memory = true;
+            myat = 0;
+            myend = end;
+            return 0;
+        }
+        bool string = *mycarry.begin == '"';
+        auto token_end = read_token_end(begin, end, string, mycarry_escape);
+        if(!mycarry.append(begin, token_end ? token_end : end)) {
+            myerror_memory = true;
+            myat = 0;
+            myend = end;
+            return 0;
+        }
+        if(!token_end && more) {
+            myat = myend = end;
+            return 0;
+        }
+        // the nodes point to the token, so it is copied to the memory object before parsing
+        myerror_memory = true;
+        auto token = static_cast<uchar_t*>(mymemory->allocate_with_undo(mycarry.size, 1));
+        if(!token) {
+            myat = 0;
+            myend = end;
+            return 0;
+        }
+        myerror_memory = false;
+        for(size_t i = 0; i != mycarry.size; ++i)
+            token[i] = mycarry.begin[i];
+        myat = token;
+        myend = token + mycarry.size;
+        mycarry.size = 0;
+        myat = parse(false, false);
+        if(myat != myend)
+            return 0;
+        return token_end ? token_end : end;
+    }
+
     memory_node* create() {
         myerror_memory = true;
         auto r = static_cast<memory_node*>(mymemory->allocate_with_undo(sizeof(memory_node))); // throws??
@@ -200,15 +418,6 @@ private:
         return r;
     }
 
-    bool is_space(uchar_t a) const {
-        // no unicode space, only these are allowed
-        return
-            a == 0x20 || // space
-            a == 0x0a || // lf
-            a == 0x0d || // cr
-            a == 0x09; // tab
-    }
-
     template<unsigned size_>
     bool is(char const (&a)[size_]) {
         if(myend - myat < static_cast<ptrdiff_t>(size_ - 1))
@@ -223,60 +432,82 @@ private:
     }
 
     void skip_space() {
-        while(myat != myend && is_space(*myat)) ++myat;
+        myat = read_skip_space(myat, myend);
     }
 
-    uchar_t* parse() {
-        uchar_t *r = myat;
-        memory_node
-            *previous = 0, // 0 if first inside object/array
-            *in = 0; // inside non-empty object/array
-        uchar_t
-            *name_begin = 0, // object name. empty name is fine
-            *name_end = 0;
-        while(myat != myend) {
-            skip_space();
-            if(myat == myend)
-                break;
-            r = myat;
-            memory_node current = {};
-            if(name_begin) {
-                current.name = name_begin;
-                if(string_size_clip(current.name_size, name_begin, name_end))
-                    myclip_name = true;
-            }
-            name_begin = name_end = 0;
-            if(*myat == '"') {
-                // "hello"
-                // "hello": something (if inside object)
-                uchar_t
-                    *begin = ++myat,
-                    *end = read_string(myat, myend);
-                if(!end)
-                    return myat; // this is where it went wrong
-                // if in object, this must be a name followed by a :
-                if(in && in->type == type::object && !current.name) {
-                    skip_space();
-                    if(myat == myend || *myat != ':')
-                        return r;
+    uchar_t* parse(bool last = true, bool check = false) {
+        // returns myend if success, 0 if memory allocation failed, or where the error is
+        //
+        // last is false when parsing in parts. then this returns myend when it reaches the end,
+        // and everything needed to continue with the next part is in mystate.
+        //
+        // check is true when parsing in parts. if a string, number, true, false or null does not
+        // end before myend, parsing stops before it and mywait is where it begins
+        //
+        state s = mystate;
+        if(s.error == s.error_end) {
+            s.error = myat;
+            s.error_end = myend;
+        }
+        size_t const index_at_least = object_index_at_least(mymemory); // objects with at least this many nodes get an index
+        while(true) {
+            if(s.step == step_after) {
+                // after a value inside array/object: must be one of , ] }
+                // if it was close ] } keep looking for more
+                skip_space();
+                if(myat == myend)
+                    break;
+                if(*myat == ',') {
                     ++myat;
-                    name_begin = begin;
-                    name_end = end;
-                    continue;
+                    s.step = step_value;
+                }
+                else if(*myat == (s.in->type == type::array ? ']' : '}')) {
+                    ++myat;
+                    bool index = object_index_should(s.in, index_at_least);
+                    s.in->nodes = static_cast<memory_node**>(mymemory->allocate_with_undo(
+                        index ? object_index_bytes(s.in->size, s.in->size) : sizeof(memory_node**) * s.in->size,
+                        alignof(memory_node**)
+                    ));
+                    if(!s.in->nodes)
+                        return 0;
+                    auto i = s.in->nodes + s.in->size;
+                    do {
+                        auto nn = s.previous;
+                        s.previous = s.previous->previous;
+                        *--i = nn;
+                        nn->me = {};
+                        nn->me.at = static_cast<uint32_t>(i - s.in->nodes);
+                        if(nn->type == type::array || nn->type == type::object)
+                            nn->me.capacity = nn->size;
+                    } while(i != s.in->nodes);
+                    if(index)
+                        object_index_make(s.in, s.in->nodes, s.in->size);
+                    s.previous = s.in;
+                    s.in = s.in->in;
+                    if(!s.in)
+                        s.step = step_value;
                 }
-                current.type = type::string;
-                current.string = begin;
-                if(string_size_clip(current.size, begin, end))
-                    myclip_string = true;
+                else
+                    return parse_failed(s);
+                continue;
             }
-            else if(in && in->type == type::object && !current.name) // inside object, must be "name":value
-                return r;
-            else if(*myat == '[' || *myat == '{') {
-                current.type = *myat == '[' ? type::array : type::object;
+            if(s.step == step_colon) {
+                skip_space();
+                if(myat == myend)
+                    break;
+                if(*myat != ':')
+                    return parse_failed(s);
                 ++myat;
+                s.step = step_value;
+                continue;
+            }
+            memory_node current;
+            if(s.step == step_open) {
                 skip_space();
                 if(myat == myend)
-                    return r;
+                    break;
+                current = s.current;
+                s.step = step_value;
                 bool empty = current.type == type::array ? *myat == ']' : *myat == '}';
                 if(!empty) {
                     // go deeper
@@ -284,88 +515,113 @@ private:
                     if(!n)
                         return 0;
                     *n = current;
-                    n->previous = previous;
-                    n->in = in;
+                    n->previous = s.previous;
+                    n->in = s.in;
                     if(n->in) {
-                        if(in->size == static_cast<uint32_t>(-1))
+                        if(s.in->size == static_cast<uint32_t>(-1))
                             return 0;
-                        ++in->size;
+                        ++s.in->size;
                     }
-                    in = n;
-                    previous = 0;
+                    s.in = n;
+                    s.previous = 0;
                     continue;
                 }
                 ++myat;
             }
-            else if(*myat == '-' || ('0' <= *myat && *myat <= '9')) {
-                number n;
-                if(!read_number(n, myat, myend))
-                    return r;
-                current.type = type::number;
-                current.extra = n.imprecise();
-                current.exponent = n.exponent();
-                current.integer = n.integer();
-                myimprecise = myimprecise || n.imprecise();
-                myoverflow = myoverflow || n.overflow();
-            }
-            else if(is("true")) {
-                current.type = type::boolean;
-                current.boolean = true;
-            }
-            else if(is("false")) {
-                current.type = type::boolean;
-                current.boolean = false;
+            else {
+                skip_space();
+                if(myat == myend)
+                    break;
+                if(check && *myat != '[' && *myat != '{') {
+                    bool escape = false;
+                    if(!read_token_end(myat + (*myat == '"'), myend, *myat == '"', escape)) {
+                        mywait = myat;
+                        break;
+                    }
+                }
+                s.error = myat;
+                s.error_end = myend;
+                current = {};
+                if(s.name_begin) {
+                    current.name = s.name_begin;
+                    if(string_size_clip(current.name_size, s.name_begin, s.name_end))
+                        myclip_name = true;
+                }
+                s.name_begin = s.name_end = 0;
+                if(*myat == '"') {
+                    // "hello"
+                    // "hello": something (if inside object)
+                    uchar_t
+                        *begin = ++myat,
+                        *end = read_string(myat, myend);
+                    if(!end)
+                        return myat; // this is where it went wrong
+                    // if in object, this must be a name followed by a :
+                    if(s.in && s.in->type == type::object && !current.name) {
+                        s.name_begin = begin;
+                        s.name_end = end;
+                        s.step = step_colon;
+                        continue;
+                    }
+                    current.type = type::string;
+                    current.string = begin;
+                    if(string_size_clip(current.size, begin, end))
+                        myclip_string = true;
+                }
+                else if(s.in && s.in->type == type::object && !current.name) // inside object, must be "name":value
+                    return parse_failed(s);
+                else if(*myat == '[' || *myat == '{') {
+                    current.type = *myat == '[' ? type::array : type::object;
+                    ++myat;
+                    s.current = current;
+                    s.step = step_open;
+                    continue;
+                }
+                else if(*myat == '-' || ('0' <= *myat && *myat <= '9')) {
+                    number n;
+                    if(!read_number(n, myat, myend))
+                        return parse_failed(s);
+                    current.type = type::number;
+                    current.extra = n.imprecise();
+                    current.exponent = n.exponent();
+                    current.integer = n.integer();
+                    myimprecise = myimprecise || n.imprecise();
+                    myoverflow = myoverflow || n.overflow();
+                }
+                else if(is("true")) {
+                    current.type = type::boolean;
+                    current.boolean = true;
+                }
+                else if(is("false")) {
+                    current.type = type::boolean;
+                    current.boolean = false;
+                }
+                else if(!is("null")) // current is already null
+                    return parse_failed(s);
             }
-            else if(!is("null")) // current is already null
-                return r;
             
             memory_node *n = create();
             if(!n)
                 return 0;
             *n = current;
-            n->previous = previous;
-            previous = n;
-            n->in = in;
+            n->previous = s.previous;
+            s.previous = n;
+            n->in = s.in;
             if(n->in) {
-                if(in->size == static_cast<uint32_t>(-1))
+                if(s.in->size == static_cast<uint32_t>(-1))
                     return 0;
-                ++in->size;
-                // after a value inside array/object: must be one of , ] }
-                // if it was close ] } keep looking for more
-                do {
-                    skip_space();
-                    if(myat == myend)
-                        return r;
-                    if(*myat == ',') {
-                        ++myat;
-                        break;
-                    }
-                    else if(*myat == (in->type == type::array ? ']' : '}')) {
-                        ++myat;
-                        in->nodes = static_cast<memory_node**>(mymemory->allocate_with_undo(sizeof(memory_node**) * in->size, alignof(memory_node**)));
-                        if(!in->nodes)
-                            return 0;
-                        auto i = in->nodes + in->size;
-                        do {
-                            auto nn = previous;
-                            previous = previous->previous;
-                            *--i = nn;
-                            nn->me = {};
-                            nn->me.at = static_cast<uint32_t>(i - in->nodes);
-                            if(nn->type == type::array || nn->type == type::object)
-                                nn->me.capacity = nn->size;
-                        } while(i != in->nodes);
-                        previous = in;
-                        in = in->in;
-                    }
-                    else
-                        return r;
-                } while(in);
+                ++s.in->size;
+                s.step = step_after;
             }
         }
         
-        if(!in && previous && !previous->previous) {
-            my = previous;
+        if(!last) {
+            mystate = s;
+            return myend;
+        }
+        
+        if(s.step == step_value && !s.in && s.previous && !s.previous->previous) {
+            my = s.previous;
             my->me = {};
             if(my->type == type::array || my->type == type::object)
                 my->me.capacity = my->size;
@@ -373,7 +629,13 @@ private:
             return myend;
         }
         
-        return r;
+        return parse_failed(s);
+    }
+
+    uchar_t* parse_failed(state const& s) {
+        // when parsing in parts, the value where the error is can be in a previous part
+        myend = s.error_end;
+        return s.error;
     }
     
 };
@@ -0,0 +1,193 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_READ_LINES_HPP
+#define WATER_JSON_READ_LINES_HPP
+#include <water/json/read.hpp>
+#include <water/threads/thread.hpp>
+#include <water/vector.hpp>
+namespace water { namespace json {
+
+/*
+
+Read JSON lines, also called NDJSON, where each line of the text is a separate JSON document. The
+text is split into parts at line breaks, and each part is parsed on its own thread into its own
+memory object. The documents are in the same order as the lines in the text. Lines with only
+whitespace are not documents.
+
+    water::json::read_lines<> lines{8}; // 8 threads
+    lines.parse_in_place(text, text + size);
+    for(size_t i = 0; i != lines.size(); ++i)
+        if(auto nodes = lines[i])
+            use(nodes);
+        else
+            trace() << "line " << lines.line(i) + 1 << " is not valid JSON";
+
+Like read::parse_in_place this modifies the text, and the nodes point into it. The nodes exist until
+the next parse_in_place, or until the read_lines object is destroyed.
+
+The calling thread parses the first part and the other threads the rest. A part is never smaller
+than part_size_min bytes, so small texts use fewer threads. If a thread cannot be started, the
+calling thread parses that part too.
+
+*/
+
+template<typename memory_ = memory<>>
+class read_lines
+{
+public:
+    using memory_type = memory_;
+    using node_type = node<memory_type>;
+    static size_t constexpr part_size_min = 64 * 1024;
+
+private:
+    struct document {
+        node_type nodes; // empty if not valid json
+        size_t line; // line in the part
+    };
+
+    struct part {
+        memory_type memory;
+        water::vector<document> documents;
+        char
+            *begin = 0,
+            *end = 0;
+        size_t
+            lines = 0,
+            first_document = 0, // index of documents[0], set after all parts are parsed
+            first_line = 0,
+            errors = 0;
+        water::threads::join_t join {};
+        bool thread = false;
+
+        void parse() {
+            auto at = begin;
+            while(at != end) {
+                auto line_end = at;
+                while(line_end != end && *line_end != '\n')
+                    ++line_end;
+                auto u = static_cast<uchar_t*>(static_cast<void*>(at));
+                if(read_skip_space(u, u + (line_end - at)) != u + (line_end - at)) {
+                    read<memory_type> r{memory};
+                    r.parse_in_place(at, line_end);
+                    auto nodes = r.nodes();
+                    if(!nodes) {
+                        memory.undo(); // free what the failed read allocated
+                        ++errors;
+                    }
+                    documents.push_back(document{nodes, lines});
+                }
+                ++lines;
+                at = line_end;
+                if(at != end)
+                    ++at;
+            }
+        }
+    };
+
+    water::vector<part> myparts;
+    size_t
+        mysize = 0,
+        myerrors = 0;
+    unsigned mythreads;
+
+public:
+    explicit read_lines(unsigned threads = 1) :
+        mythreads{threads ? threads : 1}
+    {}
+
+    read_lines(read_lines const&) = delete;
+    read_lines& operator=(read_lines const&) = delete;
+
+    explicit operator bool() const {
+        // true if every line was valid json
+        return mysize && !myerrors;
+    }
+
+    unsigned threads() const {
+        return mythreads;
+    }
+
+    void threads(unsigned a) {
+        mythreads = a ? a : 1;
+    }
+
+    read_lines& parse_in_place(char *begin, char *end) {
+        myparts.clear();
+        mysize = myerrors = 0;
+        size_t size = static_cast<size_t>(end - begin);
+        size_t parts = size / part_size_min + 1;
+        if(parts > mythreads)
+            parts = mythreads;
+        if(!myparts.resize(parts))
+            return *this;
+
+        // split at line breaks. a part can be empty if a line is longer than a part
+        auto at = begin;
+        for(size_t i = 0; i != parts; ++i) {
+            auto e = i + 1 == parts ? end : begin + size / parts * (i + 1);
+            if(e < at)
+                e = at;
+            while(e != end && e != at && e[-1] != '\n')
+                ++e;
+            myparts[i].begin = at;
+            myparts[i].end = e;
+            at = e;
+        }
+
+        for(size_t i = 1; i < parts; ++i)
+            myparts[i].thread = water::threads::run<water::threads::member_function<part, &part::parse>>(&myparts[i], myparts[i].join);
+        myparts[0].parse();
+        for(size_t i = 1; i < parts; ++i)
+            if(!myparts[i].thread)
+                myparts[i].parse();
+            else
+                water::threads::join(myparts[i].join);
+
+        size_t lines = 0;
+        for(auto& p : myparts) {
+            p.first_document = mysize;
+            p.first_line = lines;
+            mysize += p.documents.size();
+            lines += p.lines;
+            myerrors += p.errors;
+        }
+        return *this;
+    }
+
+    size_t size() const {
+        // number of documents
+        return mysize;
+    }
+
+    size_t errors() const {
+        // number of documents that are not valid json
+        return myerrors;
+    }
+
+    node_type operator[](size_t a) {
+        // the nodes of document a, or empty nodes if it was not valid json
+        ___water_assert(a < mysize);
+        auto &p = myparts[part_of(a)];
+        return p.documents[a - p.first_document].nodes;
+    }
+
+    size_t line(size_t a) const {
+        // line number of document a, the first line is 0
+        ___water_assert(a < mysize);
+        auto &p = myparts[part_of(a)];
+        return p.first_line + p.documents[a - p.first_document].line;
+    }
+
+private:
+    size_t part_of(size_t a) const {
+        size_t p = 0;
+        while(a >= myparts[p].first_document + myparts[p].documents.size())
+            ++p;
+        return p;
+    }
+};
+
+}}
+#endif
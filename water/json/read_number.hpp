@@ -1,4 +1,4 @@
-// Copyright 2017-2021 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -143,5 +143,36 @@ bool read_number(number& to, iterator_& from, iterator_ end) {
     return true;
 }
 
+template<typename iterator_>
+bool read_number_skip(iterator_& from, iterator_ end) {
+    // check a number like read_number, without converting it
+    if(*from == '-')
+        ++from;
+    auto first_digit = from;
+    while(from != end && ('0' <= *from && *from <= '9'))
+        ++from;
+    if(from == first_digit)
+        return false;
+    if(from != first_digit + 1 && *first_digit == '0') // no leading 0
+        return false;
+    if(from != end && *from == '.') {
+        auto decimal_point = from++;
+        while(from != end && ('0' <= *from && *from <= '9'))
+            ++from;
+        if(from == decimal_point + 1)
+            return false;
+    }
+    if(from != end && (*from == 'e' || *from == 'E')) {
+        if(++from != end && (*from == '-' || *from == '+'))
+            ++from;
+        first_digit = from;
+        while(from != end && ('0' <= *from && *from <= '9'))
+            ++from;
+        if(from == first_digit)
+            return false;
+    }
+    return true;
+}
+
 }}
 #endif
@@ -0,0 +1,172 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_READ_SCAN_HPP
+#define WATER_JSON_READ_SCAN_HPP
+#include <water/json/bits.hpp>
+#include <water/simd.hpp>
+namespace water { namespace json {
+
+/*
+
+Scan functions used by json::read to jump over the parts of the text that do not need to be looked
+at one byte at a time: whitespace between values, and the parts of strings that are plain ASCII
+without escapes. The parser moves from one structural character [ ] { } , : " \ to the next.
+
+They use SSE2 or AVX2 when water/simd.hpp says it can, and a plain C++ loop otherwise. The result is
+always the same, so the parser builds the exact same nodes and finds errors at the exact same place.
+
+They never read outside begin,end.
+
+*/
+
+inline bool read_is_space(uchar_t a) {
+    // no unicode space, only these are allowed
+    return
+        a == 0x20 || // space
+        a == 0x0a || // lf
+        a == 0x0d || // cr
+        a == 0x09; // tab
+}
+
+inline bool read_is_string_plain(uchar_t a) {
+    // ascii that can be copied as it is inside a string. not " \ control characters or utf-8 sequences
+    return 0x20 <= a && a < 0x80 && a != '"' && a != '\\';
+}
+
+namespace _ {
+
+    #ifdef WATER_SIMD_SSE2
+
+    inline unsigned read_scan_space_16(uchar_t const* at) {
+        // bit set for each byte that is not space
+        __m128i v = _mm_loadu_si128(static_cast<__m128i const*>(static_cast<void const*>(at)));
+        __m128i s = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(0x20)), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x0a))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(0x0d)), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x09)))
+        );
+        return ~static_cast<unsigned>(_mm_movemask_epi8(s)) & 0xffffu;
+    }
+
+    inline unsigned read_scan_string_16(uchar_t const* at) {
+        // bit set for each byte that is " \ or < 0x20 or >= 0x80
+        // the signed compare with 0x20 finds both < 0x20 and >= 0x80
+        __m128i v = _mm_loadu_si128(static_cast<__m128i const*>(static_cast<void const*>(at)));
+        __m128i s = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+            _mm_cmplt_epi8(v, _mm_set1_epi8(0x20))
+        );
+        return static_cast<unsigned>(_mm_movemask_epi8(s));
+    }
+
+    #endif
+
+    #ifdef WATER_SIMD_AVX2
+
+    inline unsigned read_scan_space_32(uchar_t const* at) {
+        __m256i v = _mm256_loadu_si256(static_cast<__m256i const*>(static_cast<void const*>(at)));
+        __m256i s = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x20)), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x0a))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x0d)), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x09)))
+        );
+        return ~static_cast<unsigned>(_mm256_movemask_epi8(s));
+    }
+
+    inline unsigned read_scan_string_32(uchar_t const* at) {
+        __m256i v = _mm256_loadu_si256(static_cast<__m256i const*>(static_cast<void const*>(at)));
+        __m256i s = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v)
+        );
+        return static_cast<unsigned>(_mm256_movemask_epi8(s));
+    }
+
+    #endif
+
+}
+
+inline uchar_t* read_skip_space(uchar_t *begin, uchar_t *end) {
+    // return the first byte in begin,end that is not space, or end
+    // most of the time there is no space or a single space, check that before using simd
+    if(begin == end || !read_is_space(*begin) || ++begin == end || !read_is_space(*begin))
+        return begin;
+    #ifdef WATER_SIMD_AVX2
+    while(end - begin >= 32) {
+        if(unsigned m = _::read_scan_space_32(begin))
+            return begin + simd_first_bit(m);
+        begin += 32;
+    }
+    #endif
+    #ifdef WATER_SIMD_SSE2
+    while(end - begin >= 16) {
+        if(unsigned m = _::read_scan_space_16(begin))
+            return begin + simd_first_bit(m);
+        begin += 16;
+    }
+    #endif
+    while(begin != end && read_is_space(*begin))
+        ++begin;
+    return begin;
+}
+
+inline uchar_t* read_string_plain(uchar_t *begin, uchar_t *end) {
+    // return the first byte in begin,end that is not plain ascii inside a string, or end
+    #ifdef WATER_SIMD_AVX2
+    while(end - begin >= 32) {
+        if(unsigned m = _::read_scan_string_32(begin))
+            return begin + simd_first_bit(m);
+        begin += 32;
+    }
+    #endif
+    #ifdef WATER_SIMD_SSE2
+    while(end - begin >= 16) {
+        if(unsigned m = _::read_scan_string_16(begin))
+            return begin + simd_first_bit(m);
+        begin += 16;
+    }
+    #endif
+    while(begin != end && read_is_string_plain(*begin))
+        ++begin;
+    return begin;
+}
+
+inline uchar_t* read_token_end(uchar_t *begin, uchar_t *end, bool string, bool& escape) {
+    // find the end of a string, number, true, false or null that began before begin. used when
+    // parsing in parts, to know if a token is split between two parts.
+    //
+    // string
+    // - begin is after the first quote or somewhere inside the string
+    // - escape is true if the byte before begin was a \ that escapes the next byte, it is updated
+    // - returns the position after the closing quote
+    // otherwise
+    // - returns the first byte that cannot be part of a number, true, false or null
+    //
+    // returns 0 if the end was not found before end.
+    if(string) {
+        while(begin != end) {
+            if(escape)
+                escape = false;
+            else {
+                begin = read_string_plain(begin, end);
+                if(begin == end)
+                    break;
+                if(*begin == '"')
+                    return begin + 1;
+                escape = *begin == '\\';
+            }
+            ++begin;
+        }
+        return 0;
+    }
+    while(begin != end) {
+        auto a = *begin;
+        if(read_is_space(a) || a == ',' || a == ']' || a == '}' || a == ':' || a == '[' || a == '{' || a == '"')
+            return begin;
+        ++begin;
+    }
+    return 0;
+}
+
+}}
+#endif
@@ -1,10 +1,10 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_JSON_READ_STRING_HPP
 #define WATER_JSON_READ_STRING_HPP
-#include <water/json/bits.hpp>
+#include <water/json/read_scan.hpp>
 namespace water { namespace json {
 
 inline long read_hex(uchar_t *begin, uchar_t* end) {
@@ -35,7 +35,17 @@ inline uchar_t* read_string(uchar_t*& from, uchar_t* end) {
     // overwrites begin...end
     // if error from should point to where the error was, anything before that can be destroyed
     uchar_t *to = from;
-    while(from != end && 0x20 <= *from && *from != '"') {
+    while(from != end) {
+        // jump over plain ascii. until the first escape to == from and nothing needs to be copied
+        if(to == from)
+            to = from = read_string_plain(from, end);
+        else {
+            auto plain = read_string_plain(from, end);
+            while(from != plain)
+                *to++ = *from++;
+        }
+        if(from == end || *from < 0x20 || *from == '"')
+            break;
         if(*from == '\\') {
             if(++from == end)
                 return 0;
@@ -113,5 +123,64 @@ inline uchar_t* read_string(uchar_t*& from, uchar_t* end) {
     return 0;
 }
 
+inline bool read_string_skip(uchar_t*& from, uchar_t* end) {
+    // check a string like read_string, without decoding it. the text is not changed
+    // from is after the closing quote, or where the error was if this returns false
+    while(from != end) {
+        from = read_string_plain(from, end);
+        if(from == end || *from < 0x20 || *from == '"')
+            break;
+        if(*from == '\\') {
+            if(++from == end)
+                return false;
+            switch(*from) {
+                case '"':
+                case '\\':
+                case '/':
+                case 'b':
+                case 'f':
+                case 'n':
+                case 'r':
+                case 't': ++from; break;
+                case 'u': {
+                    if(++from == end)
+                        return false;
+                    auto u = read_hex(from, end);
+                    if(u < 0)
+                        return false;
+                    from += 4;
+                    if(unicode::utf16_is_1_of_2(u) && end - from >= 6 && from[0] == '\\' && from[1] == 'u') {
+                        from += 2;
+                        if(!unicode::utf16_is_2_of_2(read_hex(from, end)))
+                            return false;
+                        from += 4;
+                    }
+                    else if(!unicode::utf16_is_1_of_1(u))
+                        return false;
+                    break;
+                }
+                default: return false;
+            }
+        }
+        else {
+            ptrdiff_t n = static_cast<ptrdiff_t>(unicode::utf8_first_of(*from));
+            if(!n || n > end - from)
+                return false;
+            if(
+                (n == 2 && !unicode::utf8_verify(from[0], from[1])) ||
+                (n == 3 && !unicode::utf8_verify(from[0], from[1], from[2])) ||
+                (n == 4 && !unicode::utf8_verify(from[0], from[1], from[2], from[3]))
+            )
+                return false;
+            from += n;
+        }
+    }
+    if(from != end && *from == '"') {
+        ++from;
+        return true;
+    }
+    return false;
+}
+
 }}
 #endif
@@ -1,18 +1,32 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_JSON_TESTS_ALL_HPP
 #define WATER_JSON_TESTS_ALL_HPP
 #include <water/json/tests/create.hpp>
+#include <water/json/tests/cursor.hpp>
 #include <water/json/tests/number_conversion.hpp>
+#include <water/json/tests/object_index.hpp>
+#include <water/json/tests/read_lines.hpp>
+#include <water/json/tests/read_parts.hpp>
+#include <water/json/tests/read_scan.hpp>
 #include <water/json/tests/utf.hpp>
+#include <water/json/tests/write_scan.hpp>
+#include <water/json/tests/write_to.hpp>
 namespace water { namespace json { namespace tests {
 
 inline void all() {
     create();
+    cursor();
     number_conversion();
+    object_index();
+    read_lines();
+    read_parts();
+    read_scan();
     utf();
+    write_scan();
+    write_to();
 }
 
 }}}
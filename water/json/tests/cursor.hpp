@@ -0,0 +1,163 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_TESTS_CURSOR_HPP
+#define WATER_JSON_TESTS_CURSOR_HPP
+#include <water/json/tests/bits.hpp>
+#include <water/json/cursor.hpp>
+#include <water/vector.hpp>
+namespace water { namespace json { namespace tests {
+
+/*
+
+test json::cursor. it should find the same errors as json::read
+
+*/
+
+template<size_t size_>
+bool cursor_finish(char const (&text)[size_], unsigned enter = 0) {
+    // copy text, enter it enter levels, and finish
+    char copy[size_];
+    for(size_t i = 0; i != size_; ++i)
+        copy[i] = text[i];
+    json::cursor c(copy, copy + size_ - 1);
+    while(enter-- && c.enter());
+    bool r = c.finish();
+
+    char copy2[size_];
+    for(size_t i = 0; i != size_; ++i)
+        copy2[i] = text[i];
+    memory<> m;
+    auto read = read_to_memory(m);
+    read.parse_in_place(copy2, size_ - 1);
+    ___water_test(r == static_cast<bool>(read));
+    return r;
+}
+
+inline void cursor_values() {
+    char text[] = "{\"id\": 123, \"skip\": {\"a\": [1, 2, {\"b\": \"c\"}], \"d\": []}, \"name\": \"a\\u00e5b\", \"items\": [true, false, null, -1.5e3], \"empty\": {}, \"last\": \"x\"}";
+    json::cursor c(text, text + sizeof(text) - 1);
+    ___water_test(c && c.is_object() && c.depth() == 0);
+    ___water_test(c.enter() && c.depth() == 1);
+    ___water_test(c.name() == "id" && c.is_number() && c.number().to_int() == 123);
+    ___water_test(c.next() && c.name() == "skip" && c.is_object());
+    ___water_test(c.next() && c.name() == "name" && c.is_string());
+    ___water_test(c.string() == "a\xc3\xa5" "b");
+    ___water_test(c.string() == "a\xc3\xa5" "b"); // again
+    ___water_test(c.next() && c.name() == "items" && c.is_array());
+    ___water_test(c.enter() && c.depth() == 2 && !c.name());
+    ___water_test(c.is_boolean() && c.boolean());
+    ___water_test(c.next() && c.is_boolean() && !c.boolean());
+    ___water_test(c.next() && c.is_null());
+    ___water_test(c.next() && c.is_number() && c.number().to_double() == -1500.);
+    ___water_test(!c.next() && c && c.depth() == 1 && c.is_array());
+    ___water_test(c.next() && c.name() == "empty" && c.is_object());
+    ___water_test(!c.enter() && c && c.depth() == 1);
+    ___water_test(c.next() && c.name() == "last" && c.string() == "x");
+    ___water_test(!c.next() && c && c.depth() == 0 && c.is_object());
+    ___water_test(!c.next() && c);
+    ___water_test(c.finish());
+
+    // find and leave
+    char text2[] = "{\"a\": [[1], {\"x\": 1}], \"b\": {\"c\": {\"d\": 4, \"e\": 5}, \"f\": 6}, \"g\": 7}";
+    json::cursor c2(text2, text2 + sizeof(text2) - 1);
+    ___water_test(c2.enter() && c2.find("b") && c2.enter());
+    ___water_test(c2.find("c") && c2.enter() && c2.find("e") && c2.number().to_int() == 5);
+    ___water_test(c2.leave() && c2.depth() == 2 && c2.is_object());
+    ___water_test(!c2.find("nothing") && c2.depth() == 1 && c2.is_object() && c2);
+    ___water_test(c2.next() && c2.name() == "g");
+    ___water_test(c2.finish());
+
+    json::cursor c3(text2, text2 + sizeof(text2) - 1);
+    ___water_test(c3.enter() && c3.enter() && c3.enter());
+    ___water_test(c3.depth() == 3 && c3.finish());
+
+    // top level values
+    char text3[] = " \"string\" ";
+    json::cursor c4(text3, text3 + sizeof(text3) - 1);
+    ___water_test(c4.string() == "string" && !c4.next() && c4 && c4.finish());
+    char text4[] = "-0.5";
+    json::cursor c5(text4, text4 + sizeof(text4) - 1);
+    ___water_test(c5.number().to_double() == -0.5 && c5.finish());
+}
+
+inline void cursor_skip() {
+    // skipped values are checked but not converted, the text is not changed
+    char const original[] = "{\"a\": \"x\\ny\", \"b\": {\"c\\u00e5\": [\"\\\"\", -1.5e3, \"\\ud83d\\ude00\"]}, \"d\": \"\\t\"}";
+    char text[sizeof(original)];
+    for(size_t i = 0; i != sizeof(text); ++i)
+        text[i] = original[i];
+    json::cursor c(text, text + sizeof(text) - 1);
+    ___water_test(c.enter() && c.name() == "a" && c.next() && c.name() == "b" && c.next() && c.name() == "d");
+    size_t changed = 0;
+    for(size_t i = 0; i != sizeof(text); ++i)
+        changed += text[i] != original[i];
+    ___water_test(changed == 0);
+    ___water_test(c.string() == "\t" && c.finish());
+
+    // a string can be converted after it was skipped
+    char text2[] = "\"x\\ny\"";
+    json::cursor c2(text2, text2 + sizeof(text2) - 1);
+    ___water_test(!c2.next() && c2 && c2.string() == "x\ny" && c2.finish());
+}
+
+inline void cursor_errors() {
+    ___water_test(cursor_finish("[1, {\"a\": [true, null, \"x\\ty\"]}, []]"));
+    ___water_test(cursor_finish("[1, {\"a\": [true, null, \"x\\ty\"]}, []]", 3));
+    ___water_test(cursor_finish(" {} "));
+    ___water_test(!cursor_finish(""));
+    ___water_test(!cursor_finish("   "));
+    ___water_test(!cursor_finish("[1, 2"));
+    ___water_test(!cursor_finish("[1, 2", 1));
+    ___water_test(!cursor_finish("[1 2]"));
+    ___water_test(!cursor_finish("[1, 2,]"));
+    ___water_test(!cursor_finish("{\"a\" 1}"));
+    ___water_test(!cursor_finish("{\"a\": 1,}"));
+    ___water_test(!cursor_finish("{1: 1}"));
+    ___water_test(!cursor_finish("[1, {\"a\": [tru]}]"));
+    ___water_test(!cursor_finish("[1, {\"a\": [\"x\\qy\"]}]"));
+    ___water_test(!cursor_finish("[1, {\"a\": [01]}]"));
+    ___water_test(!cursor_finish("[1, {\"a\": [1]]}]"));
+    ___water_test(!cursor_finish("[1x]"));
+    ___water_test(!cursor_finish("1 2"));
+    ___water_test(!cursor_finish("{} {}"));
+    ___water_test(!cursor_finish("\"abc"));
+    ___water_test(!cursor_finish("[\"\\ud83d\"]"));
+    ___water_test(!cursor_finish("[\"\\u00\"]"));
+    ___water_test(!cursor_finish("[\"\xc3\"]"));
+    ___water_test(!cursor_finish("[\"a\tb\"]"));
+    ___water_test(!cursor_finish("{\"a\": {\"\\x\": 1}}", 1));
+    ___water_test(!cursor_finish("[1.]"));
+    ___water_test(!cursor_finish("[1e+]"));
+    ___water_test(!cursor_finish("[-]"));
+    ___water_test(cursor_finish("[\"\\ud83d\\ude00 \xc3\xa5\", -0.5E-7, 0]"));
+
+    char text[] = "[1, [2, x]]";
+    json::cursor c(text, text + sizeof(text) - 1);
+    ___water_test(c.enter() && c.next() && !c.next() && !c);
+    ___water_test(c.parse_error() == "x]]" && c.is_null());
+
+    // too deep
+    water::vector<char> deep;
+    for(unsigned i = 0; i != json::cursor::depth_max + 1; ++i)
+        deep.push_back('[');
+    deep.push_back('1');
+    for(unsigned i = 0; i != json::cursor::depth_max + 1; ++i)
+        deep.push_back(']');
+    json::cursor c2(deep.begin(), deep.end());
+    ___water_test(!c2.finish());
+    deep.pop_back();
+    deep.erase(deep.begin());
+    json::cursor c3(deep.begin(), deep.end());
+    ___water_test(c3.finish());
+}
+
+inline void cursor() {
+    cursor_values();
+    cursor_skip();
+    cursor_errors();
+}
+
+}}}
+#endif
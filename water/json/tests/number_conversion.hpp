@@ -1,10 +1,11 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_JSON_TESTS_NUMBER_CONVERSION_HPP
 #define WATER_JSON_TESTS_NUMBER_CONVERSION_HPP
 #include <water/json/tests/bits.hpp>
+#include <water/json/write_number.hpp>
 namespace water { namespace json { namespace tests {
 
 /*
@@ -70,9 +71,54 @@ inline void number_cast() {
         n = 3;
 }
 
+inline bool number_write_equal(number n, char const* text) {
+    char buffer[64] {};
+    size_t size = 0;
+    write_number([&buffer, &size](char c) { if(size != sizeof(buffer) - 1) buffer[size++] = c; }, n);
+    size_t i = 0;
+    while(buffer[i] && buffer[i] == text[i])
+        ++i;
+    return !buffer[i] && !text[i];
+}
+
+inline void number_shortest() {
+    // double and float use the shortest digits that convert back to exactly the same value
+    number n = 0.1;
+    ___water_test(n.integer() == 1 && n.exponent() == -1);
+    n = 0.1f;
+    ___water_test(n.integer() == 1 && n.exponent() == -1);
+    n = -1. / 3;
+    ___water_test(n.integer() == -3333333333333333 && n.exponent() == -16);
+    n = 1.f / 3;
+    ___water_test(n.integer() == 33333334 && n.exponent() == -8);
+    n = 0.1 + 0.2;
+    ___water_test(n.integer() == 30000000000000004 && n.exponent() == -17);
+    n = 1e300;
+    ___water_test(n.integer() == 1 && n.exponent() == 300);
+    n = 100.;
+    ___water_test(n.integer() == 100 && !n.exponent());
+    n = -0.;
+    ___water_test(!n.integer() && !n.exponent() && !n.imprecise());
+    ___water_test(number_write_equal(0.1 + 0.2, "3.0000000000000004e-1"));
+    ___water_test(number_write_equal(-123.456, "-123.456"));
+    ___water_test(number_write_equal(5e-324, "5e-324"));
+    ___water_test(number_write_equal(1.7976931348623157e308, "1.7976931348623157e308"));
+    ___water_test(number_write_equal(0.1f, "1e-1"));
+
+    // to_double and float are correctly rounded, so this is the same value again
+    ___water_test(static_cast<double>(number{0.1}) == 0.1 && static_cast<float>(number{0.1f}) == 0.1f);
+    ___water_test(static_cast<double>(number{-1. / 3}) == -1. / 3 && static_cast<float>(number{1.f / 3}) == 1.f / 3);
+    ___water_test(static_cast<double>(number{5e-324}) == 5e-324);
+    ___water_test(static_cast<double>(number{1.7976931348623157e308}) == 1.7976931348623157e308);
+    ___water_test(static_cast<double>(number{22250738585072011, -324}) == 2.2250738585072011e-308);
+    ___water_test(static_cast<double>(number{9007199254740993, 0}) == 9007199254740992.);
+    ___water_test(static_cast<double>(number{1, 309}) == 0); // infinity
+}
+
 inline void number_conversion() {
     
     number_cast();
+    number_shortest();
     
     // any comparation to a.integer + a.exponent is unsafe
     number n = 1.2345;
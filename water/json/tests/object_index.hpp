@@ -0,0 +1,119 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_TESTS_OBJECT_INDEX_HPP
+#define WATER_JSON_TESTS_OBJECT_INDEX_HPP
+#include <water/json/tests/bits.hpp>
+#include <water/vector.hpp>
+namespace water { namespace json { namespace tests {
+
+/*
+
+test finding nodes by name when objects have an object_index, compared to without
+
+*/
+
+inline string<char const*> object_index_name(char (&to)[8], unsigned a) {
+    // a0000 b0001 ... and every 10th is "dup"
+    if(a % 10 == 9) {
+        to[0] = 'd';
+        to[1] = 'u';
+        to[2] = 'p';
+        return {to, 3};
+    }
+    char *t = to;
+    *t++ = static_cast<char>('a' + a % 26);
+    unsigned d = 1000;
+    while(d) {
+        *t++ = static_cast<char>('0' + (a / d) % 10);
+        d /= 10;
+    }
+    return {to, t};
+}
+
+inline void object_index_compare(node<> indexed, node<> plain, unsigned size) {
+    // indexed and plain should be the same
+    char name[8];
+    ___water_test(indexed.size() == plain.size());
+    for(unsigned i = 0; i != size; ++i) {
+        auto n = object_index_name(name, i);
+        auto a = indexed[n];
+        auto b = plain[n];
+        ___water_test(a && b && a.at_position() == b.at_position());
+        // from a position
+        if(i) {
+            a = indexed[i - 1].find(n);
+            b = plain[i - 1].find(n);
+            ___water_test(static_cast<bool>(a) == static_cast<bool>(b) && a.at_position() == b.at_position());
+        }
+    }
+    ___water_test(!indexed["not there"] && !plain["not there"]);
+    ___water_test(indexed["dup"].at_position() == 9);
+    ___water_test(indexed[10].find("dup").at_position() == 19);
+}
+
+inline void object_index() {
+    unsigned const size = 1000;
+    water::vector<char> text;
+    text.push_back('{');
+    char name[8];
+    for(unsigned i = 0; i != size; ++i) {
+        if(i) text.push_back(',');
+        auto n = object_index_name(name, i);
+        text.push_back('"');
+        text.insert(text.end(), n.begin(), n.end());
+        text.insert(text.end(), "\":1", "\":1" + 3);
+    }
+    text.push_back('}');
+
+    memory<> m1, m2;
+    m1.index_objects(16);
+    auto r1 = read_to_memory(m1);
+    auto r2 = read_to_memory(m2);
+    r1(text.begin(), text.end());
+    r2(text.begin(), text.end());
+    ___water_test(r1 && r2);
+    auto indexed = r1.nodes();
+    auto plain = r2.nodes();
+    object_index_compare(indexed, plain, size);
+    object_index_compare(node<>{indexed}, plain, size);
+
+    // change a name
+    indexed[3].name("changed");
+    plain[3].name("changed");
+    ___water_test(indexed["changed"].at_position() == 3);
+    auto n3 = object_index_name(name, 3);
+    ___water_test(!indexed[n3]);
+    indexed[3].name(n3);
+    plain[3].name(n3);
+    object_index_compare(indexed, plain, size);
+
+    // remove and add
+    auto removed = indexed.remove(500);
+    ___water_test(!indexed[removed.name()]);
+    indexed.insert(500, removed);
+    object_index_compare(indexed, plain, size);
+    indexed.push_back().name("last");
+    ___water_test(indexed["last"].at_position() == size);
+    indexed.pop_back();
+    ___water_test(!indexed["last"]);
+    object_index_compare(indexed, plain, size);
+
+    // created objects get an index the first time something is found
+    auto created = m1.create().object(0);
+    for(unsigned i = 0; i != size; ++i) {
+        created.push_back().name(object_index_name(name, i)).number(i);
+    }
+    object_index_compare(created, plain, size);
+
+    // object that is too small
+    m1.index_objects(size + 1);
+    auto small = m1.create().object(0);
+    small.push_back().name("a");
+    small.push_back().name("b");
+    ___water_test(small["b"].at_position() == 1);
+}
+
+}}}
+#endif
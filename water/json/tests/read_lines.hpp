@@ -0,0 +1,82 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_TESTS_READ_LINES_HPP
+#define WATER_JSON_TESTS_READ_LINES_HPP
+#include <water/json/tests/bits.hpp>
+#include <water/json/read_lines.hpp>
+#include <water/vector.hpp>
+namespace water { namespace json { namespace tests {
+
+/*
+
+test read_lines with enough text for several threads. every 100th line is not valid json, and
+every 37th line is empty
+
+*/
+
+inline void read_lines_add(water::vector<char>& to, char const* text) {
+    while(*text)
+        to.push_back(*text++);
+}
+
+inline void read_lines_test(unsigned threads) {
+    unsigned const lines = 20000;
+    water::vector<char> text;
+    for(unsigned i = 0; i != lines; ++i) {
+        if(i % 37 == 36)
+            read_lines_add(text, " \t");
+        else if(i % 100 == 99)
+            read_lines_add(text, "{\"line\": [1, 2,}");
+        else {
+            read_lines_add(text, "{\"line\": 1"); // 1 so there is no leading 0
+            unsigned d = 10000;
+            while(d) {
+                text.push_back(static_cast<char>('0' + (i / d) % 10));
+                d /= 10;
+            }
+            read_lines_add(text, ", \"text\": \"abcdefghijklmnopqrstuvwxyz\", \"array\": [1, 2, 3]}");
+        }
+        read_lines_add(text, i % 2 ? "\r\n" : "\n");
+    }
+
+    json::read_lines<> read{threads};
+    read.parse_in_place(text.begin(), text.end());
+    ___water_test(!read);
+    size_t documents = 0, errors = 0;
+    for(unsigned i = 0; i != lines; ++i) {
+        if(i % 37 == 36)
+            continue;
+        if(documents == read.size()) {
+            ___water_test(false);
+            return;
+        }
+        ___water_test(read.line(documents) == i);
+        auto nodes = read[documents];
+        if(i % 100 == 99) {
+            ___water_test(!nodes);
+            ++errors;
+        }
+        else
+            ___water_test(nodes["line"].number().to_int() == 100000 + static_cast<int64_t>(i) && nodes["array"].size() == 3);
+        ++documents;
+    }
+    ___water_test(read.size() == documents && read.errors() == errors);
+}
+
+inline void read_lines() {
+    read_lines_test(1);
+    read_lines_test(4);
+    read_lines_test(100);
+
+    char text[] = "[1]\n\n{}";
+    json::read_lines<> read{4};
+    read.parse_in_place(text, text + sizeof(text) - 1);
+    ___water_test(read && read.size() == 2 && read.line(1) == 2 && read[1].is_object());
+    read.parse_in_place(text, text);
+    ___water_test(!read && !read.size());
+}
+
+}}}
+#endif
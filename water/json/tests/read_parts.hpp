@@ -0,0 +1,159 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_TESTS_READ_PARTS_HPP
+#define WATER_JSON_TESTS_READ_PARTS_HPP
+#include <water/json/tests/bits.hpp>
+#include <water/vector.hpp>
+namespace water { namespace json { namespace tests {
+
+/*
+
+test read::parse_in_place_part by splitting json text at every position into 2 parts, and into
+parts of 1 byte. the nodes should be the same as when parsing everything at once, and the error
+should be where it is when parsing everything at once. parse_error() ends where the part ends, so
+it is the beginning of the error text from parsing everything at once.
+
+*/
+
+inline water::vector<char> read_parts_write(node<> a) {
+    water::vector<char> r;
+    write([&r](char const* b, char const* e) { r.insert(r.end(), b, e); }, a);
+    return r;
+}
+
+inline char* read_parts_copy(memory<>& m, char const* from, size_t size) {
+    auto r = static_cast<char*>(m.allocate(size ? size : 1, 1));
+    for(size_t i = 0; i != size; ++i)
+        r[i] = from[i];
+    return r;
+}
+
+inline bool read_parts_error(string<char const*> part, string<char const*> whole) {
+    // parse_error() is empty for a string that does not end, when parsing everything at once
+    if(!whole.size())
+        return true;
+    if(part.size() > whole.size() || !part.size())
+        return false;
+    for(size_t i = 0; i != part.size(); ++i)
+        if(part.begin()[i] != whole.begin()[i])
+            return false;
+    return true;
+}
+
+template<size_t size_>
+void read_parts_one(char const (&text)[size_], bool valid) {
+    size_t const size = size_ - 1;
+    memory<> m, whole_memory; // the error text is in whole_memory
+    auto whole = read_to_memory(whole_memory);
+    whole(text, size);
+    ___water_test(static_cast<bool>(whole) == valid);
+    auto expect = read_parts_write(whole.nodes());
+    auto error = whole.parse_error();
+
+    // 2 parts, plus an empty last part
+    for(size_t split = 0; split <= size; ++split) {
+        auto read = read_to_memory(m);
+        auto p1 = read_parts_copy(m, text, split);
+        auto p2 = read_parts_copy(m, text + split, size - split);
+        read.parse_in_place_part(p1, p1 + split, true);
+        read.parse_in_place_part(p2, p2 + size - split, true);
+        read.parse_in_place_part(p2, p2, false);
+        ___water_test(static_cast<bool>(read) == valid);
+        ___water_test(read_parts_error(read.parse_error(), error));
+        if(valid)
+            ___water_test(read_parts_write(read.nodes()) == expect);
+    }
+
+    // 2 parts, the second is the last
+    for(size_t split = 0; split <= size; ++split) {
+        auto read = read_to_memory(m);
+        auto p1 = read_parts_copy(m, text, split);
+        auto p2 = read_parts_copy(m, text + split, size - split);
+        read.parse_in_place_part(p1, p1 + split, true);
+        read.parse_in_place_part(p2, p2 + size - split, false);
+        ___water_test(static_cast<bool>(read) == valid);
+        ___water_test(read_parts_error(read.parse_error(), error));
+        if(valid)
+            ___water_test(read_parts_write(read.nodes()) == expect);
+    }
+
+    // 1 byte at a time
+    auto read = read_to_memory(m);
+    for(size_t i = 0; i != size; ++i) {
+        auto p = read_parts_copy(m, text + i, 1);
+        read.parse_in_place_part(p, p + 1, i + 1 != size);
+    }
+    if(!size)
+        read.parse_in_place_part(0, 0, false);
+    ___water_test(static_cast<bool>(read) == valid);
+    ___water_test(read_parts_error(read.parse_error(), error));
+    if(valid)
+        ___water_test(read_parts_write(read.nodes()) == expect);
+}
+
+inline void read_parts_nodes() {
+    // split inside the escapes, the number and the names, and continue with a copy of the read
+    char const text[] = "{\"s\":\"a\\u00e5\\\"b\",\"n\":-12.5e1,\"e\":\"\\\\\"}";
+    size_t const size = sizeof(text) - 1;
+    memory<> m;
+    for(size_t split = 0; split <= size; ++split) {
+        auto read = read_to_memory(m);
+        auto p1 = read_parts_copy(m, text, split);
+        auto p2 = read_parts_copy(m, text + split, size - split);
+        read.parse_in_place_part(p1, p1 + split, true);
+        auto copy = read; // copies the part of a token in the first part
+        copy.parse_in_place_part(p2, p2 + size - split, false);
+        ___water_test(copy);
+        auto n = copy.nodes();
+        ___water_test(n.size() == 3);
+        ___water_test(n[0].name() == "s" && n[0].string() == "a\xc3\xa5\"b");
+        ___water_test(n[1].name() == "n" && n[1].number().integer() == -125 && n[1].number().exponent() == 0);
+        ___water_test(n[2].name() == "e" && n[2].string() == "\\");
+    }
+}
+
+inline void read_parts_carry_memory() {
+    // a string of 1000 characters 1 byte at a time. only the string and the node should be in
+    // the memory object, not each size the copy of the string had while it grew
+    size_t const size = 1002;
+    char text[size];
+    text[0] = text[size - 1] = '"';
+    for(size_t i = 1; i != size - 1; ++i)
+        text[i] = static_cast<char>('a' + i % 26);
+    memory<> m, parts;
+    auto read = read_to_memory(m);
+    for(size_t i = 0; i != size; ++i) {
+        auto p = read_parts_copy(parts, text + i, 1);
+        read.parse_in_place_part(p, p + 1, i + 1 != size);
+    }
+    ___water_test(read && read.nodes().string().size() == size - 2);
+    ___water_test(m.allocated_now() < size + sizeof(memory_node) * 2);
+}
+
+inline void read_parts() {
+    read_parts_one("{\"name\":\"value\",\"array\":[1,-2.5e-3,true,false,null,[],{}],\"escape\":\"a\\\"b\\\\\\\\c\\u00e5\\ud83d\\udc09\",\"\xc3\xa5\":{\"x\":{\"y\":[[[\"z\"]]]}}}", true);
+    read_parts_one("  [ 1 , 2 , \"three\" , { \"four\" : 4 } ]  ", true);
+    read_parts_one("123456789", true);
+    read_parts_one("\"string\"", true);
+    read_parts_one("true", true);
+    read_parts_one("null", true);
+    read_parts_one("[\"\\\\\",\"\\\\\\\"\"]", true);
+    read_parts_one("", false);
+    read_parts_one("   ", false);
+    read_parts_one("[1,2", false);
+    read_parts_one("{\"a\" 1}", false);
+    read_parts_one("[1 2]", false);
+    read_parts_one("1 2", false);
+    read_parts_one("[tru]", false);
+    read_parts_one("\"abc", false);
+    read_parts_one("[\"a\\x\"]", false);
+    read_parts_one("[-12.5e]", false);
+    read_parts_one("{\"a\\u00\":1}", false);
+    read_parts_nodes();
+    read_parts_carry_memory();
+}
+
+}}}
+#endif
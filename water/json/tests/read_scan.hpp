@@ -0,0 +1,103 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_TESTS_READ_SCAN_HPP
+#define WATER_JSON_TESTS_READ_SCAN_HPP
+#include <water/json/tests/bits.hpp>
+namespace water { namespace json { namespace tests {
+
+/*
+
+test read_skip_space, read_string_plain and read_string against plain loops, with the interesting
+byte at every position of buffers that are long enough to use the simd code
+
+*/
+
+size_t constexpr read_scan_size = 100;
+
+inline void read_scan_space() {
+    uchar_t const stop[] = {'{', 0, 0x7f, 0x80, 0xff, 0x0b, 0x0c, '"'};
+    uchar_t buffer[read_scan_size];
+    for(size_t size = 0; size != read_scan_size; ++size)
+        for(size_t at = 0; at <= size; ++at)
+            for(auto s : stop) {
+                for(size_t i = 0; i != size; ++i)
+                    buffer[i] = static_cast<uchar_t>(" \n\r\t"[(i + at) % 4]);
+                if(at != size)
+                    buffer[at] = s;
+                ___water_test(read_skip_space(buffer, buffer + size) == buffer + at);
+            }
+}
+
+inline void read_scan_string() {
+    uchar_t const stop[] = {'"', '\\', 0, 0x1f, 0x80, 0xc3, 0xff};
+    uchar_t buffer[read_scan_size];
+    for(size_t size = 0; size != read_scan_size; ++size)
+        for(size_t at = 0; at <= size; ++at)
+            for(auto s : stop) {
+                for(size_t i = 0; i != size; ++i)
+                    buffer[i] = static_cast<uchar_t>(0x20 + (i * 7) % 0x5f);
+                for(size_t i = 0; i != size; ++i)
+                    if(buffer[i] == '"' || buffer[i] == '\\')
+                        buffer[i] = 'x';
+                if(at != size)
+                    buffer[at] = s;
+                ___water_test(read_string_plain(buffer, buffer + size) == buffer + at);
+            }
+}
+
+inline void read_scan_read_string() {
+    // escapes after long plain parts means read_string has to move the plain parts
+    char const text[] =
+        "0123456789abcdefghijklmnopqrstuvwxyz\\n0123456789abcdefghijklmnopqrstuvwxyz\\u00e5"
+        "0123456789abcdefghijklmnopqrstuvwxyz\xc3\xa5" "0123456789abcdefghijklmnopqrstuvwxyz\\\"\"";
+    char const result[] =
+        "0123456789abcdefghijklmnopqrstuvwxyz\n0123456789abcdefghijklmnopqrstuvwxyz\xc3\xa5"
+        "0123456789abcdefghijklmnopqrstuvwxyz\xc3\xa5" "0123456789abcdefghijklmnopqrstuvwxyz\"";
+    uchar_t buffer[sizeof(text)];
+    for(size_t i = 0; i != sizeof(text); ++i)
+        buffer[i] = static_cast<uchar_t>(text[i]);
+    uchar_t *from = buffer;
+    auto end = read_string(from, buffer + sizeof(text) - 1);
+    ___water_test(end);
+    ___water_test(from == buffer + sizeof(text) - 1);
+    ___water_test(string<uchar_t const*>(buffer, end) == result);
+}
+
+inline void read_scan_parse() {
+    memory<> m;
+
+    // same nodes with lots of space
+    char const
+        plain[] = "{\"a\":[1,2,3],\"bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb\":\"cccccccccccccccccccccccccccccccccccccccccccccccccc\"}",
+        spaced[] = "  \r\n\t {  \"a\"   :\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n[1 ,2\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t,3],\"bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb\"                                              :\"cccccccccccccccccccccccccccccccccccccccccccccccccc\"    }                                                ";
+    auto r1 = read_to_memory(m);
+    r1(plain, sizeof(plain) - 1);
+    auto r2 = read_to_memory(m);
+    r2(spaced, sizeof(spaced) - 1);
+    ___water_test(r1 && r2);
+    auto n1 = r1.nodes();
+    auto n2 = r2.nodes();
+    ___water_test(n1.size() == 2 && n2.size() == 2);
+    ___water_test(n1["a"].size() == 3 && n2["a"].size() == 3);
+    ___water_test(n2["a"][2].number().to_int() == 3 && n1["a"][2].number().to_int() == 3);
+    ___water_test(n2["bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"].string() == "cccccccccccccccccccccccccccccccccccccccccccccccccc");
+
+    // error position is the control character inside the long string
+    char const error[] = "[\"0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz\t\"]";
+    auto r3 = read_to_memory(m);
+    r3(error, sizeof(error) - 1);
+    ___water_test(!r3);
+    ___water_test(r3.parse_error().size() == 3 && *r3.parse_error().begin() == '\t');
+}
+
+inline void read_scan() {
+    read_scan_space();
+    read_scan_string();
+    read_scan_read_string();
+    read_scan_parse();
+}
+
+}}}
+#endif
@@ -0,0 +1,149 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_TESTS_WRITE_SCAN_HPP
+#define WATER_JSON_TESTS_WRITE_SCAN_HPP
+#include <water/json/tests/bits.hpp>
+#include <water/vector.hpp>
+namespace water { namespace json { namespace tests {
+
+/*
+
+test write_string against the same thing one codepoint at a time, like it was before
+write_string_plain. with escape::minimal and escape::all, and each thing that must be escaped at
+every position of strings that are long enough to use the simd code
+
+*/
+
+template<typename to_>
+void write_scan_reference(to_& to, uchar_t const* begin, uchar_t const* end, json::escape escape) {
+    // like write_string, an error stops it without writing what was not written before
+    auto part = begin;
+    auto write_part = [&to, &part](uchar_t const* e) {
+        if(part != e)
+            to(static_cast<char const*>(static_cast<void const*>(part)), static_cast<char const*>(static_cast<void const*>(e)));
+    };
+    char32_t last = 0;
+    while(begin != end) {
+        char32_t u = 0;
+        unsigned n = unicode::utf8_decode_and_move(u, begin, end);
+        if(!n) return;
+        bool do_escape =
+            u < 0x20 || u == '"' || u == '\\' || u == 0x2028 || u == 0x2029 || (last == '<' && u == '/') ||
+            (escape == json::escape::all && (u >= 0x80 || u == '/'));
+        last = do_escape ? 0 : u;
+        if(!do_escape)
+            continue;
+        write_part(begin - n);
+        part = begin;
+        if(u == '"' || u == '\\' || u == '/' || u == '\b' || u == '\f' || u == '\n' || u == '\r' || u == '\t') {
+            char const c[] = {'\\', static_cast<char>(
+                u == '\b' ? 'b' : u == '\f' ? 'f' : u == '\n' ? 'n' : u == '\r' ? 'r' : u == '\t' ? 't' : static_cast<char>(u)
+            )};
+            to(c + 0, c + 2);
+        }
+        else {
+            char16_t u0 = static_cast<char16_t>(u), u1 = 0;
+            if(u > 0xffff)
+                unicode::utf16_pack(u0, u1, u);
+            write_hex(to, u0);
+            if(u1)
+                write_hex(to, u1);
+        }
+    }
+    write_part(end);
+}
+
+inline void write_scan_test(uchar_t const* begin, uchar_t const* end) {
+    vector<char> a, b;
+    auto to_a = [&a](char const* f, char const* e) { a.insert(a.end(), f, e); };
+    auto to_b = [&b](char const* f, char const* e) { b.insert(b.end(), f, e); };
+    for(auto escape : {json::escape::minimal, json::escape::all}) {
+        a.clear();
+        b.clear();
+        write_string(to_a, begin, end, escape);
+        write_scan_reference(to_b, begin, end, escape);
+        ___water_test(a.size() == b.size());
+        bool equal = a.size() == b.size();
+        for(size_t i = 0; equal && i != a.size(); ++i)
+            equal = a[i] == b[i];
+        ___water_test(equal);
+    }
+}
+
+inline void write_scan() {
+    uchar_t const stop[][5] = {
+        {1, '"'},
+        {1, '\\'},
+        {1, '\n'},
+        {1, 0},
+        {1, 0x1f},
+        {1, '/'},
+        {2, '<', '/'},
+        {1, '<'},
+        {1, 0x7f},
+        {2, 0xc3, 0xa5},
+        {3, 0xe2, 0x80, 0xa8},
+        {3, 0xe2, 0x80, 0xa9},
+        {3, 0xe2, 0x80, 0x94},
+        {3, 0xe6, 0x97, 0xa5},
+        {4, 0xf0, 0x9f, 0x98, 0x80},
+        #ifndef WATER_DEBUG
+        // write_string asserts on this
+        {1, 0xff},
+        {1, 0x80},
+        {2, 0xe2, 0x80},
+        #endif
+    };
+    // plain ascii, and text with utf-8 that can be verified and jumped over
+    uchar_t const fill[][4] = {
+        {1, 'a'},
+        {2, 0xc3, 0xa5}
+    };
+    vector<uchar_t> text;
+    for(auto& f : fill)
+        for(size_t size = 0; size != 100; ++size)
+            for(auto& s : stop)
+                for(size_t at = 0; at <= size; ++at) {
+                    text.clear();
+                    while(text.size() < at)
+                        text.insert(text.end(), f + 1, f + 1 + f[0]);
+                    text.insert(text.end(), s + 1, s + 1 + s[0]);
+                    while(text.size() < size)
+                        text.insert(text.end(), f + 1, f + 1 + f[0]);
+                    write_scan_test(text.begin(), text.end());
+                }
+    // < at the end of a block, / at the start of the next
+    for(size_t at = 0; at != 80; ++at) {
+        text.clear();
+        text.resize(100, 'a');
+        text[at] = '<';
+        text[at + 1] = '/';
+        write_scan_test(text.begin(), text.end());
+        text[at + 1] = 'a';
+        text[at + 2] = '/';
+        write_scan_test(text.begin(), text.end());
+    }
+    // random
+    unsigned random = 1;
+    for(unsigned repeat = 0; repeat != 2000; ++repeat) {
+        text.clear();
+        random = random * 1103515245u + 12345u;
+        unsigned size = (random >> 16) % 200;
+        while(text.size() < size) {
+            random = random * 1103515245u + 12345u;
+            unsigned r = random >> 16;
+            if(r % 8)
+                text.push_back(static_cast<uchar_t>('a' + r % 26));
+            else {
+                auto& s = stop[r % (sizeof(stop) / sizeof(stop[0]))];
+                text.insert(text.end(), s + 1, s + 1 + s[0]);
+            }
+        }
+        write_scan_test(text.begin(), text.end());
+    }
+}
+
+}}}
+#endif
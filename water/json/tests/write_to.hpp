@@ -0,0 +1,100 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_TESTS_WRITE_TO_HPP
+#define WATER_JSON_TESTS_WRITE_TO_HPP
+#include <water/json/tests/bits.hpp>
+#include <water/vector.hpp>
+namespace water { namespace json { namespace tests {
+
+/*
+
+test write_to_buffer and write_to_vector, they should write the same as write
+
+*/
+
+inline bool write_to_equal(char const* a, char const* b, size_t size) {
+    while(size--)
+        if(*a++ != *b++)
+            return false;
+    return true;
+}
+
+inline void write_to_test(node<> nodes) {
+    for(auto escape : {json::escape::minimal, json::escape::all}) {
+        vector<char> expect;
+        size_t size = write([&expect](char const* b, char const* e) { expect.insert(expect.end(), b, e); }, nodes, escape);
+        ___water_test(size == expect.size());
+
+        // appends
+        vector<char> v;
+        v.push_back('x');
+        ___water_test(write_to_vector(v, nodes, escape) == size);
+        ___water_test(v.size() == size + 1 && v[0] == 'x' && write_to_equal(v.begin() + 1, expect.begin(), size));
+        ___water_test(write_to_vector(v, nodes, escape) == size);
+        ___water_test(v.size() == size * 2 + 1 && write_to_equal(v.begin() + 1 + size, expect.begin(), size));
+        v.clear();
+        ___water_test(write_to_vector(v, nodes, escape) == size);
+        ___water_test(v.size() == size && write_to_equal(v.begin(), expect.begin(), size));
+
+        // buffers that are too small, exact and too large. it must not write after buffer_size
+        vector<char> buffer(size + 3);
+        for(size_t s = 0; s <= size + 2; ++s) {
+            for(auto& b : buffer)
+                b = '#';
+            ___water_test(write_to_buffer(buffer.begin(), s, nodes, escape) == size);
+            size_t written = s < size ? s : size;
+            ___water_test(write_to_equal(buffer.begin(), expect.begin(), written));
+            ___water_test(buffer[written] == '#');
+        }
+    }
+}
+
+inline void write_to() {
+    memory<> m;
+
+    char const text[] =
+        "{\"plain\":\"text\",\"escape\\n\":\"a \\\"quote\\\" </script>\",\"\\u00e5\":\"\\u2028 \\ud83d\\ude00 \xc3\xa5\","
+        "\"array\":[1,-2.5e-7,true,false,null,\"\",{},[]],\"nested\":{\"a\":{\"b\":[\"c\",\"/\"]}}}";
+    auto r = read_to_memory(m)(text, sizeof(text) - 1);
+    ___water_test(r);
+    write_to_test(r.nodes());
+
+    // an array of 100 that repeats a plain string, a string with \t and an object with a U+2028 name,
+    // so the buffers of every size above end inside plain text, inside escapes and between values
+    auto root = m.create();
+    root.array(100);
+    for(unsigned i = 0; i != 100; ++i) {
+        if(i % 3 == 0)
+            root.push_back().string("plain");
+        else if(i % 3 == 1)
+            root.push_back().string("tab\there");
+        else
+            root.push_back().object(1).push_back().name("\xe2\x80\xa8").string("a/b");
+    }
+    write_to_test(root);
+
+    // strings longer than the buffer write_to_vector uses
+    vector<char> long_string(write_buffer_size * 3, 'a');
+    long_string[write_buffer_size] = '"';
+    root = m.create();
+    root.array(2).push_back().string(long_string.begin(), long_string.size());
+    root.push_back().string(long_string.begin(), 10);
+    write_to_test(root);
+
+    #ifndef WATER_DEBUG
+    // invalid utf-8, write_string stops at it. what it writes is the same size as the string
+    root = m.create();
+    root.array(1).push_back().string("\"\"\xe2\x80");
+    write_to_test(root);
+    #endif
+
+    root = m.create();
+    root.null();
+    write_to_test(root);
+    write_to_test(node<>{});
+}
+
+}}}
+#endif
@@ -0,0 +1,138 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_WRITE_SCAN_HPP
+#define WATER_JSON_WRITE_SCAN_HPP
+#include <water/json/bits.hpp>
+#include <water/simd.hpp>
+namespace water { namespace json {
+
+/*
+
+Scan function used by write_string to jump over the parts of a string that are written as they are.
+It stops at everything write_string has to look at one codepoint at a time:
+
+- " \ and control characters
+- / after <
+- utf-8 lead byte 0xe2, it can be 0x2028 or 0x2029 that is always escaped
+- everything that is not ascii, if escape_all is true or the utf-8 has not been verified yet
+- / if escape_all is true
+
+It uses SSE2 or AVX2 when water/simd.hpp says it can, and a plain C++ loop otherwise. The result is
+always the same.
+
+*/
+
+inline bool write_string_stop(uchar_t a, bool escape_all, bool verified, bool after_less_than) {
+    // true if write_string has to look at a
+    return
+        a < 0x20 || a == '"' || a == '\\' ||
+        (a >= 0x80 && (escape_all || !verified || a == 0xe2)) ||
+        (a == '/' && (escape_all || after_less_than));
+}
+
+namespace _ {
+
+    // each scan function returns a bit set for each byte where write_string_stop is true.
+    // less_than is true if the byte before at is <, it is updated to the last byte of this block
+
+    #ifdef WATER_SIMD_SSE2
+
+    inline unsigned write_scan_16(uchar_t const* at, bool escape_all, bool verified, bool& less_than) {
+        __m128i v = _mm_loadu_si128(static_cast<__m128i const*>(static_cast<void const*>(at)));
+        unsigned
+            high = static_cast<unsigned>(_mm_movemask_epi8(v)),
+            // the signed compare with 0x20 finds both < 0x20 and >= 0x80
+            control = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(v, _mm_set1_epi8(0x20)))) & ~high,
+            quote = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))))),
+            slash = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('/')))),
+            r = control | quote;
+        if(escape_all || !verified)
+            r |= high;
+        else if(high)
+            r |= static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(0xe2)))));
+        if(escape_all)
+            r |= slash;
+        else {
+            unsigned lt = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('<'))));
+            r |= slash & ((lt << 1) | (less_than ? 1u : 0u));
+            less_than = (lt >> 15) != 0;
+        }
+        return r;
+    }
+
+    #endif
+
+    #ifdef WATER_SIMD_AVX2
+
+    inline unsigned write_scan_32(uchar_t const* at, bool escape_all, bool verified, bool& less_than) {
+        __m256i v = _mm256_loadu_si256(static_cast<__m256i const*>(static_cast<void const*>(at)));
+        unsigned
+            high = static_cast<unsigned>(_mm256_movemask_epi8(v)),
+            control = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v))) & ~high,
+            quote = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))))),
+            slash = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')))),
+            r = control | quote;
+        if(escape_all || !verified)
+            r |= high;
+        else if(high)
+            r |= static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(0xe2)))));
+        if(escape_all)
+            r |= slash;
+        else {
+            unsigned lt = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('<'))));
+            r |= slash & ((lt << 1) | (less_than ? 1u : 0u));
+            less_than = (lt >> 31) != 0;
+        }
+        return r;
+    }
+
+    #endif
+
+    inline uchar_t const* write_scan(uchar_t const* begin, uchar_t const* end, bool escape_all, bool verified, bool less_than) {
+        #ifdef WATER_SIMD_AVX2
+        while(end - begin >= 32) {
+            if(unsigned m = write_scan_32(begin, escape_all, verified, less_than))
+                return begin + simd_first_bit(m);
+            begin += 32;
+        }
+        #endif
+        #ifdef WATER_SIMD_SSE2
+        while(end - begin >= 16) {
+            if(unsigned m = write_scan_16(begin, escape_all, verified, less_than))
+                return begin + simd_first_bit(m);
+            begin += 16;
+        }
+        #endif
+        while(begin != end && !write_string_stop(*begin, escape_all, verified, less_than)) {
+            less_than = *begin == '<';
+            ++begin;
+        }
+        return begin;
+    }
+
+}
+
+inline uchar_t const* write_string_plain(uchar_t const* begin, uchar_t const* end, uchar_t const* verified_end, bool escape_all, bool after_less_than) {
+    // return the first byte in begin,end where write_string_stop is true, or end
+    //
+    // verified_end is where the valid utf-8 ends, it must be between two codepoints. before it only
+    // the 0xe2 lead byte is a stop if escape_all is false
+    //
+    // after_less_than is true if the codepoint before begin is <
+    if(begin != end && !write_string_stop(*begin, escape_all, begin < verified_end, after_less_than)) {
+        if(begin < verified_end) {
+            auto r = _::write_scan(begin, verified_end, escape_all, true, after_less_than);
+            if(r != verified_end)
+                return r;
+            after_less_than = r[-1] == '<';
+            begin = r;
+        }
+        begin = _::write_scan(begin, end, escape_all, false, after_less_than);
+    }
+    return begin;
+}
+
+}}
+#endif
@@ -1,10 +1,11 @@
-// Copyright 2017-2022 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_JSON_WRITE_STRING_HPP
 #define WATER_JSON_WRITE_STRING_HPP
 #include <water/json/node.hpp>
+#include <water/json/write_scan.hpp>
 namespace water { namespace json {
 
 enum class escape {
@@ -30,9 +31,28 @@ void write_hex(to_& to, char16_t u) {
 template<typename to_>
 void write_string(to_ to, uchar_t const* begin, uchar_t const* end, json::escape escape) {
     // does not write the surrounding quotes
+    //
+    // write_string_plain jumps over the parts that are written as they are, the rest is looked at
+    // one codepoint at a time. with escape::minimal utf-8 that is verified first is also jumped over
     auto part = begin;
+    auto verified = begin;
     char32_t last = 0;
+    #ifdef WATER_SIMD_SSE2
+    if(escape == json::escape::minimal) {
+        size_t utf16 = 0, utf32 = 0;
+        unicode::_::utf8_bulk_verify(verified, end, true, utf16, utf32);
+    }
+    #endif
     while(begin != end) {
+        if(*begin < 0x80 || begin < verified) {
+            auto plain = write_string_plain(begin, end, verified, escape == json::escape::all, last == '<');
+            if(plain != begin) {
+                last = plain[-1];
+                begin = plain;
+                if(begin == end)
+                    break;
+            }
+        }
         char32_t u = 0;
         unsigned n = unicode::utf8_decode_and_move(u, begin, end);
         ___water_assert(n && "bad utf8");
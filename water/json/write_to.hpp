@@ -0,0 +1,162 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_JSON_WRITE_TO_HPP
+#define WATER_JSON_WRITE_TO_HPP
+#include <water/json/write.hpp>
+#include <water/vector.hpp>
+#ifdef WATER_NO_CHEADERS
+    #include <string.h>
+#else
+    #include <cstring>
+    namespace water { namespace json { using std::memcpy; }}
+#endif
+namespace water { namespace json {
+
+/*
+
+Write JSON text straight to memory, without the buffer json::write uses:
+
+    char buffer[1024];
+    size_t size = write_to_buffer(buffer, sizeof(buffer), nodes);
+    if(size > sizeof(buffer))
+        trace() << "did not fit, it needs " << size;
+
+    water::vector<char> text;
+    write_to_vector(text, nodes); // appends to text
+
+write_to_vector writes to a buffer and inserts it at the end of the vector, like json::write without
+the function call and without keeping utf-8 sequences in one piece. It does not use write_size first,
+going over the nodes a second time is about as slow as writing them.
+
+*/
+
+namespace _ {
+
+    class write_to_buffer_of_size
+    {
+        char
+            *my,
+            *myend;
+        size_t mysize = 0;
+
+    public:
+        write_to_buffer_of_size(char *begin, char *end) :
+            my{begin},
+            myend{end}
+        {}
+
+        void operator()(char a) {
+            if(my != myend)
+                *my++ = a;
+            ++mysize;
+        }
+
+        void operator()(char const* begin, char const* end) {
+            size_t
+                s = static_cast<size_t>(end - begin),
+                fit = static_cast<size_t>(myend - my);
+            if(fit > s)
+                fit = s;
+            if(fit) {
+                memcpy(my, begin, fit);
+                my += fit;
+            }
+            mysize += s;
+        }
+
+        size_t size() const {
+            return mysize;
+        }
+    };
+
+    template<typename vector_>
+    class write_to_vector_of
+    {
+        // vector resize would set each new byte to 0 before it is written, it is faster to write to
+        // a buffer and insert that at the end of the vector when it is full
+        vector_ *myvector;
+        size_t mysize;
+        char
+            *my,
+            mybuffer[write_buffer_size];
+        bool myfail = false;
+
+    public:
+        write_to_vector_of(vector_& to) :
+            myvector{&to},
+            mysize{to.size()},
+            my{mybuffer}
+        {}
+
+        write_to_vector_of(write_to_vector_of const&) = delete;
+        write_to_vector_of& operator=(write_to_vector_of const&) = delete;
+
+        void operator()(char a) {
+            if(my == mybuffer + write_buffer_size)
+                flush();
+            *my++ = a;
+        }
+
+        void operator()(char const* begin, char const* end) {
+            size_t s = static_cast<size_t>(end - begin);
+            if(static_cast<size_t>(mybuffer + write_buffer_size - my) < s) {
+                flush();
+                if(s > write_buffer_size) {
+                    insert(begin, end);
+                    return;
+                }
+            }
+            memcpy(my, begin, s);
+            my += s;
+        }
+
+        size_t finish() {
+            // returns the size written, or 0 if the vector could not grow. then it is as it was
+            flush();
+            if(myfail) {
+                myvector->resize(mysize);
+                return 0;
+            }
+            return myvector->size() - mysize;
+        }
+
+    private:
+        void flush() {
+            insert(mybuffer, my);
+            my = mybuffer;
+        }
+
+        void insert(char const* begin, char const* end) {
+            if(!myfail && begin != end && !myvector->insert(myvector->end(), begin, end))
+                myfail = true;
+        }
+    };
+
+}
+
+template<typename memory_>
+size_t write_to_buffer(void *buffer, size_t buffer_size, node<memory_> nodes, json::escape escape = json::escape::minimal) {
+    // write to buffer, at most buffer_size bytes
+    //
+    // returns the size of the json text. if it is larger than buffer_size, only the first buffer_size
+    // bytes were written and the last utf-8 sequence can be cut
+    auto begin = static_cast<char*>(buffer);
+    _::write_to_buffer_of_size to{begin, begin + buffer_size};
+    write_unbuffered(to, nodes, escape);
+    return to.size();
+}
+
+template<typename allocator_, typename sizer_, typename memory_>
+size_t write_to_vector(vector<char, allocator_, sizer_>& to, node<memory_> nodes, json::escape escape = json::escape::minimal) {
+    // append the json text to the end of to. returns the size of it
+    //
+    // returns 0 and to is as it was if it could not resize to
+    _::write_to_vector_of<vector<char, allocator_, sizer_>> v{to};
+    write_unbuffered(v, nodes, escape);
+    return v.finish();
+}
+
+}}
+#endif
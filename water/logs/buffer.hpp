@@ -1,10 +1,11 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_LOGS_BUFFER_HPP
 #define WATER_LOGS_BUFFER_HPP
 #include <water/logs/piece.hpp>
+#include <water/logs/deferred.hpp>
 #include <water/logs/write_to_buffer.hpp>
 #include <water/new_here.hpp>
 #include <water/fixed/memory_atomic.hpp>
@@ -12,9 +13,13 @@
 #include <water/allocator.hpp>
 #include <water/unicode/utf.hpp>
 #include <water/atomic.hpp>
+#include <water/thread_number.hpp>
 #include <water/logs/output_to_trace.hpp>
 #include <water/logs/tag_with_nothing.hpp>
 #include <water/hardware_interference_size.hpp>
+#ifndef WATER_NO_STD
+    #include <chrono>
+#endif
 namespace water { namespace logs {
 
 // Log buffer, see readme.md
@@ -54,23 +59,38 @@ namespace _ {
         else to = static_cast<unsigned_>(-1);
     }
 
+    // the stamp is stored one byte at a time after the capacity of the first piece, it is not aligned
+    inline void buffer_stamp(char *to, uint_largest_t a) noexcept {
+        for(unsigned i = 0; i != sizeof(a); ++i)
+            to[i] = static_cast<char>(static_cast<unsigned char>(a >> (i * 8)));
+    }
+
+    inline uint_largest_t buffer_stamp(char const* from) noexcept {
+        uint_largest_t r = 0;
+        for(unsigned i = 0; i != sizeof(r); ++i)
+            r |= static_cast<uint_largest_t>(static_cast<unsigned char>(from[i])) << (i * 8);
+        return r;
+    }
+
 }
 
-template<typename output_ = void, typename tag_ = void, bool memory_statistics_ = false>
+template<typename output_ = void, typename tag_ = void, bool memory_statistics_ = false, unsigned shards_ = 1, bool memory_trim_ = false>
 class buffer
 {
+    static_assert(shards_ >= 1, "shards_ must be at least 1");
+
 public:
     using output_type = if_not_void<output_, output_to_trace>;
     using tag_type = if_not_void<tag_, tag_with_nothing>;
     using piece_type = logs::piece<tag_type>;
-    using write_type = write_to_buffer<buffer<output_, tag_, memory_statistics_>>;
+    using write_type = write_to_buffer<buffer<output_, tag_, memory_statistics_, shards_, memory_trim_>>;
+    static unsigned constexpr shards = shards_;
 
 private:
 
     struct alignas(hardware_destructive_interference_size) aligned
     {
-        fixed::memory_atomic<void, memory_statistics_> memory;
-        atomic<piece_type*> list {};
+        fixed::memory_atomic<void, memory_statistics_, memory_trim_> memory;
         atomic<ptrdiff_t> concurrent {};
         
         constexpr aligned(size_t bytes, size_t block_size, bool concurrent) :
@@ -78,8 +98,19 @@ private:
             concurrent{concurrent ? 1 : 0}
         {}
     };
+
+    // the shards share the memory above, and a thread uses shard thread_number % shards_ so two
+    // threads can share one. each message reads the clock once. see "Many threads" in readme.md
+    struct alignas(hardware_destructive_interference_size) shard
+    {
+        atomic<piece_type*> list {};
+        #ifdef WATER_NO_STD
+        atomic<uint_largest_t> stamp {}; // no clock, count the messages of this list instead
+        #endif
+    };
     
     aligned my;
+    shard myshards[shards_] {};
     
     // below locked
     mutex mylock;
@@ -162,10 +193,9 @@ public:
     }
 
     piece_type* piece(tag_type const& tag, piece_type *list = 0) {
-        void *a = my.memory.allocate();
-        if(!a) return 0;
-        auto r = new(here(a)) piece_type(tag, my.memory.bytes() - sizeof(piece_type));
-        r->list(list);
+        // the piece without a list is the first of a message, with more than one list it has room for the stamp
+        auto r = piece_new(tag, shards_ > 1 && !list ? sizeof(uint_largest_t) : 0);
+        if(r) r->list(list);
         return r;
     }
 
@@ -186,8 +216,11 @@ public:
             first = first->list();
         }
         first->first(true);
-        piece_type *now = my.list.load(memory_order_relaxed);
-        do first->list(now); while(!my.list.compare_exchange_weak(now, list));
+        auto& to = myshards[shards_ > 1 ? thread_number() % shards_ : 0];
+        if(shards_ > 1)
+            stamp(first, to);
+        piece_type *now = to.list.load(memory_order_relaxed);
+        do first->list(now); while(!to.list.compare_exchange_weak(now, list));
         if(!my.concurrent.load(memory_order_relaxed))
             flush_if_not_flushing();
     }
@@ -197,7 +230,7 @@ public:
     }
 
     void flush() {
-        if(my.list.load(memory_order_acquire)) {
+        if(something_to_flush()) {
             lock_guard lock{mylock};
             flush_locked();
         }
@@ -206,7 +239,7 @@ public:
     void flush_if_not_flushing() {
         // flush only if nobody else is flushing right now
         // use flush() if it's important that the message just written by the current thread is flushed
-        if(my.list.load(memory_order_acquire) && mylock.try_lock()) {
+        if(something_to_flush() && mylock.try_lock()) {
             lock_guard lock{mylock, adopt_lock};
             flush_locked();
         }
@@ -221,17 +254,148 @@ public:
         return my.memory.statistics();
     }
 
+    size_t memory_trim() {
+        // give memory that is not used back to the allocator, needs memory_trim_. returns bytes
+        return my.memory.trim();
+    }
+
 private:
 
+    piece_type* piece_new(tag_type const& tag, size_t reserve) noexcept {
+        void *a = my.memory.allocate();
+        if(!a) return 0;
+        return new(here(a)) piece_type(tag, my.memory.bytes() - sizeof(piece_type) - reserve);
+    }
+
+    static void stamp(piece_type *first, shard& s) noexcept {
+        // the time the message was written, to merge the lists in order. without a clock each list
+        // counts its own messages, that keeps the order of each thread but not between threads
+        #ifdef WATER_NO_STD
+        uint_largest_t a = s.stamp.fetch_add(1, memory_order_relaxed);
+        #else
+        static_cast<void>(s);
+        auto a = static_cast<uint_largest_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+        _::buffer_stamp(first->begin() + first->capacity(), a);
+    }
+
+    static uint_largest_t stamp(piece_type const* first) noexcept {
+        return _::buffer_stamp(first->begin() + first->capacity());
+    }
+
+    bool something_to_flush() const noexcept {
+        for(auto& s : myshards)
+            if(s.list.load(memory_order_acquire))
+                return true;
+        return false;
+    }
+
+    piece_type* pop_locked() noexcept {
+        // must pop locked to preserve order. reverse each list (make oldest first)
+        // with more than one list, merge them one message at a time, taking the message with the
+        // lowest stamp first. the order within each list is kept so messages from one thread stay in order
+        if(shards_ == 1)
+            return reverse(myshards[0].list.exchange(0));
+        piece_type *from[shards_];
+        for(unsigned s = 0; s != shards_; ++s)
+            from[s] = reverse(myshards[s].list.exchange(0));
+        piece_type
+            *r = 0,
+            *last = 0;
+        while(true) {
+            unsigned s = shards_;
+            for(unsigned i = 0; i != shards_; ++i)
+                if(from[i] && (s == shards_ || stamp(from[i]) < stamp(from[s])))
+                    s = i;
+            if(s == shards_)
+                break;
+            if(last)
+                last->list(from[s]);
+            else
+                r = from[s];
+            last = from[s];
+            while(last->list() && !last->list()->first())
+                last = last->list();
+            from[s] = last->list();
+        }
+        if(last)
+            last->list(0);
+        return r;
+    }
+
+    struct deferred_text
+    {
+        buffer *me;
+        tag_type const *tag;
+        piece_type
+            *first = 0,
+            *last = 0;
+
+        void operator()(char const* begin, char const* end) noexcept {
+            while(begin != end) {
+                if(!last || last->size() == last->capacity()) {
+                    auto p = me->piece_new(*tag, 0); // the messages are merged already, no stamp
+                    if(!p)
+                        return;
+                    if(last)
+                        last->list(p);
+                    else
+                        first = p;
+                    last = p;
+                }
+                auto to = last->end();
+                auto to_end = last->begin() + last->capacity();
+                while(begin != end && to != to_end)
+                    *to++ = *begin++;
+                last->end(to);
+            }
+        }
+    };
+
+    piece_type* deferred_locked(piece_type *list) noexcept {
+        // replace each message written with logs::deferred with its text
+        // if the deferred message is broken, keep the text made before that
+        piece_type
+            *r = list,
+            *before = 0; // last piece of the message before
+        while(list) {
+            auto last = list;
+            while(last->list() && !last->list()->first())
+                last = last->list();
+            auto next = last->list();
+            if(deferred_is(list)) {
+                deferred_text text{this, &list->tag()};
+                deferred_to_text(list, text);
+                last->list(0);
+                dont_write(list);
+                auto replace = next;
+                if(text.first) {
+                    text.first->first(true);
+                    text.last->list(next);
+                    replace = text.first;
+                    last = text.last;
+                }
+                else
+                    last = before;
+                if(before)
+                    before->list(replace);
+                else
+                    r = replace;
+            }
+            before = last;
+            list = next;
+        }
+        return r;
+    }
+
     void flush_locked() {
-        // reverse list (make oldest first)
+        // pop the list (oldest first)
         // then write one line at a time, end a "run" with newline if it does not, run ends when the next piece is "first"
         // free each line at once
         // do not write 0 characters, stop the current run of pieces at the first 0
-        auto piece = my.list.exchange(0); // must pop locked to preserve order
+        auto piece = deferred_locked(pop_locked());
         if(!piece)
             return;
-        piece = reverse(piece);
         statistics_locked(piece);
         struct auto_free_ {
             piece_type *piece;
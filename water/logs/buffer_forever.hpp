@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -14,16 +14,17 @@ namespace water { namespace logs {
 
 // like buffer but no destructor
 
-template<typename output_ = void, typename tag_ = void, bool memory_statistics_ = false>
+template<typename output_ = void, typename tag_ = void, bool memory_statistics_ = false, unsigned shards_ = 1, bool memory_trim_ = false>
 class alignas(hardware_destructive_interference_size) buffer_forever
 {
-    using buffer = logs::buffer<output_, tag_, memory_statistics_>;
+    using buffer = logs::buffer<output_, tag_, memory_statistics_, shards_, memory_trim_>;
 
 public:
     using output_type = typename buffer::output_type;
     using tag_type = typename buffer::tag_type;
     using piece_type = typename buffer::piece_type;
-    using write_type = write_to_buffer<buffer_forever<output_, tag_, memory_statistics_>>;
+    using write_type = write_to_buffer<buffer_forever<output_, tag_, memory_statistics_, shards_, memory_trim_>>;
+    static unsigned constexpr shards = shards_;
 
 private:
     char mybuffer[sizeof(buffer)] {};
@@ -130,6 +131,10 @@ public:
         return get()->memory_statistics();
     }
 
+    size_t memory_trim() {
+        return get()->memory_trim();
+    }
+
 private:
     
     buffer* get() {
@@ -0,0 +1,280 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_LOGS_DEFERRED_HPP
+#define WATER_LOGS_DEFERRED_HPP
+#include <water/logs/bits.hpp>
+#include <water/int.hpp>
+#include <water/xtr/xtr.hpp>
+namespace water { namespace logs {
+
+/*
+
+Deferred formatting. The writing thread only copies a pointer to the format and the bytes of the
+arguments to the buffer. The text is made when the buffer is flushed, usually by the flush_thread.
+
+    water::logs::buffer<> log;
+    water::logs::deferred(log, "x is {} and y is {}", 123, 4.56);
+    water::logs::deferred(log, tag, "name {}", name);
+
+The format must exist until the buffer is flushed, a string literal is best. Each {} is replaced by
+the next argument, a {} without an argument is written as it is.
+
+Arguments can be bool, char, integers, floating point, pointers and strings. char const* and anything
+with begin() and end() of char is a string. Strings are copied to the buffer.
+
+A deferred message starts with the bytes 0 and 1, followed by the format pointer, then each argument
+as a type code and the bytes of the value. A string is the code 's', a size_t size and the characters.
+
+*/
+
+namespace _ {
+
+    template<char code_, typename stored_>
+    struct deferred_code {
+        static char constexpr code = code_;
+        using stored = stored_;
+    };
+
+    template<typename type_> struct deferred_type {}; // cannot be deferred
+    template<typename type_> struct deferred_type<type_ const> : deferred_type<type_> {};
+    template<typename type_> struct deferred_type<type_*> : deferred_code<'p', void const*> {};
+    template<> struct deferred_type<bool> : deferred_code<'b', bool> {};
+    template<> struct deferred_type<char> : deferred_code<'c', char> {};
+    template<> struct deferred_type<signed char> : deferred_code<'i', int_largest_t> {};
+    template<> struct deferred_type<short> : deferred_code<'i', int_largest_t> {};
+    template<> struct deferred_type<int> : deferred_code<'i', int_largest_t> {};
+    template<> struct deferred_type<long> : deferred_code<'i', int_largest_t> {};
+    template<> struct deferred_type<long long> : deferred_code<'i', int_largest_t> {};
+    template<> struct deferred_type<unsigned char> : deferred_code<'u', uint_largest_t> {};
+    template<> struct deferred_type<unsigned short> : deferred_code<'u', uint_largest_t> {};
+    template<> struct deferred_type<unsigned int> : deferred_code<'u', uint_largest_t> {};
+    template<> struct deferred_type<unsigned long> : deferred_code<'u', uint_largest_t> {};
+    template<> struct deferred_type<unsigned long long> : deferred_code<'u', uint_largest_t> {};
+    template<> struct deferred_type<float> : deferred_code<'f', float> {};
+    template<> struct deferred_type<double> : deferred_code<'d', double> {};
+    template<> struct deferred_type<long double> : deferred_code<'l', long double> {};
+
+    template<typename write_>
+    void deferred_bytes(write_& to, void const* bytes, size_t size) {
+        to.append(static_cast<char const*>(bytes), size);
+    }
+
+    template<typename write_, typename type_>
+    void deferred_put(write_& to, type_ const& a, typename deferred_type<type_>::stored* = 0) {
+        auto stored = static_cast<typename deferred_type<type_>::stored>(a);
+        to(deferred_type<type_>::code);
+        deferred_bytes(to, &stored, sizeof(stored));
+    }
+
+    template<typename write_, typename iterator_>
+    void deferred_put_string(write_& to, iterator_ begin, size_t size) {
+        to('s');
+        deferred_bytes(to, &size, sizeof(size));
+        while(size--) {
+            to(static_cast<char>(*begin));
+            ++begin;
+        }
+    }
+
+    template<typename write_>
+    void deferred_put_string(write_& to, char const* begin, size_t size) {
+        to('s');
+        deferred_bytes(to, &size, sizeof(size));
+        deferred_bytes(to, begin, size);
+    }
+
+    template<typename range_, typename = decltype(static_cast<char const*>(make_type<range_ const&>().data()))>
+    char const* deferred_data(range_ const& a, int) {
+        return a.data();
+    }
+
+    template<typename range_>
+    char const* deferred_data(range_ const&, long) {
+        return 0; // no data(), copy one character at a time
+    }
+
+    template<typename write_>
+    void deferred_put(write_& to, char const* a) {
+        size_t size = 0;
+        if(a)
+            while(a[size])
+                ++size;
+        deferred_put_string(to, a, size);
+    }
+
+    template<typename write_>
+    void deferred_put(write_& to, char* a) {
+        deferred_put(to, static_cast<char const*>(a));
+    }
+
+    template<
+        typename write_,
+        typename range_,
+        typename = decltype(make_type<char&>() = *make_type<range_ const&>().begin()),
+        typename = decltype(make_type<range_ const&>().begin() == make_type<range_ const&>().end())
+    >
+    void deferred_put(write_& to, range_ const& a) {
+        size_t size = 0;
+        for(auto i = a.begin(); i != a.end(); ++i)
+            ++size;
+        if(auto data = deferred_data(a, 0))
+            deferred_put_string(to, data, size);
+        else
+            deferred_put_string(to, a.begin(), size);
+    }
+
+    template<typename write_>
+    void deferred_put_all(write_&) {}
+
+    template<typename write_, typename argument_, typename ...arguments_>
+    void deferred_put_all(write_& to, argument_ const& argument, arguments_ const&... arguments) {
+        deferred_put(to, argument);
+        deferred_put_all(to, arguments...);
+    }
+
+    // read the bytes of one message, from its first piece to the next first piece
+
+    template<typename piece_>
+    class deferred_read
+    {
+        piece_ const *mypiece;
+        char const
+            *myat,
+            *myend;
+
+    public:
+        deferred_read(piece_ const* first) :
+            mypiece{first},
+            myat{first->begin()},
+            myend{first->end()}
+        {}
+
+        bool operator()(char& to) {
+            while(myat == myend) {
+                auto next = mypiece->list();
+                if(!next || next->first())
+                    return false;
+                mypiece = next;
+                myat = next->begin();
+                myend = next->end();
+            }
+            to = *myat++;
+            return true;
+        }
+
+        bool operator()(void* to, size_t size) {
+            auto t = static_cast<char*>(to);
+            while(size) {
+                if(!(*this)(*t))
+                    return false;
+                ++t;
+                --size;
+            }
+            return true;
+        }
+    };
+
+    template<typename type_, typename piece_, typename text_>
+    bool deferred_text_value(deferred_read<piece_>& read, text_& text) {
+        type_ value;
+        if(!read(&value, sizeof(value)))
+            return false;
+        auto x = xtr::no << value << xtr::string;
+        text(x.begin(), x.end());
+        return true;
+    }
+
+    template<typename piece_, typename text_>
+    bool deferred_text_string(deferred_read<piece_>& read, text_& text) {
+        size_t size;
+        if(!read(&size, sizeof(size)))
+            return false;
+        char buffer[64];
+        while(size) {
+            size_t s = 0;
+            while(s != sizeof(buffer) && s != size) {
+                if(!read(buffer[s]))
+                    return false;
+                ++s;
+            }
+            text(buffer + 0, buffer + s);
+            size -= s;
+        }
+        return true;
+    }
+
+    template<typename piece_, typename text_>
+    bool deferred_text_argument(char code, deferred_read<piece_>& read, text_& text) {
+        switch(code) {
+            case 'b': return deferred_text_value<bool>(read, text);
+            case 'c': return deferred_text_value<char>(read, text);
+            case 'i': return deferred_text_value<int_largest_t>(read, text);
+            case 'u': return deferred_text_value<uint_largest_t>(read, text);
+            case 'f': return deferred_text_value<float>(read, text);
+            case 'd': return deferred_text_value<double>(read, text);
+            case 'l': return deferred_text_value<long double>(read, text);
+            case 'p': return deferred_text_value<void const*>(read, text);
+            case 's': return deferred_text_string(read, text);
+        }
+        return false;
+    }
+
+}
+
+template<typename piece_>
+bool deferred_is(piece_ const* first) {
+    // true if the message starting at first was written with logs::deferred
+    return first->size() >= 2 && first->begin()[0] == 0 && first->begin()[1] == 1;
+}
+
+template<typename piece_, typename text_>
+bool deferred_to_text(piece_ const* first, text_&& text) {
+    // make the text of a deferred message. calls text(char const* begin, char const* end) for each part
+    // returns false if the message was not deferred or is broken, then text could have been called
+    if(!deferred_is(first))
+        return false;
+    _::deferred_read<piece_> read{first};
+    char skip[2];
+    char const* format;
+    if(!read(skip, 2) || !read(&format, sizeof(format)) || !format)
+        return false;
+    auto at = format;
+    char code;
+    while(*at) {
+        if(at[0] != '{' || at[1] != '}')
+            ++at;
+        else if(!read(code))
+            while(*at) ++at; // no more arguments, write the rest as it is
+        else {
+            if(format != at)
+                text(format, at);
+            if(!_::deferred_text_argument(code, read, text))
+                return false;
+            format = at += 2;
+        }
+    }
+    if(format != at)
+        text(format, at);
+    return true;
+}
+
+template<typename buffer_, typename ...arguments_>
+bool deferred(buffer_& buffer, typename buffer_::tag_type const& tag, char const* format, arguments_ const&... arguments) {
+    // returns false if the buffer could not allocate memory
+    auto to = buffer.write(tag);
+    to(static_cast<char>(0));
+    to(static_cast<char>(1));
+    _::deferred_bytes(to, &format, sizeof(format));
+    _::deferred_put_all(to, arguments...);
+    return to.write();
+}
+
+template<typename buffer_, typename ...arguments_>
+bool deferred(buffer_& buffer, char const* format, arguments_ const&... arguments) {
+    return deferred(buffer, typename buffer_::tag_type{}, format, arguments...);
+}
+
+}}
+#endif
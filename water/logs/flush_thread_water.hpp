@@ -1,4 +1,4 @@
-// Copyright 2023 Johan Paulsson
+// Copyright 2023-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -42,6 +42,11 @@ public:
     explicit flush_thread_water(buffer_& buffer, double frequency_seconds = 0.) noexcept {
         start(buffer, frequency_seconds);
     }
+
+    template<typename buffer_>
+    flush_thread_water(buffer_& buffer, double frequency_seconds, threads::run_options const& options) noexcept {
+        start(buffer, frequency_seconds, options);
+    }
     
     ~flush_thread_water() {
         stop();
@@ -49,6 +54,30 @@ public:
     
     template<typename buffer_>
     bool start(buffer_& buffer, double frequency_seconds = 0.) noexcept {
+        return start(buffer, frequency_seconds, threads::run_options{threads::priority_lower}, true);
+    }
+
+    template<typename buffer_>
+    bool start(buffer_& buffer, double frequency_seconds, threads::run_options const& options) noexcept {
+        // start the thread with options, for example to pin it to a cpu: run_options{}.cpu(3)
+        return start(buffer, frequency_seconds, options, false);
+    }
+
+    void stop() noexcept {
+        auto lock = lock_move(mymutex);
+        if(!mybuffer)
+            return;
+        mybuffer = 0;
+        mycondition.wake();
+        auto x = my;
+        lock = {};
+        join(x);
+    }
+
+private:
+
+    template<typename buffer_>
+    bool start(buffer_& buffer, double frequency_seconds, threads::run_options const& options, bool without_options) noexcept {
         auto lock = lock_move(mymutex);
         ___water_assert(!mybuffer && "already started");
         if(mybuffer)
@@ -58,26 +87,13 @@ public:
             myseconds = frequency_seconds;
         using function = threads::member_function<flush_thread_water, &flush_thread_water::thread<buffer_>>;
         bool ok =
-            threads::run<function>(this, my, threads::priority_lower) ||
-            threads::run<function>(this, my);
+            threads::run<function>(this, my, options) ||
+            (without_options && threads::run<function>(this, my));
         if(!ok)
             mybuffer = 0;
         ___water_assert(ok && "thread did not start");
         return ok;
     }
-    
-    void stop() noexcept {
-        auto lock = lock_move(mymutex);
-        if(!mybuffer)
-            return;
-        mybuffer = 0;
-        mycondition.wake();
-        auto x = my;
-        lock = {};
-        join(x);
-    }
-    
-private:
 
     template<typename buffer_>
     void thread() {
@@ -0,0 +1,279 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_LOGS_OUTPUT_TO_FILE_HPP
+#define WATER_LOGS_OUTPUT_TO_FILE_HPP
+#include <water/logs/bits.hpp>
+#include <water/int.hpp>
+#include <water/allocator_nothrow.hpp>
+#include <water/str/begin_end.hpp>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+namespace water { namespace logs {
+
+/*
+
+Output class for buffer/buffer_forever that writes to a file. Only for POSIX systems.
+
+    water::logs::buffer<water::logs::output_to_file> log{water::logs::output_to_file{"log.log"}};
+
+The lines of one flush are copied to memory blocks, and all blocks are written with one writev when
+the flush is done, or when all blocks are full. The file is opened at the first flush.
+
+The file can be rotated when it is larger than a number of bytes or older than a number of seconds.
+Then the file is renamed path.1, path.1 is renamed path.2 and so on, until path.keep. Rotation is done
+after writing, on the thread that flushes.
+
+    water::logs::output_to_file file{"log.log"};
+    file.rotate_bytes(64 << 20).rotate_seconds(24 * 60 * 60).rotate_keep(5);
+
+For buffer_forever, inherit this and set the path from the default constructor.
+
+The tag needs a water::str << operator, like output_to_trace.
+
+*/
+
+class output_to_file
+{
+public:
+    static size_t constexpr
+        path_max = 256,
+        block_size = 64 * 1024,
+        blocks_max = 16;
+
+private:
+    char mypath[path_max] {};
+    int myfile = -1;
+    char *myblocks[blocks_max] {};
+    size_t
+        myblock = 0, // the block being written to
+        myat = 0; // in myblock
+    uint_largest_t
+        mybytes = 0, // size of the file
+        myrotate_bytes = 0;
+    time_t
+        myopened = 0,
+        myrotate_seconds = 0;
+    unsigned mykeep = 1;
+
+public:
+    output_to_file() = default;
+
+    explicit output_to_file(char const* path) {
+        this->path(path);
+    }
+
+    output_to_file(output_to_file const& a) :
+        myrotate_bytes{a.myrotate_bytes},
+        myrotate_seconds{a.myrotate_seconds},
+        mykeep{a.mykeep}
+    {
+        path(a.mypath);
+    }
+
+    output_to_file& operator=(output_to_file const&) = delete;
+
+    ~output_to_file() {
+        write_blocks();
+        close();
+        for(auto b : myblocks)
+            if(b)
+                allocator_nothrow{}.free(b, block_size);
+    }
+
+    output_to_file& path(char const* a) {
+        // path of the file. if it is already open, the old file is used until it is rotated
+        size_t s = 0;
+        if(a)
+            while(a[s] && s != path_max - 1) {
+                mypath[s] = a[s];
+                ++s;
+            }
+        ___water_assert(!a || !a[s]);
+        mypath[s] = 0;
+        return *this;
+    }
+
+    char const* path() const {
+        return mypath;
+    }
+
+    output_to_file& rotate_bytes(uint_largest_t a) {
+        // rotate when the file is at least this large. 0 does not rotate
+        myrotate_bytes = a;
+        return *this;
+    }
+
+    output_to_file& rotate_seconds(time_t a) {
+        // rotate when the file was opened at least this long ago. 0 does not rotate
+        myrotate_seconds = a;
+        return *this;
+    }
+
+    output_to_file& rotate_keep(unsigned a) {
+        // number of old files to keep, 0 removes the file when rotating
+        mykeep = a;
+        return *this;
+    }
+
+    bool is_open() const {
+        return myfile != -1;
+    }
+
+    void start() noexcept {
+        if(myfile == -1 && mypath[0])
+            open();
+    }
+
+    template<typename tag_>
+    char* prefix(char* begin, char* end, tag_ const& tag) noexcept {
+        auto to = str::to_begin_end(begin, end);
+        to << tag;
+        if(to.end() != begin)
+            to << ' ';
+        return to.end();
+    }
+
+    void line(char const* begin, char const* end) noexcept {
+        if(myfile == -1)
+            return;
+        while(begin != end) {
+            if(myat == block_size) {
+                if(myblock + 1 == blocks_max)
+                    write_blocks();
+                else {
+                    ++myblock;
+                    myat = 0;
+                }
+            }
+            if(!myblocks[myblock] && !(myblocks[myblock] = static_cast<char*>(allocator_nothrow{}.allocate(block_size)))) {
+                // no memory, write this line now
+                write_blocks();
+                write(begin, static_cast<size_t>(end - begin));
+                return;
+            }
+            size_t size = static_cast<size_t>(end - begin);
+            if(size > block_size - myat)
+                size = block_size - myat;
+            ::memcpy(myblocks[myblock] + myat, begin, size);
+            begin += size;
+            myat += size;
+        }
+    }
+
+    void stop() noexcept {
+        write_blocks();
+        if(myfile != -1 && (
+            (myrotate_bytes && mybytes >= myrotate_bytes) ||
+            (myrotate_seconds && ::time(0) - myopened >= myrotate_seconds)
+        ))
+            rotate();
+    }
+
+private:
+
+    void open() noexcept {
+        int flags = O_WRONLY | O_CREAT | O_APPEND;
+        #ifdef O_CLOEXEC
+        flags |= O_CLOEXEC;
+        #endif
+        do myfile = ::open(mypath, flags, 0644); while(myfile == -1 && errno == EINTR);
+        if(myfile == -1)
+            return;
+        struct stat s{};
+        mybytes = !::fstat(myfile, &s) && s.st_size > 0 ? static_cast<uint_largest_t>(s.st_size) : 0;
+        myopened = ::time(0);
+    }
+
+    void close() noexcept {
+        if(myfile != -1) {
+            ::close(myfile);
+            myfile = -1;
+        }
+    }
+
+    void write(char const* begin, size_t size) noexcept {
+        while(size) {
+            auto w = ::write(myfile, begin, size);
+            if(w < 0 && errno == EINTR)
+                continue;
+            if(w <= 0)
+                return;
+            begin += w;
+            size -= static_cast<size_t>(w);
+            mybytes += static_cast<uint_largest_t>(w);
+        }
+    }
+
+    void write_blocks() noexcept {
+        // one writev for all blocks, more only if it writes less than everything
+        size_t count = myblock + (myat ? 1 : 0);
+        if(myfile != -1 && count) {
+            iovec io[blocks_max];
+            for(size_t i = 0; i != count; ++i) {
+                io[i].iov_base = myblocks[i];
+                io[i].iov_len = i == myblock ? myat : block_size;
+            }
+            iovec *at = io;
+            while(count) {
+                auto w = ::writev(myfile, at, static_cast<int>(count));
+                if(w < 0 && errno == EINTR)
+                    continue;
+                if(w <= 0)
+                    break;
+                mybytes += static_cast<uint_largest_t>(w);
+                auto left = static_cast<size_t>(w);
+                while(count && left >= at->iov_len) {
+                    left -= at->iov_len;
+                    ++at;
+                    --count;
+                }
+                if(count) {
+                    at->iov_base = static_cast<char*>(at->iov_base) + left;
+                    at->iov_len -= left;
+                }
+            }
+        }
+        myblock = myat = 0;
+    }
+
+    void rotate() noexcept {
+        // path.keep-1 to path.keep, ... path to path.1
+        close();
+        char from[path_max + 16], to[path_max + 16];
+        if(!mykeep)
+            ::unlink(mypath);
+        for(unsigned n = mykeep; n; --n) {
+            numbered(to, n);
+            numbered(from, n - 1);
+            ::rename(from, to);
+        }
+        open();
+    }
+
+    void numbered(char *to, unsigned number) const noexcept {
+        // path.number, or path if number is 0
+        auto p = mypath;
+        while(*p)
+            *to++ = *p++;
+        if(number) {
+            *to++ = '.';
+            char digits[16];
+            unsigned d = 0;
+            do digits[d++] = static_cast<char>('0' + number % 10); while(number /= 10);
+            while(d)
+                *to++ = digits[--d];
+        }
+        *to = 0;
+    }
+};
+
+}}
+#endif
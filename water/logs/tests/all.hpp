@@ -0,0 +1,23 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_LOGS_TESTS_ALL_HPP
+#define WATER_LOGS_TESTS_ALL_HPP
+#include <water/logs/tests/buffer_shards.hpp>
+#include <water/logs/tests/deferred.hpp>
+#ifdef WATER_SYSTEM_POSIX
+    #include <water/logs/tests/output_to_file.hpp>
+#endif
+namespace water { namespace logs { namespace tests {
+
+inline void all() {
+    buffer_shards_all();
+    deferred_all();
+    #ifdef WATER_SYSTEM_POSIX
+    output_to_file_all();
+    #endif
+}
+
+}}}
+#endif
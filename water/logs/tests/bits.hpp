@@ -0,0 +1,39 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_LOGS_TESTS_BITS_HPP
+#define WATER_LOGS_TESTS_BITS_HPP
+#include <water/water.hpp>
+#include <water/test.hpp>
+#include <water/logs/buffer.hpp>
+#include <water/vector.hpp>
+namespace water { namespace logs { namespace tests {
+
+// output for logs::buffer that adds each line to the end of a vector, without a prefix
+
+class output_to_vector
+{
+    vector<char> *my;
+
+public:
+    explicit output_to_vector(vector<char>& a) :
+        my{&a}
+    {}
+
+    void start() noexcept {}
+
+    template<typename tag_>
+    char* prefix(char* begin, char* /*end*/, tag_ const& /*tag*/) noexcept {
+        return begin;
+    }
+
+    void line(char const* begin, char const* end) noexcept {
+        my->insert(my->end(), begin, end);
+    }
+
+    void stop() noexcept {}
+};
+
+}}}
+#endif
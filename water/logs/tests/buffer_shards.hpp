@@ -0,0 +1,106 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_LOGS_TESTS_BUFFER_SHARDS_HPP
+#define WATER_LOGS_TESTS_BUFFER_SHARDS_HPP
+#include <water/logs/tests/bits.hpp>
+#include <water/threads/tests/run_many.hpp>
+namespace water { namespace logs { namespace tests {
+
+/*
+
+4 threads write messages "thread number" to a buffer with 1 and 4 lists. one thread flushes now and
+then while the others write. after the last flush each thread's messages must be there, in the order
+that thread wrote them. some messages are long enough to use more than one piece
+
+*/
+
+unsigned constexpr
+    buffer_shards_threads = 4,
+    buffer_shards_messages = 2000;
+
+inline size_t buffer_shards_text(char *to, unsigned thread, unsigned number) {
+    auto t = to;
+    bool long_ = number % 7 == 0;
+    *t++ = static_cast<char>('0' + thread);
+    *t++ = ' ';
+    char digits[16];
+    unsigned d = 0;
+    do digits[d++] = static_cast<char>('0' + number % 10); while(number /= 10);
+    while(d)
+        *t++ = digits[--d];
+    if(long_) {
+        *t++ = ' ';
+        for(unsigned x = 0; x != 300; ++x)
+            *t++ = 'x';
+    }
+    return static_cast<size_t>(t - to);
+}
+
+template<typename buffer_>
+class buffer_shards_write
+{
+    buffer_ *mybuffer;
+    atomic<unsigned> mythread{0};
+
+public:
+    explicit buffer_shards_write(buffer_& a) :
+        mybuffer{&a}
+    {
+        threads::tests::run_many_reference(*this, buffer_shards_threads);
+    }
+
+    void operator()() {
+        unsigned t = mythread.fetch_add(1);
+        char text[400];
+        for(unsigned n = 0; n != buffer_shards_messages; ++n) {
+            ___water_test((*mybuffer)(text + 0, buffer_shards_text(text, t, n)));
+            if(t == 0 && n % 100 == 0)
+                mybuffer->flush();
+        }
+    }
+};
+
+inline void buffer_shards_check(vector<char> const& text) {
+    unsigned next[buffer_shards_threads] {};
+    size_t lines = 0;
+    auto at = text.begin();
+    auto end = text.end();
+    while(at != end) {
+        unsigned t = static_cast<unsigned>(*at - '0');
+        ___water_test(t < buffer_shards_threads);
+        if(t >= buffer_shards_threads || ++at == end || *at != ' ')
+            return;
+        unsigned n = 0;
+        while(++at != end && '0' <= *at && *at <= '9')
+            n = n * 10 + static_cast<unsigned>(*at - '0');
+        ___water_test(n == next[t]);
+        next[t] = n + 1;
+        while(at != end && *at != '\n')
+            ++at;
+        if(at != end)
+            ++at;
+        ++lines;
+    }
+    ___water_test(lines == buffer_shards_threads * buffer_shards_messages);
+    for(auto n : next)
+        ___water_test(n == buffer_shards_messages);
+}
+
+template<unsigned shards_>
+void buffer_shards() {
+    vector<char> text;
+    buffer<output_to_vector, void, false, shards_> log{output_to_vector{text}};
+    buffer_shards_write<decltype(log)>{log};
+    log.flush();
+    buffer_shards_check(text);
+}
+
+inline void buffer_shards_all() {
+    buffer_shards<1>();
+    buffer_shards<4>();
+}
+
+}}}
+#endif
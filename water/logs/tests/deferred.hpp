@@ -0,0 +1,104 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_LOGS_TESTS_DEFERRED_HPP
+#define WATER_LOGS_TESTS_DEFERRED_HPP
+#include <water/logs/tests/bits.hpp>
+#include <water/logs/deferred.hpp>
+namespace water { namespace logs { namespace tests {
+
+/*
+
+write messages with logs::deferred, flush the buffer and look at the text. with the smallest pieces
+every message uses more than one piece, and with more than one list the first piece has a stamp
+
+*/
+
+inline bool deferred_equal(vector<char> const& text, char const* expect) {
+    auto t = text.begin();
+    while(*expect && t != text.end() && *t == *expect) {
+        ++t;
+        ++expect;
+    }
+    return !*expect && t == text.end();
+}
+
+struct deferred_range {
+    // a range without data(), so it is copied one character at a time
+    char const *mybegin, *myend;
+    char const* begin() const { return mybegin; }
+    char const* end() const { return myend; }
+};
+
+template<typename buffer_>
+void deferred_flush(buffer_& log, vector<char>& text, char const* expect) {
+    log.flush();
+    ___water_test(deferred_equal(text, expect));
+    text.clear();
+}
+
+template<unsigned shards_>
+void deferred_one(size_t piece_size) {
+    vector<char> text;
+    buffer<output_to_vector, void, false, shards_> log{output_to_vector{text}, piece_size};
+
+    ___water_test(deferred(log, "int {} {} unsigned {}", -123, static_cast<short>(7), 45u));
+    deferred_flush(log, text, "int -123 7 unsigned 45\n");
+
+    ___water_test(deferred(log, "float {} double {} {}", 1.5f, 4.56, -12.5));
+    deferred_flush(log, text, "float 1.5 double 4.56 -12.5\n");
+
+    ___water_test(deferred(log, "char {} bool {} {}", 'x', true, false));
+    deferred_flush(log, text, "char x bool true false\n");
+
+    char const *null = 0;
+    char name[] = "name";
+    vector<char> range;
+    for(auto n : name)
+        if(n)
+            range.push_back(n);
+    ___water_test(deferred(log, "literal {} char* {} null [{}] range {}", "text", name, null, range));
+    deferred_flush(log, text, "literal text char* name null [] range name\n");
+    ___water_test(deferred(log, "range {} empty [{}]", deferred_range{name, name + 4}, deferred_range{name, name}));
+    deferred_flush(log, text, "range name empty []\n");
+
+    // more arguments than {} are not written, a {} without an argument is written as it is
+    ___water_test(deferred(log, "extra {}", 1, 2, 3));
+    deferred_flush(log, text, "extra 1\n");
+    ___water_test(deferred(log, "missing {} {} {}", 1));
+    deferred_flush(log, text, "missing 1 {} {}\n");
+    ___water_test(deferred(log, "none {} {"));
+    deferred_flush(log, text, "none {} {\n");
+
+    // the arguments and the text use many pieces
+    char const long_[] =
+        "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"
+        "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz";
+    ___water_test(deferred(log, "long {} {} {} end", long_, 1234567890123ll, long_));
+    deferred_flush(log, text,
+        "long "
+        "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"
+        "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"
+        " 1234567890123 "
+        "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"
+        "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"
+        " end\n"
+    );
+
+    // deferred and plain messages in one flush keep their order
+    ___water_test(deferred(log, "one {}", 1));
+    ___water_test(log("two"));
+    ___water_test(deferred(log, "three {}", 3));
+    deferred_flush(log, text, "one 1\ntwo\nthree 3\n");
+}
+
+inline void deferred_all() {
+    deferred_one<1>(0);
+    deferred_one<1>(1);
+    deferred_one<4>(0);
+    deferred_one<4>(1);
+}
+
+}}}
+#endif
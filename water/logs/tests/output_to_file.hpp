@@ -0,0 +1,118 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_LOGS_TESTS_OUTPUT_TO_FILE_HPP
+#define WATER_LOGS_TESTS_OUTPUT_TO_FILE_HPP
+#include <water/logs/tests/bits.hpp>
+#include <water/logs/output_to_file.hpp>
+#include <stdlib.h>
+namespace water { namespace logs { namespace tests {
+
+/*
+
+write to files in a new directory in /tmp, and read them back
+
+- one flush of more than blocks_max blocks
+- rotate_bytes and rotate_keep rename the files path.1, path.2 and so on
+
+*/
+
+inline void output_to_file_path(char *to, char const* directory, char const* name) {
+    while(*directory)
+        *to++ = *directory++;
+    *to++ = '/';
+    while((*to++ = *name++));
+}
+
+inline bool output_to_file_read(char const* path, vector<char>& to) {
+    // false if the file does not exist
+    to.clear();
+    int file = ::open(path, O_RDONLY);
+    if(file == -1)
+        return false;
+    char buffer[4096];
+    ssize_t r;
+    while((r = ::read(file, buffer, sizeof(buffer))) > 0)
+        to.insert(to.end(), buffer + 0, buffer + r);
+    ::close(file);
+    return r == 0;
+}
+
+inline bool output_to_file_equal(vector<char> const& a, vector<char> const& b) {
+    if(a.size() != b.size())
+        return false;
+    for(size_t i = 0; i != a.size(); ++i)
+        if(a[i] != b[i])
+            return false;
+    return true;
+}
+
+inline void output_to_file_blocks(char const* directory) {
+    char path[256];
+    output_to_file_path(path, directory, "blocks");
+    vector<char> expect;
+    {
+        buffer<output_to_file> log{output_to_file{path}};
+        char line[1000];
+        size_t lines = output_to_file::block_size * (output_to_file::blocks_max + 2) / sizeof(line);
+        for(size_t i = 0; i != lines; ++i) {
+            for(size_t c = 0; c != sizeof(line); ++c)
+                line[c] = static_cast<char>('a' + (i + c) % 26);
+            ___water_test(log(line + 0, sizeof(line)));
+            expect.insert(expect.end(), line + 0, line + sizeof(line));
+            expect.push_back('\n');
+        }
+        log.flush();
+        ___water_test(expect.size() > output_to_file::block_size * output_to_file::blocks_max);
+    }
+    vector<char> file;
+    ___water_test(output_to_file_read(path, file));
+    ___water_test(output_to_file_equal(file, expect));
+    ::unlink(path);
+}
+
+inline void output_to_file_rotate(char const* directory, unsigned keep) {
+    char
+        path[256],
+        numbered[5][256];
+    output_to_file_path(path, directory, "rotate");
+    char const* names[] = {"rotate.1", "rotate.2", "rotate.3", "rotate.4", "rotate.5"};
+    for(unsigned n = 0; n != 5; ++n)
+        output_to_file_path(numbered[n], directory, names[n]);
+    {
+        // each flush makes the file larger than rotate_bytes, it is rotated after each
+        buffer<output_to_file> log{output_to_file{path}.rotate_bytes(1).rotate_keep(keep)};
+        char const* lines[] = {"0", "1", "2", "3", "4"};
+        for(auto l : lines) {
+            ___water_test(log(l));
+            log.flush();
+        }
+    }
+    // path is empty, path.1 has the last line, path.2 the line before, up to path.keep
+    vector<char> file;
+    ___water_test(output_to_file_read(path, file) && file.size() == 0);
+    for(unsigned n = 0; n != 5; ++n) {
+        bool exists = output_to_file_read(numbered[n], file);
+        ___water_test(exists == (n < keep));
+        if(exists)
+            ___water_test(file.size() == 2 && file[0] == static_cast<char>('4' - n) && file[1] == '\n');
+        ::unlink(numbered[n]);
+    }
+    ::unlink(path);
+}
+
+inline void output_to_file_all() {
+    char directory[] = "/tmp/water_logs_tests_XXXXXX";
+    ___water_test(::mkdtemp(directory));
+    if(!directory[0])
+        return;
+    output_to_file_blocks(directory);
+    output_to_file_rotate(directory, 0);
+    output_to_file_rotate(directory, 1);
+    output_to_file_rotate(directory, 3);
+    ::rmdir(directory);
+}
+
+}}}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -6,6 +6,12 @@
 #define WATER_LOGS_WRITE_TO_BUFFER_HPP
 #include <water/logs/bits.hpp>
 #include <water/swap.hpp>
+#ifdef WATER_NO_CHEADERS
+    #include <string.h>
+#else
+    #include <cstring>
+    namespace water { namespace logs { using std::memcpy; }}
+#endif
 namespace water { namespace logs {
 
 /*
@@ -117,6 +123,29 @@ public:
         return !myhalfway && one(a);
     }
 
+    bool append(char const* begin, size_t size) {
+        // adds size characters, like operator()(char) for each but copying as much as fits in each piece
+        if(myhalfway)
+            return false;
+        while(size) {
+            if(myat == myend) {
+                if(!one(*begin))
+                    return false;
+                ++begin;
+                --size;
+                continue;
+            }
+            size_t fit = static_cast<size_t>(myend - myat);
+            if(fit > size)
+                fit = size;
+            memcpy(myat, begin, fit);
+            myat += fit;
+            begin += fit;
+            size -= fit;
+        }
+        return true;
+    }
+
     template<typename iterator_>
     bool operator()(iterator_ begin, iterator_ end) {
         if(!*this)
@@ -0,0 +1,348 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_NUMBERS_DECIMAL_TO_FLOAT_HPP
+#define WATER_NUMBERS_DECIMAL_TO_FLOAT_HPP
+#include <water/numbers/shortest.hpp>
+#include <water/numbers/power5.hpp>
+namespace water { namespace numbers {
+
+/*
+
+Convert decimal digits * 10^exponent to the nearest float or double, correctly rounded. This is
+the opposite of shortest.hpp.
+
+    decimal_to_float<double> d(123456, -3); // 123.456
+    if(d) // false if double is not IEEE 754 64 bit
+        double f = d;
+
+Three ways, from fastest to slowest:
+- Clinger: If the digits and 10^exponent are exact in the float type, one multiply or divide.
+- Eisel-Lemire: Multiply the first 19 digits with a 128 bit power of 5 from a table. With 19 digits
+  or less this is always enough, see "Fast Number Parsing Without Fallback" by Noble Mushtak and
+  Daniel Lemire.
+- More than 19 digits: If the first 19 digits and the first 19 digits + 1 round to the same float,
+  that is the result. Otherwise compare the digits with the halfway point between the two floats
+  using big integers. Only the first 768 digits are used, the rest only tell if the number is larger.
+
+Like numbers::shortest, the float types must be IEEE 754 32 or 64 bit. operator bool is false for
+other types, and the caller must use some other way.
+
+Used by parsed_to_float when the base is 10, and by json::number::to_double.
+
+*/
+
+namespace _ {
+
+    int constexpr
+        decimal_to_float_power5_min = power5_min,
+        decimal_to_float_power5_max = 308; // 10^309 is infinity
+
+    class decimal_to_float_big
+    {
+        // unsigned big integer, 32 bits per word, least significant first.
+        // 768 digits * 10^-1110 compared to a subnormal needs about 3700 bits
+        static unsigned constexpr words = 128;
+        shortest_uint32 my[words];
+        unsigned mysize = 0;
+
+    public:
+        void multiply_add(shortest_uint32 multiply, shortest_uint32 add) {
+            shortest_uint64 carry = add;
+            for(unsigned w = 0; w != mysize; ++w) {
+                carry += static_cast<shortest_uint64>(my[w]) * multiply;
+                my[w] = static_cast<shortest_uint32>(carry & 0xffffffffu);
+                carry >>= 32;
+            }
+            if(carry) {
+                ___water_assert(mysize != words);
+                my[mysize++] = static_cast<shortest_uint32>(carry);
+            }
+        }
+
+        void multiply_power5(unsigned e) {
+            while(e >= 13) {
+                multiply_add(1220703125u, 0); // 5^13
+                e -= 13;
+            }
+            shortest_uint32 m = 1;
+            while(e--)
+                m *= 5;
+            if(m != 1)
+                multiply_add(m, 0);
+        }
+
+        void shift_left(unsigned bits) {
+            if(!mysize)
+                return;
+            unsigned const
+                move = bits / 32,
+                shift = bits % 32;
+            ___water_assert(mysize + move < words);
+            if(shift) {
+                shortest_uint32 top = my[mysize - 1] >> (32 - shift);
+                for(unsigned w = mysize - 1; w; --w)
+                    my[w] = static_cast<shortest_uint32>((my[w] << shift) | (my[w - 1] >> (32 - shift)));
+                my[0] = static_cast<shortest_uint32>(my[0] << shift);
+                if(top)
+                    my[mysize++] = top;
+            }
+            if(move) {
+                unsigned w = mysize;
+                while(w--)
+                    my[w + move] = my[w];
+                for(w = 0; w != move; ++w)
+                    my[w] = 0;
+                mysize += move;
+            }
+        }
+
+        int compare(decimal_to_float_big const& a) const {
+            if(mysize != a.mysize)
+                return mysize < a.mysize ? -1 : 1;
+            unsigned w = mysize;
+            while(w--)
+                if(my[w] != a.my[w])
+                    return my[w] < a.my[w] ? -1 : 1;
+            return 0;
+        }
+    };
+
+}
+
+template<typename float_>
+class decimal_to_float
+{
+    using type = _::shortest_float<float_>;
+    using uint64 = _::shortest_uint64;
+
+public:
+    static unsigned constexpr digits_max = 768; // more digits than this are not used, except to round up
+
+private:
+    float_ my = 0;
+    bool mycan = false;
+
+public:
+    decimal_to_float() = default;
+
+    decimal_to_float(uint64 digits, int exponent) {
+        // digits * 10^exponent
+        convert(digits, exponent, ifel<shortest_can<float_>, int, char>{});
+    }
+
+    template<typename iterator_>
+    decimal_to_float(iterator_ begin, iterator_ end, int exponent, bool more = false) {
+        // begin, end are digits 0 to 9, not characters. the last digit is * 10^exponent, so 1 2 3
+        // with exponent -1 is 12.3. more is true if there are digits after end that are not 0
+        convert(begin, end, exponent, more, ifel<shortest_can<float_>, int, char>{});
+    }
+
+    explicit operator bool() const {
+        // false if float_ is not IEEE 754 32 or 64 bit, and nothing was converted
+        return mycan;
+    }
+
+    operator float_() const {
+        // infinity if the number was too large, 0 if it was too small
+        return my;
+    }
+
+private:
+    void convert(uint64, int, char) {}
+
+    void convert(uint64 w, int q, int) {
+        mycan = true;
+        if(w && !clinger(w, q))
+            set(lemire(w, q));
+    }
+
+    template<typename iterator_>
+    void convert(iterator_, iterator_, int, bool, char) {}
+
+    template<typename iterator_>
+    void convert(iterator_ begin, iterator_ end, int exponent, bool more, int) {
+        mycan = true;
+        while(begin != end && !*begin)
+            ++begin;
+        // the first 19 digits
+        uint64 w = 0;
+        unsigned n = 0;
+        auto i = begin;
+        while(i != end && n != 19) {
+            ___water_assert(*i < 10);
+            w = w * 10 + static_cast<unsigned>(*i);
+            ++i;
+            ++n;
+        }
+        int q = exponent;
+        bool truncated = more;
+        while(i != end) {
+            if(q != numeric_limits<int>::max())
+                ++q;
+            if(*i)
+                truncated = true;
+            ++i;
+        }
+        if(!w)
+            return;
+        if(!truncated) {
+            convert(w, q, 0);
+            return;
+        }
+        // the number is between w and w + 1
+        uint64 bits = lemire(w, q);
+        if(bits != lemire(w + 1, q))
+            bits = round_big(begin, end, exponent, more, bits);
+        set(bits);
+    }
+
+    bool clinger(uint64 w, int q) {
+        // w and 10^q are exact in float_, so one multiply or divide is correctly rounded
+        static double const power10[] {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        int constexpr exact_power_max = type::mantissa_bits == 52 ? 22 : 10;
+        uint64 constexpr exact_max = static_cast<uint64>(1) << (type::mantissa_bits + 1);
+        if(w > exact_max || q < -exact_power_max)
+            return false;
+        while(q > exact_power_max && w <= exact_max / 10) {
+            // 123e25 is 12300000e20
+            w *= 10;
+            --q;
+        }
+        if(q > exact_power_max)
+            return false;
+        float_ f = static_cast<float_>(w);
+        if(q < 0)
+            f /= static_cast<float_>(power10[-q]);
+        else
+            f *= static_cast<float_>(power10[q]);
+        my = f;
+        return true;
+    }
+
+    static uint64 lemire(uint64 w, int q) {
+        // returns the bits of the float nearest to w * 10^q, without sign bit
+        unsigned constexpr mantissa_bits = type::mantissa_bits;
+        int constexpr
+            infinity = (1 << type::exponent_bits) - 1,
+            round_even_min = mantissa_bits == 52 ? -4 : -17, // exponents where w * 10^q can be halfway between two floats
+            round_even_max = mantissa_bits == 52 ? 23 : 10;
+        uint64 const one = 1;
+        if(!w || q < _::decimal_to_float_power5_min)
+            return 0;
+        if(q > _::decimal_to_float_power5_max)
+            return static_cast<uint64>(infinity) << mantissa_bits;
+        int zeros = 0;
+        while(!(w >> 63)) {
+            w <<= 1;
+            ++zeros;
+        }
+        auto power5 = _::power5(q);
+        uint64 high, low = _::shortest_multiply(w, power5[0], high);
+        uint64 const precision_mask = static_cast<uint64>(-1) >> (mantissa_bits + 3);
+        if((high & precision_mask) == precision_mask) {
+            // the low bits could be wrong, use the next 64 bits of the power too
+            uint64 high2;
+            _::shortest_multiply(w, power5[1], high2);
+            low += high2;
+            high += low < high2;
+        }
+        unsigned const
+            upper = static_cast<unsigned>(high >> 63),
+            shift = upper + 64 - mantissa_bits - 3;
+        uint64 mantissa = high >> shift;
+        // floor(log2(10^q)) + 63
+        int power2 = (q >= 0 ? (217706 * q) >> 16 : -((-217706 * q + 65535) >> 16)) + 63 + static_cast<int>(upper) - zeros + type::bias;
+        if(power2 <= 0) {
+            // subnormal, can round up to the smallest normal
+            if(-power2 + 1 >= 64)
+                return 0;
+            mantissa >>= -power2 + 1;
+            mantissa += mantissa & 1;
+            return mantissa >> 1;
+        }
+        if(low <= 1 && q >= round_even_min && q <= round_even_max && (mantissa & 3) == 1 && (mantissa << shift) == high)
+            mantissa &= ~one; // exactly halfway, round to even
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if(mantissa >= (one << (mantissa_bits + 1))) {
+            mantissa = one << mantissa_bits;
+            ++power2;
+        }
+        mantissa &= ~(one << mantissa_bits);
+        if(power2 >= infinity)
+            return static_cast<uint64>(infinity) << mantissa_bits;
+        return mantissa | (static_cast<uint64>(power2) << mantissa_bits);
+    }
+
+    template<typename iterator_>
+    static uint64 round_big(iterator_ begin, iterator_ end, int exponent, bool more, uint64 bits) {
+        // the number is between the float bits and bits + 1. compare it to the halfway point
+        unsigned constexpr mantissa_bits = type::mantissa_bits;
+        uint64 m = bits & ((static_cast<uint64>(1) << mantissa_bits) - 1);
+        int e2 = static_cast<int>(bits >> mantissa_bits);
+        if(e2) {
+            m |= static_cast<uint64>(1) << mantissa_bits;
+            e2 -= type::bias + static_cast<int>(mantissa_bits);
+        }
+        else
+            e2 = 1 - type::bias - static_cast<int>(mantissa_bits);
+        // halfway is (2 * m + 1) * 2^(e2 - 1)
+        _::decimal_to_float_big digits, halfway;
+        uint64 const h = 2 * m + 1;
+        halfway.multiply_add(1, static_cast<_::shortest_uint32>(h >> 32));
+        halfway.shift_left(32);
+        halfway.multiply_add(1, static_cast<_::shortest_uint32>(h & 0xffffffffu));
+        // the digits * 10^q
+        int q = exponent;
+        unsigned n = 0, chunk_digits = 0;
+        _::shortest_uint32 chunk = 0, chunk_multiply = 1;
+        for(; begin != end; ++begin) {
+            if(n == digits_max) {
+                ++q;
+                more = more || *begin;
+                continue;
+            }
+            ++n;
+            chunk = chunk * 10 + static_cast<unsigned>(*begin);
+            chunk_multiply *= 10;
+            if(++chunk_digits == 9) {
+                digits.multiply_add(chunk_multiply, chunk);
+                chunk = chunk_digits = 0;
+                chunk_multiply = 1;
+            }
+        }
+        if(chunk_digits)
+            digits.multiply_add(chunk_multiply, chunk);
+        // digits * 10^q compared to halfway * 2^(e2 - 1) is the same as
+        // digits * 5^q compared to halfway * 2^(e2 - 1 - q)
+        if(q >= 0)
+            digits.multiply_power5(static_cast<unsigned>(q));
+        else
+            halfway.multiply_power5(static_cast<unsigned>(-q));
+        int shift = e2 - 1 - q;
+        if(shift >= 0)
+            halfway.shift_left(static_cast<unsigned>(shift));
+        else
+            digits.shift_left(static_cast<unsigned>(-shift));
+        int c = digits.compare(halfway);
+        if(c > 0 || (c == 0 && (more || (m & 1))))
+            ++bits;
+        return bits;
+    }
+
+    void set(uint64 bits) {
+        using uint = typename type::uint;
+        uint u = static_cast<uint>(bits);
+        auto fb = static_cast<unsigned char*>(static_cast<void*>(&my));
+        auto ub = static_cast<unsigned char const*>(static_cast<void const*>(&u)), ue = ub + sizeof(u);
+        do *fb++ = *ub++; while(ub != ue);
+    }
+};
+
+}}
+#endif
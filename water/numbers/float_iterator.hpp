@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -17,6 +17,8 @@ leading_zeros makes this return that many 0 before the number
 digits limits the number of digits, after that this retirns 0
 round_up will round the last digit up
 
+it can also iterate over the digits of an integer, used for the shortest digits
+
 */
 
 template<typename float_>
@@ -36,7 +38,9 @@ private:
     float_ my = 0;
     uint_ mydigits = 0;
     uint_ mydivide = 1;
+    uint_ myinteger = 0;
     unsigned
+        myinteger_digits = 0,
         mybase = 10,
         mydigits_max = 0,
         myat = 0,
@@ -65,6 +69,16 @@ public:
         if(!my0) fill();
     }
 
+    // the integer_digits digits of integer after leading_zeros zeros, then 0 forever
+    float_iterator(uint_ integer, unsigned integer_digits, unsigned base, unsigned leading_zeros) :
+        myinteger(integer),
+        myinteger_digits(integer_digits),
+        mybase(base),
+        my0(leading_zeros)
+    {
+        if(!my0) fill();
+    }
+
     explicit float_iterator(unsigned at) : // use this to make end
         myat(at)
     {}
@@ -108,6 +122,14 @@ public:
 private:
 
     void fill() {
+        if(myinteger_digits) {
+            mydigits = myinteger;
+            mydivide = 1;
+            while(--myinteger_digits)
+                mydivide *= mybase;
+            mydigits_max = 1; // my is 0, so the next fill is zeros
+            return;
+        }
         bool first = mydigits_max == 0; // my is 1.23 the first time, then 0.123
         if(first)
             mydigits_max = max_digits<float_>(mybase);
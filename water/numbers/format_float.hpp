@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -10,6 +10,7 @@
 #include <water/numbers/split_mantissa_exponent.hpp>
 #include <water/numbers/round_mantissa_exponent.hpp>
 #include <water/numbers/settings.hpp>
+#include <water/numbers/shortest.hpp>
 namespace water { namespace numbers {
 
 /*
@@ -32,6 +33,9 @@ for double and long double, but it depends on numeric_limits<type>::digits10.
 
 For base != 10, the default precision is to write all digits the type can represent.
 
+With shortest(true) base 10 is written with the fewest digits that read back as exactly the same
+value, see shortest.hpp. The exponent form is used like with the default precision.
+
 */
 
 
@@ -74,6 +78,7 @@ private:
     bool mytrailing0 = false;
     bool mybase_prefix_suffix = true;
     bool myscientific = false;
+    bool myshortest = false;
 
 private:
     static constexpr int no_exponent_min_limit(int a) {
@@ -107,7 +112,8 @@ public:
         myplus{a.plus()},
         mytrailing0{a.trailing_zeros()},
         mybase_prefix_suffix{a.base_prefix_suffix()},
-        myscientific{a.scientific()}
+        myscientific{a.scientific()},
+        myshortest{a.shortest()}
     {}
 
     format_float& base(unsigned a) {
@@ -171,6 +177,12 @@ public:
         return *this;
     }
 
+    format_float& shortest(bool a) {
+        // base 10 only. fewest digits that read back as the same value, precision is not used
+        myshortest = a;
+        return *this;
+    }
+
     format_float& trailing_zeros(bool a) {
         // 1.23000 instead of 1.23
         mytrailing0 = a;
@@ -189,20 +201,48 @@ public:
             m.nan(true);
             f = signbit(f) ? -static_cast<float_>(0) : static_cast<float_>(0);
         }
-        split_mantissa_exponent<double_> x(f, mybase);
+        numbers::shortest s;
+        if(myshortest && mybase == 10)
+            s = numbers::shortest{f}; // not if the type cannot
+        split_mantissa_exponent<double_> x(s ? static_cast<float_>(0) : f, mybase);
+        if(s)
+            x.minus = s.minus();
         m.base(mybase);
         m.base_prefix_suffix(mybase != 10 && mybase_prefix_suffix);
         m.sign(x.minus ? -1 : myplus ? 1 : 0);
         m.point_at(1);
         unsigned leading0 = 0;
-        bool zero = x.mantissa == 0;
+        bool zero = s ? s.digits() == 0 : x.mantissa == 0;
         bool exponent_form = true;
+        bool trailing0 = mytrailing0 && !myshortest;
         numbers::round_mantissa_exponent<double_> round;
         if(!zero) {
             // after this if
             // - m.digits() is set or zero = true
             // - rounded
-            if(mybase == 10 && myfraction_digits) {
+            if(s) {
+                // the digits are exact. x.exponent is for the first digit, like 1.23e4
+                x.exponent = s.exponent() + static_cast<int>(s.size()) - 1;
+                m.digits(s.size());
+                if(x.exponent >= 0) {
+                    int no_exponent_max = my_no_exponent_max >= 0 ? my_no_exponent_max : static_cast<int>(float_precision<float_>(10) - 1);
+                    if(no_exponent_max && x.exponent <= no_exponent_max) {
+                        exponent_form = false;
+                        unsigned point_at = static_cast<unsigned>(x.exponent) + 1;
+                        if(point_at > m.digits()) {
+                            m.digits(point_at);
+                            point_at = 0;
+                        }
+                        m.point_at(point_at);
+                    }
+                }
+                else if(x.exponent >= my_no_exponent_min) {
+                    exponent_form = false;
+                    leading0 = static_cast<unsigned>(-x.exponent);
+                    m.digits(leading0 + s.size());
+                }
+            }
+            else if(mybase == 10 && myfraction_digits && !myshortest) {
                 // myprecision is the fraction digits, rounding depends on exponent.
                 // can become zero if no_exponent_min is lower than -(myprecision + 1)
                 if(x.exponent >= 0) {
@@ -215,7 +255,7 @@ public:
                             exponent_form = false;
                             unsigned point_at = static_cast<unsigned>(x.exponent) + 1;
                             m.digits(
-                                mytrailing0 ? digits :
+                                trailing0 ? digits :
                                 round.digits() > point_at ? round.digits() :
                                 point_at
                             );
@@ -225,7 +265,7 @@ public:
                     else
                         round(x.mantissa, x.exponent, mybase, myprecision + 1);
                     if(exponent_form)
-                        m.digits(mytrailing0 ? myprecision + 1 : round.digits());
+                        m.digits(trailing0 ? myprecision + 1 : round.digits());
                 }
                 else if(x.exponent >= my_no_exponent_min) {
                     // exponent < 0. the number can be zero if my_no_exponent_min is < -myprecision
@@ -238,7 +278,7 @@ public:
                         leading0 = static_cast<unsigned>(-x.exponent);
                         if(leading0 < myprecision + 1) {
                             exponent_form = false;
-                            m.digits(mytrailing0 ? myprecision + 1 : leading0 + round.digits());
+                            m.digits(trailing0 ? myprecision + 1 : leading0 + round.digits());
                         }
                         else
                             zero = true;
@@ -247,9 +287,12 @@ public:
             }
             else {
                 // always round to myprecision
-                unsigned digits = myprecision ? myprecision : float_precision<float_>(mybase); // never 0
+                unsigned digits =
+                    myshortest && mybase == 10 ? static_cast<unsigned>(numeric_limits<float_>::max_digits10) : // the type cannot use shortest
+                    myprecision ? myprecision :
+                    float_precision<float_>(mybase); // never 0
                 round(x.mantissa, x.exponent, mybase, digits);
-                m.digits(mytrailing0 ? digits : round.digits());
+                m.digits(trailing0 ? digits : round.digits());
                 if(mybase == 10) {
                     if(x.exponent >= 0) {
                         int no_exponent_max = my_no_exponent_max >= 0 ? my_no_exponent_max : static_cast<int>(digits - 1);
@@ -270,14 +313,17 @@ public:
                         // 0.0123
                         exponent_form = false;
                         leading0 = static_cast<unsigned>(-x.exponent);
-                        m.digits(leading0 + (mytrailing0 ? digits : round.digits()));
+                        m.digits(leading0 + (trailing0 ? digits : round.digits()));
                     }
                 }
             }
         }
         if(!zero) {
             // +-1.2345e+-123
-            m.begin(float_iterator<double_>(x.mantissa, mybase, leading0, round.digits(), round.up()));
+            m.begin(
+                s ? float_iterator<double_>(s.digits(), s.size(), mybase, leading0) :
+                float_iterator<double_>(x.mantissa, mybase, leading0, round.digits(), round.up())
+            );
             if(exponent_form && myscientific && mybase == 10 && (x.exponent % 3)) {
                 // scientific: reduce exponent and move point to the right.
                 int em = (x.exponent % 3);
@@ -305,7 +351,7 @@ public:
             // +-0.00e+-0
             x.exponent = 0;
             m.digits(
-                !mytrailing0 ? 1 :
+                !trailing0 ? 1 :
                 myfraction_digits ? myprecision + 1 :
                 myprecision ? myprecision :
                 float_precision<float_>(mybase)
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -6,16 +6,30 @@
 #define WATER_NUMBERS_PARSED_TO_FLOAT_HPP
 #include <water/numbers/parsed_to_int.hpp>
 #include <water/numbers/max_digits.hpp>
+#include <water/numbers/decimal_to_float.hpp>
 namespace water { namespace numbers {
 
 /*
 
 convert parsed mantissa + exponent to float
 
+base 10 float and double are correctly rounded using decimal_to_float, if the mantissa is a
+parsed<parsed_to_float_digits<float_>()> or larger. Other bases and types multiply with pow, and can
+be a little wrong.
+
 numeric_limits lowest() is better than -max() ?
 
 */
 
+template<typename float_>
+constexpr unsigned parsed_to_float_digits() {
+    // mantissa digits to keep. base 10 needs all digits decimal_to_float uses, more digits are only
+    // seen by parsed::overflow()
+    return shortest_can<float_> && decimal_to_float<float_>::digits_max > max_binary_digits<float_>() + 8 ?
+        decimal_to_float<float_>::digits_max :
+        max_binary_digits<float_>() + 8;
+}
+
 template<typename float_>
 class parsed_to_float
 {
@@ -44,6 +58,8 @@ public:
             my = limits::quiet_NaN();
         else if(mantissa.base() < 2)
             myerror = true;
+        else if(mantissa.base() == 10 && (exponent_power_of == 0 || exponent_power_of == 10) && decimal(mantissa, exponent))
+            ;
         else {
             // mantissa
             double_ m = 0;
@@ -178,6 +194,50 @@ public:
 
 private:
 
+    template<typename mantissa_, typename exponent_>
+    bool decimal(mantissa_ const& mantissa, exponent_ const& exponent) {
+        // returns false if decimal_to_float cannot convert to float_
+        if(!shortest_can<float_>)
+            return false;
+        auto digits = mantissa.digits();
+        auto
+            d = digits.begin(),
+            de = digits.end();
+        ___water_assert((d == de || *d) && "first digit must not be 0");
+        while(d != de && !de[-1]) --de; // cut zeros at the end
+        unsigned digits_used = static_cast<unsigned>(de - d);
+        // exponent of the last digit. the unsigned values are limited to int max
+        long long e = static_cast<long long>(mantissa.point_at()) - static_cast<long long>(mantissa.leading_zeros()) - digits_used;
+        if(exponent.anything()) {
+            parsed_to_int<int> from(exponent);
+            if(from.overflow())
+                e = static_cast<int>(from) < 0 ? numeric_limits<int>::min() : numeric_limits<int>::max();
+            else if(from.error()) {
+                myerror = true;
+                return true;
+            }
+            else {
+                e += static_cast<int>(from);
+                myinexact = from.inexact();
+            }
+        }
+        if(e < numeric_limits<int>::min())
+            e = numeric_limits<int>::min();
+        else if(e > numeric_limits<int>::max())
+            e = numeric_limits<int>::max();
+        decimal_to_float<float_> f(d, de, static_cast<int>(e), mantissa.overflow());
+        if(!f)
+            return false;
+        my = f;
+        myoverflow = isinf_strict(my);
+        if(!myinexact && !myoverflow)
+            myinexact =
+                (my == 0 && digits_used) || // too small
+                mantissa.overflow() ||
+                digits_used > max_digits<float_>(10);
+        return true;
+    }
+
     void pow_do(double_& m, double_ b, int e) {
         // if e is very small or large, pow can become 0, subnormal or infinity
         double_ p = pow(b, static_cast<double_>(e));
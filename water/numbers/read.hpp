@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -145,7 +145,8 @@ private:
         reset();
         auto copy = myparse;
         copy.integer(false);
-        parsed<max_binary_digits<type_>() + 8> m;
+        unsigned constexpr m_digits = parsed_to_float_digits<type_>();
+        parsed<m_digits> m;
         // max_binary_digits<int>() + 8 on a separate line from parsed<> avoided an internal compiler error on visual c++ 15.7.5
         unsigned constexpr e_digits = max_binary_digits<int>() + 8;
         parsed<e_digits> e;
@@ -1,4 +1,4 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -26,7 +26,8 @@ namespace setting {
         group = 1 << 11, // 1 000 000
         digit_before_point = 1 << 12, // parser
         digit_after_point = 1 << 13, // parser
-        space = 1 << 14; // parser
+        space = 1 << 14, // parser
+        shortest = 1 << 15; // shortest digits that read back as the same floatingpoint
 }
 
 class settings
@@ -194,6 +195,14 @@ public:
         return bit(setting::scientific, a);
     }
 
+    settings& shortest(bool a) {
+        // write base 10 floatingpoint with the fewest digits that will read back as exactly the same value.
+        // precision(), fraction_digits() and trailing_zeros() are not used. if the type is not IEEE 754
+        // float or double it is rounded to numeric_limits<type>::max_digits10 digits instead.
+        // read: no effect
+        return bit(setting::shortest, a);
+    }
+
     settings& digit_after_point(bool a) {
         // read: require a digit after the decimal point. "123.e1" is read as "123.0e1" if false, "123" if true
         // write: no effect
@@ -274,6 +283,10 @@ public:
         return bit(setting::scientific);
     }
 
+    bool shortest() const {
+        return bit(setting::shortest);
+    }
+
     bool space() const {
         return bit(setting::space);
     }
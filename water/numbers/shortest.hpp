@@ -0,0 +1,357 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_NUMBERS_SHORTEST_HPP
+#define WATER_NUMBERS_SHORTEST_HPP
+#include <water/water.hpp>
+#include <water/int.hpp>
+#include <water/numeric_limits.hpp>
+#include <water/cmath.hpp>
+#include <water/numbers/power5.hpp>
+namespace water { namespace numbers {
+
+/*
+
+Find the shortest decimal number that converts back to exactly the same float or double, using only
+integer math. This is the Ryu algorithm by Ulf Adams, https://github.com/ulfjack/ryu
+
+    shortest s(1.23);
+    if(s) // s.digits() == 123, s.exponent() == -2, s.size() == 3
+
+If there are many shortest decimals, this is the one closest to the float. The float types must be
+IEEE 754 32 or 64 bit, shortest_can<float_> is false for other types and shortest will not work.
+long double works only if it is the same as double.
+
+The algorithm multiplies with 125 bit powers of 5. They come from the 128 bit table in power5.hpp,
+that decimal_to_float.hpp uses too.
+
+Used by format_float when settings::shortest(true), by xtr with number_shortest, and by
+json::number when converting from double.
+
+*/
+
+namespace _ {
+
+    template<
+        typename float_,
+        bool = numeric_limits<float_>::is_iec559 && numeric_limits<float_>::radix == 2,
+        int digits_ = numeric_limits<float_>::digits
+    >
+    struct shortest_float {
+        static bool constexpr can = false;
+    };
+
+    template<typename float_>
+    struct shortest_float<float_, true, 24> {
+        static bool constexpr can = sizeof(float_) == 4 && !equal<uint_bits<32>, void>;
+        using uint = uint_bits<32>;
+        static unsigned constexpr
+            mantissa_bits = 23,
+            exponent_bits = 8;
+        static int constexpr bias = 127;
+    };
+
+    template<typename float_>
+    struct shortest_float<float_, true, 53> {
+        static bool constexpr can = sizeof(float_) == 8 && !equal<uint_bits<64>, void>;
+        using uint = uint_bits<64>;
+        static unsigned constexpr
+            mantissa_bits = 52,
+            exponent_bits = 11;
+        static int constexpr bias = 1023;
+    };
+
+    using shortest_uint64 = uint_bits_at_least<64>;
+    using shortest_uint32 = uint_bits_at_least<32>;
+
+    inline shortest_uint64 shortest_multiply(shortest_uint64 a, shortest_uint64 b, shortest_uint64& high) {
+        // return the low 64 bits of a * b, and the high 64 bits in high
+        #ifdef __SIZEOF_INT128__
+        __extension__ using uint128 = unsigned __int128;
+        uint128 r = static_cast<uint128>(a) * b;
+        high = static_cast<shortest_uint64>(r >> 64);
+        return static_cast<shortest_uint64>(r);
+        #else
+        shortest_uint64 const
+            mask = 0xffffffffu,
+            a0 = a & mask,
+            a1 = a >> 32,
+            b0 = b & mask,
+            b1 = b >> 32,
+            p00 = a0 * b0,
+            p01 = a0 * b1,
+            p10 = a1 * b0,
+            p11 = a1 * b1,
+            middle = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+        high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+        return (middle << 32) | (p00 & mask);
+        #endif
+    }
+
+    unsigned constexpr shortest_bits = 125;
+
+    struct shortest_power {
+        shortest_uint64 my[2]; // low 64 bits first
+    };
+
+    inline shortest_power shortest_pow5(unsigned i) {
+        // top 125 bits of 5^i, i <= 325
+        auto p = power5(static_cast<int>(i));
+        return {{(p[1] >> 3) | (p[0] << 61), p[0] >> 3}};
+    }
+
+    inline shortest_power shortest_pow5_inverse(unsigned i) {
+        // top 125 bits of 1 / 5^i rounded down + 1, i <= 291. 2^125 + 1 if i is 0
+        if(!i)
+            return {{1, static_cast<shortest_uint64>(1) << 61}};
+        // power5 is rounded down + 1 if i <= 27, remove that first
+        auto p = power5(-static_cast<int>(i));
+        shortest_uint64
+            more = i <= 27,
+            low = p[1] - more,
+            high = p[0] - (p[1] < more);
+        low = ((low >> 3) | (high << 61)) + 1;
+        return {{low, (high >> 3) + (low == 0)}};
+    }
+
+    inline unsigned shortest_pow5_bits(int e) {
+        // ceil(log2(5^e)), or 1 if e is 0
+        return static_cast<unsigned>(((e * 1217359) >> 19) + 1);
+    }
+
+    inline unsigned shortest_log10_pow2(int e) {
+        // floor(log10(2^e))
+        return static_cast<unsigned>((e * 78913) >> 18);
+    }
+
+    inline unsigned shortest_log10_pow5(int e) {
+        // floor(log10(5^e))
+        return static_cast<unsigned>((e * 732923) >> 20);
+    }
+
+    inline bool shortest_multiple_of_pow5(shortest_uint64 a, unsigned p) {
+        unsigned count = 0;
+        while(a && a % 5 == 0) {
+            a /= 5;
+            if(++count >= p)
+                return true;
+        }
+        return count >= p;
+    }
+
+    inline bool shortest_multiple_of_pow2(shortest_uint64 a, unsigned p) {
+        return (a & ((static_cast<shortest_uint64>(1) << p) - 1)) == 0;
+    }
+
+    inline shortest_uint64 shortest_multiply_shift(shortest_uint64 m, shortest_uint64 const* multiply, int shift) {
+        // (m * multiply) >> shift, where 64 < shift < 128
+        shortest_uint64 high0, high1;
+        shortest_multiply(m, multiply[0], high0);
+        shortest_uint64 low1 = shortest_multiply(m, multiply[1], high1);
+        shortest_uint64 sum = high0 + low1;
+        high1 += sum < high0;
+        unsigned s = static_cast<unsigned>(shift - 64);
+        return (sum >> s) | (high1 << (64 - s));
+    }
+
+}
+
+template<typename float_>
+bool constexpr shortest_can = _::shortest_float<float_>::can;
+
+class shortest
+{
+    using uint64 = _::shortest_uint64;
+
+    uint64 mydigits = 0;
+    int myexponent = 0;
+    unsigned mysize = 0;
+    bool myminus = false;
+
+public:
+    shortest() = default;
+
+    template<typename float_>
+    explicit shortest(float_ f) {
+        // nan and infinity are not possible, size() is 0 then. also 0 if shortest_can<float_> is false
+        from(f, ifel<shortest_can<float_>, int, char>{});
+    }
+
+    explicit operator bool() const {
+        // false if nan or infinity
+        return mysize != 0;
+    }
+
+    uint64 digits() const {
+        // the decimal digits, without trailing zeros. 0 if the float was 0
+        return mydigits;
+    }
+
+    int exponent() const {
+        // the float is digits() * 10^exponent()
+        return myexponent;
+    }
+
+    unsigned size() const {
+        // number of digits, 1 if the float was 0
+        return mysize;
+    }
+
+    bool minus() const {
+        // sign bit, also for -0
+        return myminus;
+    }
+
+private:
+    template<typename float_>
+    void from(float_, char) {}
+
+    template<typename float_>
+    void from(float_ f, int) {
+        using type = _::shortest_float<float_>;
+        using uint = typename type::uint;
+        uint u = 0;
+        auto ub = static_cast<unsigned char*>(static_cast<void*>(&u));
+        auto fb = static_cast<unsigned char const*>(static_cast<void const*>(&f)), fe = fb + sizeof(f);
+        do *ub++ = *fb++; while(fb != fe);
+        uint const exponent_max = (static_cast<uint>(1) << type::exponent_bits) - 1;
+        auto mantissa = static_cast<uint64>(u & ((static_cast<uint>(1) << type::mantissa_bits) - 1));
+        auto exponent = static_cast<unsigned>((u >> type::mantissa_bits) & exponent_max);
+        myminus = (u >> (type::mantissa_bits + type::exponent_bits)) != 0;
+        if(exponent == exponent_max)
+            return;
+        if(!exponent && !mantissa) {
+            mysize = 1;
+            return;
+        }
+        convert(mantissa, exponent, type::mantissa_bits, type::bias);
+    }
+
+    void convert(uint64 mantissa, unsigned exponent, unsigned mantissa_bits, int bias) {
+        using namespace _;
+        int e2;
+        uint64 m2;
+        if(!exponent) {
+            e2 = 1 - bias - static_cast<int>(mantissa_bits) - 2;
+            m2 = mantissa;
+        }
+        else {
+            e2 = static_cast<int>(exponent) - bias - static_cast<int>(mantissa_bits) - 2;
+            m2 = (static_cast<uint64>(1) << mantissa_bits) | mantissa;
+        }
+        bool const accept_bounds = (m2 & 1) == 0;
+
+        // the interval of decimals that convert back to this float is mm to mp, times 2^e2
+        uint64 const mv = 4 * m2;
+        unsigned const mm_shift = mantissa || exponent <= 1;
+        uint64 vr, vp, vm;
+        int e10;
+        bool
+            vm_trailing_zeros = false,
+            vr_trailing_zeros = false;
+        if(e2 >= 0) {
+            unsigned const q = shortest_log10_pow2(e2) - (e2 > 3);
+            e10 = static_cast<int>(q);
+            int const k = static_cast<int>(shortest_bits + shortest_pow5_bits(static_cast<int>(q))) - 1;
+            int const i = -e2 + static_cast<int>(q) + k;
+            auto const power = shortest_pow5_inverse(q);
+            vr = shortest_multiply_shift(4 * m2, power.my, i);
+            vp = shortest_multiply_shift(4 * m2 + 2, power.my, i);
+            vm = shortest_multiply_shift(4 * m2 - 1 - mm_shift, power.my, i);
+            if(q <= 21) {
+                // only one of mp, mv, mm can be a multiple of 5
+                if(mv % 5 == 0)
+                    vr_trailing_zeros = shortest_multiple_of_pow5(mv, q);
+                else if(accept_bounds)
+                    vm_trailing_zeros = shortest_multiple_of_pow5(mv - 1 - mm_shift, q);
+                else
+                    vp -= shortest_multiple_of_pow5(mv + 2, q);
+            }
+        }
+        else {
+            unsigned const q = shortest_log10_pow5(-e2) - (-e2 > 1);
+            e10 = static_cast<int>(q) + e2;
+            int const i = -e2 - static_cast<int>(q);
+            int const k = static_cast<int>(shortest_pow5_bits(i)) - static_cast<int>(shortest_bits);
+            int const j = static_cast<int>(q) - k;
+            auto const power = shortest_pow5(static_cast<unsigned>(i));
+            vr = shortest_multiply_shift(4 * m2, power.my, j);
+            vp = shortest_multiply_shift(4 * m2 + 2, power.my, j);
+            vm = shortest_multiply_shift(4 * m2 - 1 - mm_shift, power.my, j);
+            if(q <= 1) {
+                // mv has at least q trailing 0 bits, so vr has q trailing 0 digits
+                vr_trailing_zeros = true;
+                if(accept_bounds)
+                    vm_trailing_zeros = mm_shift == 1;
+                else
+                    --vp;
+            }
+            else if(q < 63)
+                vr_trailing_zeros = shortest_multiple_of_pow2(mv, q);
+        }
+
+        // remove digits while vp and vm are different
+        int removed = 0;
+        unsigned last_removed = 0;
+        uint64 output;
+        if(vm_trailing_zeros || vr_trailing_zeros) {
+            // rare
+            while(vp / 10 > vm / 10) {
+                vm_trailing_zeros = vm_trailing_zeros && vm % 10 == 0;
+                vr_trailing_zeros = vr_trailing_zeros && last_removed == 0;
+                last_removed = static_cast<unsigned>(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+            if(vm_trailing_zeros)
+                while(vm % 10 == 0) {
+                    vr_trailing_zeros = vr_trailing_zeros && last_removed == 0;
+                    last_removed = static_cast<unsigned>(vr % 10);
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                    ++removed;
+                }
+            if(vr_trailing_zeros && last_removed == 5 && vr % 2 == 0)
+                last_removed = 4; // round to even if exactly .5
+            output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+        }
+        else {
+            bool round_up = false;
+            if(vp / 100 > vm / 100) {
+                round_up = vr % 100 >= 50;
+                vr /= 100;
+                vp /= 100;
+                vm /= 100;
+                removed += 2;
+            }
+            while(vp / 10 > vm / 10) {
+                round_up = vr % 10 >= 5;
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+            output = vr + (vr == vm || round_up);
+        }
+        myexponent = e10 + removed;
+
+        // remove trailing zeros, ryu can leave them when the float is an integer
+        while(output && output % 10 == 0) {
+            output /= 10;
+            ++myexponent;
+        }
+        mydigits = output;
+        mysize = 1;
+        while(output >= 10) {
+            output /= 10;
+            ++mysize;
+        }
+    }
+};
+
+}}
+#endif
@@ -0,0 +1,125 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT_HPP
+#define WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT_HPP
+#include <water/numbers/tests/bits.hpp>
+#include <water/numbers/decimal_to_float.hpp>
+#include <water/cstring.hpp>
+namespace water { namespace numbers { namespace tests {
+
+/*
+
+decimal_to_float should be exactly the same as the compiler. the text is digits, optional point,
+optional exponent. the hard ones are close to halfway between two floats
+
+*/
+
+template<typename float_>
+bool decimal_to_float_equal(float_ a, char const* text) {
+    unsigned char digits[1024];
+    size_t size = 0;
+    int exponent = 0;
+    bool point = false;
+    auto t = text;
+    for(; *t && *t != 'e'; ++t)
+        if(*t == '.')
+            point = true;
+        else {
+            ___water_assert(size != sizeof(digits));
+            digits[size++] = static_cast<unsigned char>(*t - '0');
+            if(point)
+                --exponent;
+        }
+    if(*t == 'e') {
+        bool minus = *++t == '-';
+        if(minus || *t == '+')
+            ++t;
+        int e = 0;
+        while(*t)
+            e = e * 10 + (*t++ - '0');
+        exponent += minus ? -e : e;
+    }
+    decimal_to_float<float_> d(digits, digits + size, exponent);
+    if(!d)
+        return true; // not possible for this float type
+    float_ b = d;
+    if(a != b)
+        return false;
+    if(size > 19)
+        return true;
+    uint64_t w = 0;
+    for(size_t i = 0; i != size; ++i)
+        w = w * 10 + digits[i];
+    return static_cast<float_>(decimal_to_float<float_>(w, exponent)) == a;
+}
+
+template<typename float_>
+void decimal_to_float_list() {
+    struct value_text {
+        float_ value;
+        char const* text;
+    };
+    #define WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(a) {static_cast<float_>(a), #a}
+    value_text const list[] = {
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(0),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(1),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(0.1),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(123.456),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(9007199254740993),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(9007199254740995),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(123e40),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(1e23),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(8.98846567431158e307),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(1.7976931348623157e308),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(2.2250738585072011e-308),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(2.2250738585072012e-308),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(4.9406564584124654e-324),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(2.4703282292062328e-324),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(7.2057594037927933e16),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(9007199254740992.000000000000000000001),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(9007199254740993.000000000000000000001),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(1.00000005960464477539062499),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(1.000000059604644775390625),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(1.00000005960464477539062501),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(3.4028235677973366e38),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(7.0064923216240854e-46),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(7.0064923216240862e-46),
+        WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT(2.22507385850720113605740979670913197593481954635164564802342610972482222202107694551652952390813508791414915891303962110687008643869459464552765720740782062174337998814106326732925355228688137214901298112245145188984905722230728525513315575501591439747639798341180199932396254828901710708185069063066665599493827577257201576306269066333264756530000924588831643303777979186961204949739037782970490505108060994073026293712895895000358379996720725430436028407889577179615094551674824347103070260914462157228988025818254518032570701886087211312807951223342628836862232150377566662250398253433597456888442390026549819838548794829220689472168983109969836584681402285424333066033985088644580400103493397042756718644338377048603786162277173854562306587467901408672332763671875e-308),
+    };
+    #undef WATER_NUMBERS_TESTS_DECIMAL_TO_FLOAT
+    for(auto a : list)
+        ___water_test(decimal_to_float_equal(a.value, a.text));
+}
+
+inline void decimal_to_float_all() {
+    decimal_to_float_list<double>();
+
+    // float literals need f, so separate from the list above
+    ___water_test(decimal_to_float_equal(1.00000005960464477539062499f, "1.00000005960464477539062499"));
+    ___water_test(decimal_to_float_equal(1.000000059604644775390625f, "1.000000059604644775390625"));
+    ___water_test(decimal_to_float_equal(1.00000005960464477539062501f, "1.00000005960464477539062501"));
+    ___water_test(decimal_to_float_equal(3.4028235677973366e38f, "3.4028235677973366e38"));
+    ___water_test(decimal_to_float_equal(7.0064923216240854e-46f, "7.0064923216240854e-46"));
+    ___water_test(decimal_to_float_equal(7.0064923216240862e-46f, "7.0064923216240862e-46"));
+    ___water_test(decimal_to_float_equal(1.17549435e-38f, "1.17549435e-38"));
+    ___water_test(decimal_to_float_equal(16777217.f, "16777217"));
+    ___water_test(decimal_to_float_equal(0.1f, "0.1"));
+
+    // too large or small
+    ___water_test(isinf_strict(static_cast<double>(decimal_to_float<double>(1, 309))));
+    ___water_test(isinf_strict(static_cast<double>(decimal_to_float<double>(18, 307))));
+    ___water_test(static_cast<double>(decimal_to_float<double>(1, -400)) == 0);
+    ___water_test(static_cast<double>(decimal_to_float<double>(1, numeric_limits<int>::min())) == 0);
+    ___water_test(isinf_strict(static_cast<float>(decimal_to_float<float>(1, 39))));
+    ___water_test(static_cast<double>(decimal_to_float<double>(24703282292062327, -340)) == 0); // just below half of denorm_min
+
+    // more is true when there are digits after the last that are not 0
+    unsigned char const halfway[] {9, 0, 0, 7, 1, 9, 9, 2, 5, 4, 7, 4, 0, 9, 9, 3}; // 2^53 + 1
+    ___water_test(static_cast<double>(decimal_to_float<double>(halfway, halfway + sizeof(halfway), 0)) == 9007199254740992.);
+    ___water_test(static_cast<double>(decimal_to_float<double>(halfway, halfway + sizeof(halfway), 0, true)) == 9007199254740994.);
+}
+
+}}}
+#endif
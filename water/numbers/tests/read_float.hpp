@@ -1,4 +1,4 @@
-// Copyright 2023 Johan Paulsson
+// Copyright 2023-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -173,11 +173,64 @@ void read_float_list() {
         }
     }
     trace << "water::numbers::tests::read_float_list<" << read_float_name<float_>() << "> tests=" << tests << " exact=" << exact;
+    ___water_test(exact == tests || !shortest_can<float_>); // decimal_to_float is exact
 }
 
 
+inline void read_float_halfway() {
+    // exactly halfway between two doubles, with 62 to 130 digits. round to even, and up if there is
+    // a digit after that is not 0. (2m + 1) * 2^-k is (2m + 1) * 5^k * 10^-k
+    unsigned long long random = 1;
+    for(unsigned repeat = 0; repeat != 200; ++repeat) {
+        random = random * 6364136223846793005ull + 1442695040888963407ull;
+        unsigned long long m = (random >> 11) | (1ull << 52); // 53 bits
+        unsigned k = 70 + static_cast<unsigned>(random % 100);
+        // decimal digits of 2m + 1, least significant first, then multiply by 5 k times
+        unsigned char digits[256];
+        unsigned size = 0;
+        for(auto h = 2 * m + 1; h; h /= 10)
+            digits[size++] = static_cast<unsigned char>(h % 10);
+        for(unsigned i = 0; i != k; ++i) {
+            unsigned carry = 0;
+            for(unsigned d = 0; d != size; ++d) {
+                carry += digits[d] * 5u;
+                digits[d] = static_cast<unsigned char>(carry % 10);
+                carry /= 10;
+            }
+            if(carry)
+                digits[size++] = static_cast<unsigned char>(carry);
+        }
+        ___water_test(size > 61);
+        char text[300];
+        unsigned at = 0;
+        while(size)
+            text[at++] = static_cast<char>('0' + digits[--size]);
+        double
+            low = static_cast<double>(m),
+            high = static_cast<double>(m + 1);
+        for(unsigned i = 1; i != k; ++i) {
+            low *= .5;
+            high *= .5;
+        }
+        for(unsigned more = 0; more != 2; ++more) {
+            unsigned end = at;
+            if(more)
+                text[end++] = '1';
+            text[end++] = 'e';
+            text[end++] = '-';
+            int e = static_cast<int>(k) + static_cast<int>(more);
+            text[end++] = static_cast<char>('0' + e / 100);
+            text[end++] = static_cast<char>('0' + e / 10 % 10);
+            text[end++] = static_cast<char>('0' + e % 10);
+            read<double> r;
+            ___water_test(r(text, text + end) == text + end);
+            ___water_test(r.value() == (more || (m & 1) ? high : low));
+        }
+    }
+}
 
 inline void read_float_all() {
+    read_float_halfway();
     read_float_list<double>();
     read_float_list<float>();
     read_float_list<long double>();
@@ -0,0 +1,90 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_NUMBERS_TESTS_SHORTEST_HPP
+#define WATER_NUMBERS_TESTS_SHORTEST_HPP
+#include <water/numbers/tests/bits.hpp>
+#include <water/numbers/tests/format.hpp>
+namespace water { namespace numbers { namespace tests {
+
+/*
+
+test shortest digits, and writing with settings::shortest
+
+*/
+
+template<typename float_>
+void shortest_one(float_ f, unsigned long long digits, int exponent) {
+    shortest s{f};
+    ___water_test(s && s.digits() == digits && s.exponent() == exponent);
+    unsigned size = 1;
+    while(digits >= 10) {
+        digits /= 10;
+        ++size;
+    }
+    ___water_test(s.size() == size);
+}
+
+inline void shortest_all() {
+    shortest_one(0.1, 1, -1);
+    shortest_one(0.3, 3, -1);
+    shortest_one(1.0 / 3, 3333333333333333, -16);
+    shortest_one(2.0 / 3, 6666666666666666, -16);
+    shortest_one(1.0, 1, 0);
+    shortest_one(100.0, 1, 2);
+    shortest_one(123.456, 123456, -3);
+    shortest_one(1e23, 1, 23);
+    shortest_one(9007199254740993.0, 9007199254740992, 0);
+    shortest_one(5e-324, 5, -324);
+    shortest_one(2.2250738585072014e-308, 22250738585072014, -324);
+    shortest_one(1.7976931348623157e308, 17976931348623157, 292);
+    shortest_one(0.1f, 1, -1);
+    shortest_one(1.0f / 3, 33333334, -8);
+    shortest_one(16777216.f, 16777216, 0);
+    shortest_one(3.4028235e38f, 34028235, 31);
+    shortest_one(1e-45f, 1, -45);
+    shortest_one(-2.5, 25, -1);
+    ___water_test(shortest{-2.5}.minus() && !shortest{2.5}.minus());
+    ___water_test(shortest{0.0}.size() == 1 && !shortest{0.0}.digits());
+    ___water_test(shortest{-0.0}.minus());
+    ___water_test(!shortest{numeric_limits<double>::infinity()});
+    ___water_test(!shortest{numeric_limits<double>::quiet_NaN()});
+
+    format_one f;
+    f.settings.shortest(true);
+    f(0.0, "0");
+    f(-0.0, "0");
+    f(0.1, "1E-1");
+    f(-0.1, "-1E-1");
+    f(1.0 / 3, "3.333333333333333E-1");
+    f(0.1f, "1E-1");
+    f(1.0f / 3, "3.3333334E-1");
+    f(100.0, "100");
+    f(123.456, "123.456");
+    f(1e13, "10000000000000");
+    f(1e14, "1E14");
+    f(1.5e14, "1.5E14");
+    f(0.001, "1E-3");
+    f(1.2345678901234568e-5, "1.2345678901234568E-5");
+    f(1.7976931348623157e308, "1.7976931348623157E308");
+    f(5e-324, "5E-324");
+    f.settings.precision(3).trailing_zeros(true); // not used
+    f(0.125, "1.25E-1");
+    f(2.0, "2");
+    f.settings.no_exponent_min_max(-5, 20);
+    f(0.1, "0.1");
+    f(1.0f / 3, "0.33333334");
+    f(0.001, "0.001");
+    f(1e20, "100000000000000000000");
+    f(1.5e21, "1.5E21");
+    f.settings = settings{}.shortest(true).exponent().scientific(true);
+    f(1.25e4, "12.5E3");
+    f(1e5, "100E3");
+    f.settings = settings{}.shortest(true).plus(true);
+    f(-0.0, "-0");
+    f(0.5, "+5E-1");
+}
+
+}}}
+#endif
@@ -0,0 +1,85 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_SIMD_HPP
+#define WATER_SIMD_HPP
+#include <water/water.hpp>
+
+/*
+
+Detect SIMD instruction sets that can be used without checking the CPU at runtime, because the
+compiler was told to generate code for them (-msse2, -mavx2, /arch:AVX2 or a 64-bit x86 target).
+
+WATER_SIMD_SSE2
+WATER_SIMD_SSSE3
+WATER_SIMD_AVX2
+Defined if the instruction set can be used. If WATER_SIMD_AVX2 is defined WATER_SIMD_SSSE3 and
+WATER_SIMD_SSE2 are also defined.
+
+WATER_NO_SIMD
+Define to never use SIMD instructions, everything will use the plain C++ code instead.
+
+Code that uses this must always have a plain C++ fallback, and should give the exact same result
+with or without SIMD.
+
+*/
+
+#ifndef WATER_NO_SIMD
+    #if !defined(WATER_SIMD_SSE2) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+        #define WATER_SIMD_SSE2
+    #endif
+    #if !defined(WATER_SIMD_AVX2) && defined(WATER_SIMD_SSE2) && defined(__AVX2__)
+        #define WATER_SIMD_AVX2
+    #endif
+    #if !defined(WATER_SIMD_SSSE3) && defined(WATER_SIMD_SSE2) && (defined(__SSSE3__) || defined(WATER_SIMD_AVX2))
+        #define WATER_SIMD_SSSE3
+    #endif
+#endif
+
+#if defined(WATER_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(WATER_SIMD_SSSE3)
+    #include <tmmintrin.h>
+#elif defined(WATER_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+
+#if defined(WATER_COMPILER_MICROSOFT) && defined(WATER_SIMD_SSE2)
+    #include <intrin.h>
+#endif
+
+namespace water {
+
+inline unsigned simd_first_bit(unsigned a) {
+    // return the position of the lowest set bit in a. a cannot be 0
+    ___water_assert(a);
+    #if defined(WATER_COMPILER_GCC) || defined(WATER_COMPILER_CLANG)
+    return static_cast<unsigned>(__builtin_ctz(a));
+    #elif defined(WATER_COMPILER_MICROSOFT) && defined(WATER_SIMD_SSE2)
+    unsigned long r;
+    _BitScanForward(&r, a);
+    return static_cast<unsigned>(r);
+    #else
+    unsigned r = 0;
+    while(!(a & 1)) {
+        a >>= 1;
+        ++r;
+    }
+    return r;
+    #endif
+}
+
+inline unsigned simd_count_bits(unsigned a) {
+    // return the number of set bits in a
+    #if defined(WATER_COMPILER_GCC) || defined(WATER_COMPILER_CLANG)
+    return static_cast<unsigned>(__builtin_popcount(a));
+    #else
+    a = a - ((a >> 1) & 0x55555555u);
+    a = (a & 0x33333333u) + ((a >> 2) & 0x33333333u);
+    return (((a + (a >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24;
+    #endif
+}
+
+}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -748,6 +748,14 @@ public:
     void operator()(out<write_>& o) const { o.settings().scientific(my); }
 };
 
+class shortest : public callback<shortest> {
+    bool my;
+public:
+    explicit constexpr shortest(bool a) : my{a} {}
+    template<typename write_>
+    void operator()(out<write_>& o) const { o.settings().shortest(my); }
+};
+
 class trailing_zeros : public callback<trailing_zeros> {
     bool my;
 public:
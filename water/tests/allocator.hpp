@@ -1,4 +1,4 @@
-// Copyright 2018-2023 Johan Paulsson
+// Copyright 2018-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -10,6 +10,9 @@
 #include <water/allocator_malloc.hpp>
 #include <water/allocator_nothrow.hpp>
 #include <water/allocator_pointer.hpp>
+#ifdef WATER_SYSTEM_POSIX
+    #include <water/allocator_mmap.hpp>
+#endif
 namespace water { namespace tests {
 
 /*
@@ -91,6 +94,15 @@ inline void allocator_all() {
     allocator_test(allocator_nothrow{});
     allocator a;
     allocator_test(allocator_pointer_from(a));
+    #ifdef WATER_SYSTEM_POSIX
+    allocator_test(allocator_mmap<>{});
+    allocator_test(allocator_mmap_nothrow<>{});
+    allocator_test(allocator_mmap_nothrow<allocator_mmap_huge | allocator_mmap_populate>{});
+    allocator_test(allocator_mmap_nothrow<allocator_mmap_transparent>{});
+    // larger than a huge page, and not a multiple of the page size
+    allocator_size(allocator_mmap_nothrow<allocator_mmap_huge | allocator_mmap_transparent>{}, allocator_mmap_huge_page_size * 3 / 2 + 1);
+    allocator_size(allocator_mmap_nothrow<allocator_mmap_transparent>{}, allocator_mmap_huge_page_size * 2 + 123);
+    #endif
 }
 
 }}
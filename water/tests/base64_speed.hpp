@@ -0,0 +1,84 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_BASE64_SPEED_HPP
+#define WATER_TESTS_BASE64_SPEED_HPP
+#include <water/base64/base64.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to measure how many GB/s base64::encode and base64::decode can do for 1 MB and 1 KB of
+binary data.
+
+- pointer is encode and decode to a pointer, it uses SSSE3 or AVX2 if water/simd.hpp says it can
+- function is encode and decode with a function that gets each byte, this is the old code
+
+compile with -mssse3 or -mavx2 to see the difference.
+
+not automatic, look at the output.
+
+*/
+
+template<typename function_>
+double base64_speed_gbps(size_t bytes, function_&& function) {
+    // best of 5, GB/s of binary data
+    double best = 0;
+    for(unsigned repeat = 0; repeat != 5; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double gbps = static_cast<double>(bytes) / seconds / 1e9;
+        if(best < gbps)
+            best = gbps;
+    }
+    return best;
+}
+
+inline void base64_speed() {
+    str::out_trace to;
+    size_t const sizes[] = {1024 * 1024, 1024};
+    for(auto size : sizes) {
+        size_t const repeat = 64 * 1024 * 1024 / size;
+        vector<base64::byte>
+            binary(size),
+            text(base64::encode_size(size)),
+            decoded(size);
+        unsigned random = 1;
+        for(auto& b : binary) {
+            random = random * 1103515245u + 12345u;
+            b = static_cast<base64::byte>(random >> 16);
+        }
+        size_t check = 0;
+        to << size << " bytes\n";
+        to << "  encode pointer ..... " << base64_speed_gbps(size * repeat, [&] {
+            for(size_t r = 0; r != repeat; ++r)
+                check += base64::encode(text.begin(), binary.begin(), size);
+        }) << " GB/s\n";
+        to << "  encode function .... " << base64_speed_gbps(size * repeat, [&] {
+            for(size_t r = 0; r != repeat; ++r) {
+                base64::byte *t = text.begin();
+                base64::encode([&t](base64::byte a, base64::byte b, base64::byte c = base64::pad, base64::byte d = base64::pad) { t[0] = a; t[1] = b; t[2] = c; t[3] = d; t += 4; }, binary.begin(), size);
+                check += static_cast<size_t>(t - text.begin());
+            }
+        }) << " GB/s\n";
+        to << "  decode pointer ..... " << base64_speed_gbps(size * repeat, [&] {
+            for(size_t r = 0; r != repeat; ++r)
+                check += base64::decode(decoded.begin(), text.begin(), text.size());
+        }) << " GB/s\n";
+        to << "  decode function .... " << base64_speed_gbps(size * repeat, [&] {
+            for(size_t r = 0; r != repeat; ++r) {
+                base64::byte *d = decoded.begin();
+                check += base64::decode([&d](base64::byte a) { *d++ = a; }, text.begin(), text.size());
+            }
+        }) << " GB/s\n";
+        to << "  (" << check << ")\n";
+    }
+}
+
+}}
+#endif
@@ -0,0 +1,89 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_FLOAT_TO_STRING_SPEED_HPP
+#define WATER_TESTS_FLOAT_TO_STRING_SPEED_HPP
+#include <water/numbers/numbers.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/str/type_name.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to compare the speed of numbers::write with the default settings and with
+settings::shortest, and numbers::shortest alone.
+
+not automatic, look at the output.
+
+*/
+
+template<typename type_>
+class float_to_string_speed_values
+{
+    type_ my[1024];
+
+public:
+    float_to_string_speed_values() {
+        // spread over many exponents
+        type_ f = static_cast<type_>(1.2345678901234567890);
+        for(auto& m : my) {
+            m = f;
+            f *= static_cast<type_>(-7.654321);
+            if(f > static_cast<type_>(1e30) || f < static_cast<type_>(-1e30))
+                f = static_cast<type_>(3.14159265358979323846e-30);
+        }
+    }
+
+    type_ const* begin() const {
+        return my;
+    }
+
+    type_ const* end() const {
+        return my + sizeof(my) / sizeof(my[0]);
+    }
+};
+
+template<typename type_, typename function_>
+double float_to_string_speed_one(float_to_string_speed_values<type_> const& values, unsigned loops, function_&& function) {
+    auto start = std::chrono::steady_clock::now();
+    size_t sum = 0;
+    for(unsigned l = 0; l != loops; ++l)
+        for(auto v : values)
+            sum += function(v);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(!sum)
+        trace << "sum is 0";
+    return seconds * 1e9 / (static_cast<double>(loops) * static_cast<double>(values.end() - values.begin()));
+}
+
+template<typename type_, typename o_>
+void float_to_string_speed_for_type(str::out<o_>& to, unsigned loops) {
+    float_to_string_speed_values<type_> values;
+    char buffer[128];
+    numbers::settings const
+        precision{},
+        shortest = numbers::settings{}.shortest(true);
+
+    to << str::type_name<type_>() << '\n';
+    to << "numbers::write ........ " << float_to_string_speed_one(values, loops, [&](type_ v) {
+        return static_cast<size_t>(numbers::write<type_>{v, precision}(buffer, sizeof(buffer)) - buffer);
+    }) << " ns\n";
+    to << "numbers::write shortest " << float_to_string_speed_one(values, loops, [&](type_ v) {
+        return static_cast<size_t>(numbers::write<type_>{v, shortest}(buffer, sizeof(buffer)) - buffer);
+    }) << " ns\n";
+    to << "numbers::shortest ..... " << float_to_string_speed_one(values, loops, [&](type_ v) {
+        return static_cast<size_t>(numbers::shortest{v}.size());
+    }) << " ns\n";
+    to << '\n';
+}
+
+inline void float_to_string_speed(unsigned loops = 1000) {
+    str::out_trace to;
+    float_to_string_speed_for_type<double>(to, loops);
+    float_to_string_speed_for_type<float>(to, loops);
+}
+
+}}
+#endif
@@ -0,0 +1,129 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_JSON_WRITE_SPEED_HPP
+#define WATER_TESTS_JSON_WRITE_SPEED_HPP
+#include <water/json/json.hpp>
+#include <water/json/tests/write_scan.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to measure how many GB/s json::write_string can do, compared to json::tests::write_scan_reference
+that looks at one codepoint at a time like write_string did before write_string_plain.
+
+the strings are about 1 MB of html, base64, latin with some 2 byte sequences and cjk.
+
+then a document of 20000 objects is written with json::write, write_size and write, write_to_buffer
+and write_to_vector.
+
+compile with -mssse3 or -mavx2 to see the difference.
+
+not automatic, look at the output.
+
+*/
+
+template<typename function_>
+double json_write_speed_gbps(size_t bytes, function_&& function) {
+    // best of 5, GB/s of string
+    double best = 0;
+    for(unsigned repeat = 0; repeat != 5; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double gbps = static_cast<double>(bytes) / seconds / 1e9;
+        if(best < gbps)
+            best = gbps;
+    }
+    return best;
+}
+
+inline vector<json::uchar_t> json_write_speed_text(char const* sample) {
+    vector<json::uchar_t> r;
+    size_t sample_size = 0;
+    while(sample[sample_size])
+        ++sample_size;
+    while(r.size() < 1024 * 1024)
+        r.insert(r.end(), sample, sample + sample_size);
+    return r;
+}
+
+inline void json_write_speed_document() {
+    str::out_trace to;
+    json::memory<> memory;
+    auto root = memory.create().array(20000);
+    for(unsigned i = 0; i != 20000; ++i) {
+        auto o = root.push_back().object(6);
+        o.push_back().name("id").number(static_cast<int64_t>(i));
+        o.push_back().name("name").string("Somebody Somewhere");
+        o.push_back().name("score").number(i * 0.125);
+        o.push_back().name("active").boolean(i % 2 == 0);
+        o.push_back().name("html").string("<p class=\"text\">The quick brown fox jumps over the lazy dog.</p>");
+        auto tags = o.push_back().name("tags").array(2);
+        tags.push_back().string("first");
+        tags.push_back().string("second");
+    }
+    size_t
+        size = json::write_size(root),
+        check = 0;
+    vector<char> text;
+    text.reserve(size);
+    to << "document " << size << " bytes\n";
+    to << "  write to vector .......... " << json_write_speed_gbps(size, [&] {
+        text.clear();
+        check += json::write([&text](char const* b, char const* e) { text.insert(text.end(), b, e); }, root);
+    }) << " GB/s\n";
+    to << "  write_size and write ..... " << json_write_speed_gbps(size, [&] {
+        text.clear();
+        text.reserve(json::write_size(root));
+        check += json::write([&text](char const* b, char const* e) { text.insert(text.end(), b, e); }, root);
+    }) << " GB/s\n";
+    to << "  write_to_buffer .......... " << json_write_speed_gbps(size, [&] {
+        check += json::write_to_buffer(text.begin(), text.capacity(), root);
+    }) << " GB/s\n";
+    to << "  write_to_vector .......... " << json_write_speed_gbps(size, [&] {
+        text.clear();
+        check += json::write_to_vector(text, root);
+    }) << " GB/s\n";
+    to << "  (" << check << ")\n";
+}
+
+inline void json_write_speed() {
+    str::out_trace to;
+    struct {
+        char const
+            *name,
+            *sample;
+    } const corpora[] = {
+        {"html", "<p class=\"text\">The quick brown fox jumps over the lazy dog.</p>\n<a href=\"https://watercpp.com/\">link</a> "},
+        {"base64", "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZy4gVGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcw+/"},
+        {"latin", "Sm\xc3\xb6rg\xc3\xa5sbord, cr\xc3\xa8me br\xc3\xbbl\xc3\xa9\x65 och \xc3\xa5tta \xc3\xa4pplen p\xc3\xa5 bordet \xe2\x80\x94 mycket gott. "},
+        {"cjk", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe6\x96\x87\xe7\xab\xa0\xe3\x81\xa8\xe4\xb8\xad\xe6\x96\x87\xe7\x9a\x84\xe5\x8f\xa5\xe5\xad\x90\xe3\x80\x82"}
+    };
+    for(auto& c : corpora) {
+        auto text = json_write_speed_text(c.sample);
+        size_t
+            bytes = text.size(),
+            check = 0;
+        auto count = [&check](char const* b, char const* e) { check += static_cast<size_t>(e - b); };
+        to << c.name << ' ' << bytes << " bytes\n";
+        for(auto escape : {json::escape::minimal, json::escape::all}) {
+            char const *name = escape == json::escape::minimal ? "minimal" : "all    ";
+            to << "  write_string " << name << " ............ " << json_write_speed_gbps(bytes, [&] {
+                json::write_string(count, text.begin(), text.end(), escape);
+            }) << " GB/s\n";
+            to << "  write_scan_reference " << name << " .... " << json_write_speed_gbps(bytes, [&] {
+                json::tests::write_scan_reference(count, text.begin(), text.end(), escape);
+            }) << " GB/s\n";
+        }
+        to << "  (" << check << ")\n";
+    }
+    json_write_speed_document();
+}
+
+}}
+#endif
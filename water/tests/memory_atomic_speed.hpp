@@ -0,0 +1,143 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_MEMORY_ATOMIC_SPEED_HPP
+#define WATER_TESTS_MEMORY_ATOMIC_SPEED_HPP
+#include <water/test.hpp>
+#include <water/fixed/memory_atomic_cache.hpp>
+#include <water/threads/thread.hpp>
+#include <water/logs/buffer.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to see how fast fixed::memory_atomic allocate and free are when it has many blocks.
+
+- allocate until there are blocks blocks, then free and allocate every allocation again
+- a logs::buffer with small memory blocks gets a burst of messages, then it is flushed. flush frees
+  every piece of every message
+
+before block_index, free had to look at every block to find the one a pointer was in. the
+nanoseconds should not grow much with the number of blocks.
+
+- threads allocate 64 and free them again, directly from memory_atomic or with a
+  memory_atomic_cache for each thread
+
+not automatic, look at the output.
+
+*/
+
+struct memory_atomic_speed_output {
+    size_t lines = 0;
+    void start() noexcept {}
+    template<typename tag_>
+    char* prefix(char* begin, char*, tag_ const&) noexcept { return begin; }
+    void line(char const*, char const*) noexcept { ++lines; }
+    void stop() noexcept {}
+};
+
+inline double memory_atomic_speed_seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline double memory_atomic_speed_free(size_t blocks) {
+    // nanoseconds per free + allocate
+    size_t constexpr block_size = 16;
+    fixed::memory_atomic<> memory{64, block_size};
+    vector<void*> list;
+    while(memory.statistics().blocks < blocks) {
+        void *a = memory.allocate();
+        ___water_test(a);
+        if(!a)
+            return 0;
+        list.push_back(a);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned repeat = 0; repeat != 4; ++repeat)
+        for(auto& a : list) {
+            memory.free(a);
+            a = memory.allocate();
+        }
+    double seconds = memory_atomic_speed_seconds(start);
+    for(auto a : list)
+        memory.free(a);
+    return seconds * 1e9 / (static_cast<double>(list.size()) * 4);
+}
+
+inline void memory_atomic_speed_logs(str::out_trace& to, size_t messages) {
+    logs::buffer<memory_atomic_speed_output> log{0, 16};
+    for(unsigned repeat = 0; repeat != 2; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        for(size_t m = 0; m != messages; ++m)
+            log("a log message that is not very long, it fits in one piece");
+        double write = memory_atomic_speed_seconds(start);
+        start = std::chrono::steady_clock::now();
+        log.flush();
+        double flush = memory_atomic_speed_seconds(start);
+        to << "logs::buffer " << messages << " messages, " << log.memory_statistics().blocks << " blocks: "
+            << write * 1e9 / static_cast<double>(messages) << " ns per write, "
+            << flush * 1e9 / static_cast<double>(messages) << " ns per flushed message\n";
+    }
+}
+
+template<bool cache_>
+class memory_atomic_speed_threads
+{
+    fixed::memory_atomic<> mymemory{64};
+    unsigned myrepeat;
+
+public:
+    explicit memory_atomic_speed_threads(unsigned repeat) :
+        myrepeat{repeat}
+    {}
+
+    double operator()(unsigned threads) {
+        // nanoseconds per allocate + free
+        water::vector<threads::join_t> joins;
+        auto start = std::chrono::steady_clock::now();
+        for(unsigned t = 0; t != threads; ++t) {
+            threads::join_t j;
+            if(threads::run<threads::member_function<memory_atomic_speed_threads, &memory_atomic_speed_threads::run>>(this, j))
+                joins.push_back(j);
+        }
+        for(auto j : joins)
+            threads::join(j);
+        double seconds = memory_atomic_speed_seconds(start);
+        return seconds * 1e9 / (static_cast<double>(myrepeat) * 64 * joins.size());
+    }
+
+private:
+    void run() {
+        fixed::memory_atomic_cache<fixed::memory_atomic<>> cache{mymemory};
+        void *list[64];
+        for(unsigned r = 0; r != myrepeat; ++r) {
+            for(auto& l : list)
+                l = cache_ ? cache.allocate() : mymemory.allocate();
+            for(auto l : list)
+                cache_ ? cache.free(l) : mymemory.free(l);
+        }
+    }
+};
+
+inline void memory_atomic_speed() {
+    str::out_trace to;
+    size_t const blocks[] = {1, 10, 100, 1000, 10000};
+    for(auto b : blocks)
+        to << "memory_atomic " << b << " blocks: " << memory_atomic_speed_free(b) << " ns per free + allocate\n";
+    size_t const messages[] = {1000, 10000, 100000};
+    for(auto m : messages)
+        memory_atomic_speed_logs(to, m);
+    unsigned const threads[] = {1, 2, 4, 8};
+    for(auto t : threads) {
+        to << "threads " << t << '\n';
+        to << "memory_atomic ......... " << memory_atomic_speed_threads<false>{20000}(t) << " ns per allocate + free\n";
+        to << "memory_atomic_cache ... " << memory_atomic_speed_threads<true>{20000}(t) << " ns per allocate + free\n";
+    }
+}
+
+}}
+#endif
@@ -0,0 +1,157 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_POOL_SPEED_HPP
+#define WATER_TESTS_POOL_SPEED_HPP
+#include <water/threads/pool.hpp>
+#include <water/threads/condition.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to compare threads::pool with a thread pool that has one queue protected by a mutex and a
+condition variable.
+
+each function does a little work and runs two more functions, until there are 2^depth functions.
+
+not automatic, look at the output.
+
+*/
+
+class pool_speed_mutex
+{
+    struct task {
+        void (*call)(task*);
+        task *next;
+    };
+
+    template<typename function_>
+    struct task_copy : task {
+        function_ function;
+
+        task_copy(function_ const& f) :
+            task{&do_call, 0},
+            function{f}
+        {}
+
+        static void do_call(task *t) {
+            auto c = static_cast<task_copy*>(t);
+            c->function();
+            delete c;
+        }
+    };
+
+    threads::condition<> mycondition;
+    threads::mutex_for_condition<threads::condition<>> mylock;
+    task
+        *myfirst = 0,
+        *mylast = 0;
+    size_t myrunning = 0;
+    bool mystop = false;
+    water::vector<threads::join_t> mythreads;
+
+public:
+    explicit pool_speed_mutex(unsigned threads) {
+        for(unsigned i = 0; i != threads; ++i) {
+            threads::join_t j;
+            if(threads::run<threads::member_function<pool_speed_mutex, &pool_speed_mutex::work>>(this, j))
+                mythreads.push_back(j);
+        }
+    }
+
+    ~pool_speed_mutex() {
+        {
+            auto l = threads::lock_move(mylock);
+            mystop = true;
+        }
+        mycondition.wake_all();
+        for(auto j : mythreads)
+            threads::join(j);
+    }
+
+    template<typename function_>
+    void run(function_ function) {
+        auto t = new task_copy<function_>{function};
+        {
+            auto l = threads::lock_move(mylock);
+            ++myrunning;
+            if(mylast)
+                mylast->next = t;
+            else
+                myfirst = t;
+            mylast = t;
+        }
+        mycondition.wake();
+    }
+
+    void wait() {
+        auto l = threads::lock_move(mylock);
+        while(myrunning)
+            mycondition.wait(mylock);
+    }
+
+private:
+    void work() {
+        auto l = threads::lock_move(mylock);
+        while(true) {
+            if(myfirst) {
+                auto t = myfirst;
+                myfirst = t->next;
+                if(!myfirst)
+                    mylast = 0;
+                threads::unlock(mylock);
+                t->call(t);
+                threads::lock(mylock);
+                if(!--myrunning)
+                    mycondition.wake_all();
+            }
+            else if(mystop)
+                return;
+            else
+                mycondition.wait(mylock);
+        }
+    }
+};
+
+inline unsigned pool_speed_work(unsigned a) {
+    for(unsigned i = 0; i != 200; ++i)
+        a = a * 1664525u + 1013904223u;
+    return a;
+}
+
+template<typename pool_>
+void pool_speed_tree(pool_& pool, atomic<unsigned>& sum, unsigned depth) {
+    sum.fetch_add(pool_speed_work(depth), memory_order_relaxed);
+    if(depth) {
+        pool.run([&pool, &sum, depth] { pool_speed_tree(pool, sum, depth - 1); });
+        pool.run([&pool, &sum, depth] { pool_speed_tree(pool, sum, depth - 1); });
+    }
+}
+
+template<typename pool_>
+double pool_speed_one(unsigned threads, unsigned depth) {
+    pool_ pool{threads};
+    atomic<unsigned> sum{0};
+    auto start = std::chrono::steady_clock::now();
+    pool.run([&pool, &sum, depth] { pool_speed_tree(pool, sum, depth); });
+    pool.wait();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / static_cast<double>((2u << depth) - 1);
+}
+
+inline void pool_speed(unsigned depth = 20) {
+    str::out_trace to;
+    unsigned const threads[] = {1, 4, 16, 32, 64};
+    for(auto t : threads) {
+        to << "threads " << t << '\n';
+        to << "threads::pool ......... " << pool_speed_one<threads::pool>(t, depth) << " ns per function\n";
+        to << "mutex + condition pool  " << pool_speed_one<pool_speed_mutex>(t, depth) << " ns per function\n";
+    }
+}
+
+}}
+#endif
@@ -0,0 +1,120 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_QUEUE_SPEED_HPP
+#define WATER_TESTS_QUEUE_SPEED_HPP
+#include <water/test.hpp>
+#include <water/fixed/queue_wait.hpp>
+#include <water/threads/condition.hpp>
+#include <water/threads/thread.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to compare fixed::queue_mpsc_wait and fixed::queue_bounded_wait with a queue protected by a
+mutex and a condition variable.
+
+producer threads push numbers, one consumer thread pops them.
+
+not automatic, look at the output.
+
+*/
+
+class queue_speed_mutex
+{
+    threads::condition<> mycondition;
+    threads::mutex_for_condition<threads::condition<>> mylock;
+    water::vector<unsigned> myvalues;
+    size_t myfirst = 0;
+
+public:
+    bool push(unsigned a) {
+        {
+            auto l = threads::lock_move(mylock);
+            myvalues.push_back(a);
+        }
+        mycondition.wake();
+        return true;
+    }
+
+    void pop(unsigned& to) {
+        auto l = threads::lock_move(mylock);
+        while(myfirst == myvalues.size())
+            mycondition.wait(mylock);
+        to = myvalues[myfirst++];
+        if(myfirst == myvalues.size()) {
+            myvalues.clear();
+            myfirst = 0;
+        }
+    }
+};
+
+template<typename queue_>
+class queue_speed
+{
+    queue_ *myqueue;
+    unsigned myvalues;
+
+public:
+    queue_speed(queue_& queue, unsigned values) :
+        myqueue{&queue},
+        myvalues{values}
+    {}
+
+    void operator()() {
+        for(unsigned v = 1; v <= myvalues; ++v)
+            myqueue->push(v);
+    }
+};
+
+template<typename queue_>
+double queue_speed_one(queue_& queue, unsigned producers, unsigned values) {
+    // nanoseconds per value
+    queue_speed<queue_> producer{queue, values};
+    water::vector<threads::join_t> joins;
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned p = 0; p != producers; ++p) {
+        threads::join_t j;
+        if(threads::run(producer, j))
+            joins.push_back(j);
+    }
+    unsigned long long sum = 0;
+    size_t all = joins.size() * static_cast<size_t>(values);
+    for(size_t i = 0; i != all; ++i) {
+        unsigned v;
+        queue.pop(v);
+        sum += v;
+    }
+    for(auto j : joins)
+        threads::join(j);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ___water_test(sum == static_cast<unsigned long long>(values) * (values + 1) / 2 * joins.size());
+    return all ? seconds * 1e9 / static_cast<double>(all) : 0;
+}
+
+inline void queue_speed_all(unsigned values = 200000) {
+    str::out_trace to;
+    unsigned const producers[] = {1, 2, 4, 8};
+    for(auto p : producers) {
+        to << "producers " << p << '\n';
+        {
+            fixed::queue_mpsc_wait<unsigned> q;
+            to << "fixed::queue_mpsc_wait ... " << queue_speed_one(q, p, values) << " ns per value\n";
+        }
+        {
+            fixed::queue_bounded_wait<unsigned> q{1024};
+            to << "fixed::queue_bounded_wait  " << queue_speed_one(q, p, values) << " ns per value\n";
+        }
+        {
+            queue_speed_mutex q;
+            to << "mutex + condition queue .. " << queue_speed_one(q, p, values) << " ns per value\n";
+        }
+    }
+}
+
+}}
+#endif
@@ -0,0 +1,114 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_STRING_TO_FLOAT_SPEED_HPP
+#define WATER_TESTS_STRING_TO_FLOAT_SPEED_HPP
+#include <water/numbers/numbers.hpp>
+#include <water/json/json.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to measure the speed of numbers::read<double> and json::read + json::number::to_double.
+
+the text is a json array of numbers like canada.json, coordinates with up to 17 digits, or like
+twitter.json, mostly integers and short decimals.
+
+not automatic, look at the output.
+
+*/
+
+class string_to_float_speed_text
+{
+    water::vector<char> my;
+    size_t mycount = 0;
+
+public:
+    explicit string_to_float_speed_text(bool coordinates, size_t count = 100000) {
+        unsigned long long random = 12345;
+        numbers::settings const shortest = numbers::settings{}.shortest(true).no_exponent_min_max(-8, 20);
+        my.push_back('[');
+        for(size_t i = 0; i != count; ++i) {
+            random = random * 6364136223846793005ull + 1442695040888963407ull;
+            double d = static_cast<double>(random >> 11) / static_cast<double>(1ull << 53);
+            if(coordinates)
+                d = d * 360. - 180.; // -65.613616999999977
+            else if(random >> 62)
+                d = static_cast<double>((random >> 20) % 100000); // 12345
+            else
+                d = static_cast<double>((random >> 20) % 10000) / 100.; // 12.34
+            if(i)
+                my.push_back(',');
+            char buffer[64];
+            auto end = numbers::write<double>{d, shortest}(buffer, sizeof(buffer));
+            my.insert(my.end(), buffer, end);
+            ++mycount;
+        }
+        my.push_back(']');
+    }
+
+    char const* begin() const {
+        return my.begin();
+    }
+
+    char const* end() const {
+        return my.end();
+    }
+
+    size_t count() const {
+        return mycount;
+    }
+};
+
+template<typename function_>
+double string_to_float_speed_one(string_to_float_speed_text const& text, unsigned loops, function_&& function) {
+    // returns megabytes per second
+    auto start = std::chrono::steady_clock::now();
+    double sum = 0;
+    for(unsigned l = 0; l != loops; ++l)
+        sum += function();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(sum == 0)
+        trace << "sum is 0";
+    return static_cast<double>(text.end() - text.begin()) * loops / seconds / 1e6;
+}
+
+template<typename o_>
+void string_to_float_speed_for(str::out<o_>& to, char const* name, string_to_float_speed_text const& text, unsigned loops) {
+    to << name << ' ' << text.count() << " numbers " << static_cast<size_t>(text.end() - text.begin()) << " bytes\n";
+    to << "numbers::read<double> ... " << string_to_float_speed_one(text, loops, [&text] {
+        double sum = 0;
+        auto at = text.begin() + 1;
+        while(at < text.end()) {
+            numbers::read<double> r;
+            at = r(at, text.end());
+            sum += r.value();
+            ++at; // ,
+        }
+        return sum;
+    }) << " MB/s\n";
+    water::vector<char> copy;
+    to << "json::read + to_double .. " << string_to_float_speed_one(text, loops, [&text, &copy] {
+        copy.assign(text.begin(), text.end());
+        json::memory<> memory;
+        auto nodes = json::read_to_memory(memory)(copy.begin(), copy.size()).nodes();
+        double sum = 0;
+        for(auto n : nodes)
+            sum += n.number().to_double();
+        return sum;
+    }) << " MB/s\n";
+    to << '\n';
+}
+
+inline void string_to_float_speed(unsigned loops = 20) {
+    str::out_trace to;
+    string_to_float_speed_for(to, "canada", string_to_float_speed_text{true}, loops);
+    string_to_float_speed_for(to, "twitter", string_to_float_speed_text{false}, loops);
+}
+
+}}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2018-2023 Johan Paulsson
+// Copyright 2018-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -9,6 +9,7 @@
 #include <water/numeric_limits.hpp>
 #include <water/reverse_iterator.hpp>
 #include <water/char8.hpp>
+#include <water/allocator.hpp>
 namespace water { namespace tests {
 
 template<typename iterator1_, typename iterator2_>
@@ -46,6 +47,110 @@ void url_encode_test(char8_or_char const (&plain)[size1_], char8_or_char const (
     ___water_test(url_encode_decode_equal(e.begin(), e.end(), encoded + 0, encoded + size2_ - 1));
 }
 
+inline void url_encode_decode_pointers() {
+    // url_encode and url_decode with pointers should do the same as the iterators
+    unsigned char
+        text[300],
+        encoded[300 * 3],
+        decoded[300 * 3],
+        iterator[300 * 3];
+    unsigned random = 1;
+    for(unsigned repeat = 0; repeat != 400; ++repeat) {
+        size_t size = repeat % 300;
+        // mostly letters, or mostly anything
+        unsigned plain = repeat % 3;
+        for(auto& a : text) {
+            random = random * 1103515245u + 12345u;
+            unsigned r = random >> 16;
+            a = static_cast<unsigned char>(plain && r % 8 ? 'a' + r % 26 : r % 7 == 0 ? ' ' : r & 0xff);
+        }
+        for(bool plus : {false, true}) {
+            size_t s = url_encode_size(text, size, plus);
+            ___water_test(url_encode(encoded, text, size, plus) == s);
+            size_t i = 0;
+            if(plus)
+                for(url_encode_iterator<unsigned char const*, true> e{text, text + size}; e; ++e)
+                    iterator[i++] = *e;
+            else
+                for(url_encode_iterator<unsigned char const*> e{text, text + size}; e; ++e)
+                    iterator[i++] = *e;
+            ___water_test(i == s && url_encode_decode_equal(encoded + 0, encoded + s, iterator + 0, iterator + i));
+            ___water_test(url_decode_size(encoded, s) == size);
+            auto d = url_decode(decoded, encoded, s);
+            ___water_test(d && d.size() == size && d.used() == s && url_encode_decode_equal(decoded + 0, decoded + size, text + 0, text + size));
+            d = url_decode_in_place(encoded, s);
+            ___water_test(d && d.size() == size && url_encode_decode_equal(encoded + 0, encoded + size, text + 0, text + size));
+        }
+        // errors
+        size_t s = url_encode(encoded, text, size);
+        for(unsigned char bad : {'%', '/', ' ', '\n', 'g'}) {
+            if(!s)
+                break;
+            random = random * 1103515245u + 12345u;
+            size_t at = (random >> 16) % s;
+            unsigned char keep = encoded[at];
+            encoded[at] = bad;
+            auto d = url_decode(decoded, encoded, s);
+            auto r = url_decode_range_from(encoded + 0, encoded + s);
+            auto ri = r.begin();
+            size_t i = 0;
+            while(ri != r.end()) {
+                iterator[i++] = *ri;
+                ++ri;
+            }
+            ___water_test(d.error() == ri.error());
+            ___water_test(d.used() == static_cast<size_t>(ri.at() - encoded));
+            ___water_test(d.size() == i && url_encode_decode_equal(decoded + 0, decoded + i, iterator + 0, iterator + i));
+            encoded[at] = keep;
+        }
+    }
+}
+
+inline void url_decode_malformed_one(unsigned char const* text, size_t bytes) {
+    // decode to a heap buffer of exactly url_decode_size bytes. a buffer of 0 bytes is the end of 1 byte
+    size_t
+        size = url_decode_size(text, bytes),
+        allocated = size ? size : 1;
+    auto *to = static_cast<unsigned char*>(allocator{}.allocate(allocated));
+    auto d = url_decode(to + (allocated - size), text, bytes);
+    ___water_test(d.size() <= size);
+    ___water_test(d.error() || d.size() == size);
+    allocator{}.free(to, allocated);
+}
+
+inline void url_decode_malformed() {
+    char const* const texts[] = {
+        "aaaaaaaa%%%%",
+        "aaaaaaaaaaaaaaaaaaaaaaaa%%%%%%%%%%%%",
+        "%",
+        "%4",
+        "%%41",
+        "%4%41",
+        "%zz",
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa%4",
+        "aaaaaaaaaaaaaa%%aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+    };
+    for(auto t : texts) {
+        size_t bytes = 0;
+        while(t[bytes])
+            ++bytes;
+        url_decode_malformed_one(static_cast<unsigned char const*>(static_cast<void const*>(t)), bytes);
+    }
+    // random text of letters, % and hexadecimal digits
+    unsigned char const some[] = {'a', 'a', 'a', '%', '%', '4', 'F', 'g', '+'};
+    unsigned char text[80];
+    unsigned random = 1;
+    for(unsigned repeat = 0; repeat != 2000; ++repeat) {
+        random = random * 1103515245u + 12345u;
+        size_t bytes = (random >> 16) % sizeof(text);
+        for(size_t i = 0; i != bytes; ++i) {
+            random = random * 1103515245u + 12345u;
+            text[i] = some[(random >> 16) % sizeof(some)];
+        }
+        url_decode_malformed_one(text, bytes);
+    }
+}
+
 inline void url_encode_decode_all() {
     url_encode_test(
         u8"1234567890+!\"#$%&/()=?`^~*'-:;,._<>qwertyuiopasdfghjklzxcvbnmQWERTYUIOPASDFGHJKLZXCVBNM",
@@ -69,7 +174,10 @@ inline void url_encode_decode_all() {
 
     url_encode_decode(all_bytes + 0, all_bytes + 3);
     url_encode_decode(all_bytes + 0, all_bytes + sizeof(all_bytes));
-    url_encode_decode(reverse_iterator_from(all_bytes + sizeof(all_bytes)) - 1, reverse_iterator_from(all_bytes) - 1);
+    // rbegin is the last byte and rend is the byte before the first, reverse_bytes[0] is only there for rend
+    unsigned char reverse_bytes[1 + sizeof(all_bytes)] {};
+    for(size_t i = 0; i != sizeof(all_bytes); ++i) reverse_bytes[i + 1] = all_bytes[i];
+    url_encode_decode(reverse_iterator_from(reverse_bytes + sizeof(all_bytes)), reverse_iterator_from(reverse_bytes + 0));
     url_encode_decode(u8"hello world");
     url_encode_decode(u8"/hello/world/");
     url_encode_decode(u8"1234567890+-.,*qwertyuiopasdfghj klzxcvbnm;:_!\"\\#$%&/(){}=QWERTYUIOPASDFGHJKLZXCVBNM? ");
@@ -80,6 +188,8 @@ inline void url_encode_decode_all() {
     url_encode_decode(u8"a/");
     url_encode_decode(u8"aa/");
     url_encode_decode(u8"aaa/");
+    url_encode_decode_pointers();
+    url_decode_malformed();
 }
 
 }}
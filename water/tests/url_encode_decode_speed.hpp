@@ -0,0 +1,87 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_URL_ENCODE_DECODE_SPEED_HPP
+#define WATER_TESTS_URL_ENCODE_DECODE_SPEED_HPP
+#include <water/url_encode_decode.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to measure how many GB/s url_encode and url_decode with pointers can do, compared to the
+iterators.
+
+the text is 1 MB like a form body, words with a space or an & or = now and then, or binary where
+most bytes are encoded.
+
+not automatic, look at the output.
+
+*/
+
+template<typename function_>
+double url_encode_decode_speed_gbps(size_t bytes, function_&& function) {
+    // best of 5, GB/s of input
+    double best = 0;
+    for(unsigned repeat = 0; repeat != 5; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double gbps = static_cast<double>(bytes) / seconds / 1e9;
+        if(best < gbps)
+            best = gbps;
+    }
+    return best;
+}
+
+inline void url_encode_decode_speed() {
+    str::out_trace to;
+    for(bool binary : {false, true}) {
+        size_t const size = 1024 * 1024;
+        vector<unsigned char> text(size);
+        unsigned random = 1;
+        for(auto& a : text) {
+            random = random * 1103515245u + 12345u;
+            unsigned r = random >> 16;
+            a = static_cast<unsigned char>(
+                binary ? r & 0xff :
+                r % 12 == 0 ? " &="[r % 3] :
+                'a' + r % 26
+            );
+        }
+        vector<unsigned char>
+            encoded(url_encode_size(text.begin(), size)),
+            decoded(size);
+        url_encode(encoded.begin(), text.begin(), size);
+        size_t check = 0;
+        to << (binary ? "binary " : "form ") << size << " bytes, " << encoded.size() << " encoded\n";
+        to << "  url_encode pointer ....... " << url_encode_decode_speed_gbps(size, [&] {
+            check += url_encode(encoded.begin(), text.begin(), size);
+        }) << " GB/s\n";
+        to << "  url_encode_size .......... " << url_encode_decode_speed_gbps(size, [&] {
+            check += url_encode_size(text.begin(), size);
+        }) << " GB/s\n";
+        to << "  url_encode_iterator ...... " << url_encode_decode_speed_gbps(size, [&] {
+            auto t = encoded.begin();
+            for(auto e = url_encode_iterator_from(text.begin(), text.end()); e; ++e)
+                *t++ = *e;
+            check += static_cast<size_t>(t - encoded.begin());
+        }) << " GB/s\n";
+        to << "  url_decode pointer ....... " << url_encode_decode_speed_gbps(encoded.size(), [&] {
+            check += url_decode(decoded.begin(), encoded.begin(), encoded.size()).size();
+        }) << " GB/s\n";
+        to << "  url_decode_iterator ...... " << url_encode_decode_speed_gbps(encoded.size(), [&] {
+            auto t = decoded.begin();
+            for(auto d = url_decode_iterator_from(encoded.begin(), encoded.end()); d; ++d)
+                *t++ = *d;
+            check += static_cast<size_t>(t - decoded.begin());
+        }) << " GB/s\n";
+        to << "  (" << check << ")\n";
+    }
+}
+
+}}
+#endif
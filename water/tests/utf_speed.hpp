@@ -0,0 +1,111 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_TESTS_UTF_SPEED_HPP
+#define WATER_TESTS_UTF_SPEED_HPP
+#include <water/unicode/unicode.hpp>
+#include <water/downgrade_iterators/downgrade_iterators.hpp>
+#include <water/str/out_trace.hpp>
+#include <water/vector.hpp>
+#include <chrono>
+namespace water { namespace tests {
+
+/*
+
+sketch to measure how many GB/s of utf-8 unicode::utf_length<8> and unicode::utf_from_utf can do,
+with pointers (they use unicode/utf_bulk.hpp) and with downgrade_iterators::forward (they do not).
+
+the text is about 1 MB of ascii, latin with some 2 byte sequences, cjk that is mostly 3 byte
+sequences, and emoji that is 4 byte sequences with ascii spaces.
+
+compile with -mssse3 or -mavx2 to see the difference from the lookup table verify.
+
+not automatic, look at the output.
+
+*/
+
+inline vector<unsigned char> utf_speed_text(char32_t const* sample) {
+    vector<unsigned char> r;
+    size_t sample_size = 0;
+    while(sample[sample_size])
+        ++sample_size;
+    while(r.size() < 1024 * 1024) {
+        unsigned char e[4 * 64];
+        size_t s = unicode::utf_from_utf<8, 32>(e + 0, sample, sample_size).size();
+        r.insert(r.end(), e + 0, e + s);
+    }
+    return r;
+}
+
+template<typename function_>
+double utf_speed_gbps(size_t bytes, function_&& function) {
+    // best of 5, in GB/s of utf-8
+    double best = 0;
+    for(unsigned repeat = 0; repeat != 5; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double gbps = static_cast<double>(bytes) / seconds / 1e9;
+        if(best < gbps)
+            best = gbps;
+    }
+    return best;
+}
+
+inline void utf_speed() {
+    str::out_trace to;
+    char32_t const
+        ascii[] = U"The quick brown fox jumps over the lazy dog, and then it runs home again. ",
+        latin[] = U"Smörgåsbord, crème brûlée och åtta äpplen på bordet. ",
+        cjk[] = U"日本語の文章と中文的句子。한국어 ",
+        emoji[] = U"\U0001f600 \U0001f680\U0001f30d \U0001f44d\U0001f3fd \U0001f389\U0001f382 ";
+    struct {
+        char const *name;
+        char32_t const *sample;
+    } const corpora[] = {
+        {"ascii", ascii},
+        {"latin", latin},
+        {"cjk", cjk},
+        {"emoji", emoji}
+    };
+    for(auto& c : corpora) {
+        auto text = utf_speed_text(c.sample);
+        unsigned char const
+            *begin = text.begin(),
+            *end = text.end();
+        auto forward = [](unsigned char const* a) { return downgrade_iterators::forward<unsigned char const*>(a); };
+        unicode::utf_length<8> length{begin, end};
+        size_t
+            bytes = text.size(),
+            check = 0;
+        vector<char16_t> utf16(length.utf16());
+        vector<unsigned char> utf8(bytes);
+        to << c.name << ' ' << bytes << " bytes\n";
+        to << "  utf_length<8> pointer ........ " << utf_speed_gbps(bytes, [&] {
+            check += unicode::utf_length<8>(begin, end).utf32();
+        }) << " GB/s\n";
+        to << "  utf_length<8> forward ........ " << utf_speed_gbps(bytes, [&] {
+            check += unicode::utf_length<8>(forward(begin), forward(end)).utf32();
+        }) << " GB/s\n";
+        to << "  utf-16 from utf-8 pointer .... " << utf_speed_gbps(bytes, [&] {
+            check += unicode::utf_from_utf_verify<16, 8>(utf16.begin(), begin, end).size();
+        }) << " GB/s\n";
+        to << "  utf-16 from utf-8 forward .... " << utf_speed_gbps(bytes, [&] {
+            check += unicode::utf_from_utf_verify<16, 8>(utf16.begin(), forward(begin), forward(end)).size();
+        }) << " GB/s\n";
+        char16_t const
+            *begin16 = utf16.begin(),
+            *end16 = utf16.end();
+        to << "  utf-8 from utf-16 pointer .... " << utf_speed_gbps(bytes, [&] {
+            check += unicode::utf_from_utf<8, 16>(utf8.begin(), begin16, end16).size();
+        }) << " GB/s\n";
+        to << "  utf-8 from utf-16 forward .... " << utf_speed_gbps(bytes, [&] {
+            check += unicode::utf_from_utf<8, 16>(utf8.begin(), downgrade_iterators::forward<char16_t const*>(begin16), downgrade_iterators::forward<char16_t const*>(end16)).size();
+        }) << " GB/s\n";
+        to << "  (" << check << ")\n";
+    }
+}
+
+}}
+#endif
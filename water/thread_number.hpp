@@ -0,0 +1,28 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREAD_NUMBER_HPP
+#define WATER_THREAD_NUMBER_HPP
+#include <water/water.hpp>
+#include <water/atomic.hpp>
+namespace water {
+
+/*
+
+A number for the current thread. The first thread that calls this gets 0, the next 1 and so on, and
+each thread gets the same number every time after. Numbers are not reused when a thread ends.
+
+Used to pick a slot or list for each thread.
+
+*/
+
+template<typename = void>
+unsigned thread_number() noexcept {
+    static atomic<unsigned> next {};
+    static thread_local unsigned number = next.fetch_add(1, memory_order_relaxed);
+    return number;
+}
+
+}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -31,7 +31,7 @@ public:
     }
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_semaphore"); add.wait(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_semaphore"); add.wait(true).hold_begin();)
         if(!my.fetch_add(1, memory_order_acquire))
             return;
         ___water_threads_statistics(add.wait(false));
@@ -50,7 +50,7 @@ public:
     }
 
     bool lock(deadline d) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_semaphore"); add.wait(true).timeout(true));
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_semaphore"); add.wait(true).timeout(true).hold_begin());
         if(!my.fetch_add(1, memory_order_acquire))
             return true;
         ___water_threads_statistics(add.wait(false).timeout(false));
@@ -75,12 +75,12 @@ public:
     bool try_lock() noexcept {
         decltype(my.load()) x = 0;
         bool r = my.compare_exchange_strong(x, 1, memory_order_acquire);
-        ___water_threads_statistics(add_(mystatistics, this, "mutex_semaphore").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_semaphore").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_semaphore"); add.wake(true));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_semaphore").hold_end(); add_ add(mystatistics, this, "mutex_semaphore"); add.wake(true));
         if(my.exchange(0, memory_order_release) > 1)
             if(auto s = semaphore_atomic_get(mysemaphore)) {
                 semaphore_signal(s);
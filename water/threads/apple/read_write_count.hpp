@@ -1,4 +1,4 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -38,7 +38,7 @@ public:
     }
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true).hold_begin();)
         algorithm a(my);
         if(a.write_lock(true))
             return;
@@ -74,7 +74,7 @@ public:
     }
 
     bool lock(deadline d) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true).timeout(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true).timeout(true).hold_begin();)
         algorithm a(my);
         if(a.write_lock(true))
             return true;
@@ -121,12 +121,12 @@ public:
 
     bool try_lock() noexcept {
         bool r = algorithm(my).write_try_lock();
-        ___water_threads_statistics(add_(mystatistics, this, "read_write_count").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "read_write_count").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wake(true));
+        ___water_threads_statistics(add_(mystatistics, this, "read_write_count").hold_end(); add_ add(mystatistics, this, "read_write_count"); add.wake(true));
         if(algorithm(my).write_unlock())
             if(mach_t l = semaphore_atomic_get(mylock))
                 if(semaphore_lock(l)) {
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -19,6 +19,8 @@ struct need_recursive             { static unsigned constexpr need = 1 << 3; };
 struct need_constexpr_constructor { static unsigned constexpr need = 1 << 4; };
 struct need_trivial_destructor    { static unsigned constexpr need = 1 << 5; };
 struct need_spin                  { static unsigned constexpr need = 1 << 6; }; // selected only if specifically asked for
+struct need_adaptive              { static unsigned constexpr need = 1 << 7; }; // selected only if specifically asked for
+struct need_distributed           { static unsigned constexpr need = 1 << 8; }; // selected only if specifically asked for
 struct need_nothing               { static unsigned constexpr need = 0; };
 
 namespace _ {
@@ -59,7 +61,9 @@ namespace _ {
         ifel<
             type_::needs::need &&
             (needs_ & type_::needs::need) == needs_ &&
-            (needs_ & need_spin::need) == (type_::needs::need & need_spin::need), // select spin variant only if asked for
+            (needs_ & need_spin::need) == (type_::needs::need & need_spin::need) && // select spin variant only if asked for
+            (needs_ & need_adaptive::need) == (type_::needs::need & need_adaptive::need) && // and adaptive
+            (needs_ & need_distributed::need) == (type_::needs::need & need_distributed::need), // and distributed
             result_type<type_>,
             need_select_do<needs_, list_...>
         > {};
@@ -91,6 +95,8 @@ template<typename type_> constexpr bool is_water()                  { return (ty
 template<typename type_> constexpr bool has_timeout()               { return (type_::needs::need & need_timeout::need) != 0; }
 template<typename type_> constexpr bool is_recursive()              { return (type_::needs::need & need_recursive::need) != 0; }
 template<typename type_> constexpr bool is_spin()                   { return (type_::needs::need & need_spin::need) != 0; }
+template<typename type_> constexpr bool is_adaptive()               { return (type_::needs::need & need_adaptive::need) != 0; }
+template<typename type_> constexpr bool is_distributed()            { return (type_::needs::need & need_distributed::need) != 0; }
 template<typename type_> constexpr bool has_constexpr_constructor() { return (type_::needs::need & need_constexpr_constructor::need) != 0; }
 template<typename type_> constexpr bool has_trivial_destructor()    { return (type_::needs::need & need_trivial_destructor::need) != 0; }
 
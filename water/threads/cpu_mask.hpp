@@ -0,0 +1,115 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_CPU_MASK_HPP
+#define WATER_THREADS_CPU_MASK_HPP
+#include <water/threads/bits.hpp>
+namespace water { namespace threads {
+
+// A set of CPU numbers, for the affinity of a thread. See thread.hpp
+//
+//   threads::cpu_mask cpus;
+//   cpus.add(0).add(2);
+//   for(unsigned c = cpus.next(0); c != cpus.size; c = cpus.next(c + 1)) ...
+
+class cpu_mask
+{
+public:
+    static unsigned constexpr size = 1024; // same as CPU_SETSIZE on linux
+
+private:
+    static unsigned constexpr bits = numeric_limits<size_t>::digits;
+    size_t my[size / bits] {};
+
+public:
+    constexpr cpu_mask() noexcept = default;
+
+    cpu_mask& add(unsigned cpu) noexcept {
+        ___water_assert(cpu < size);
+        if(cpu < size)
+            my[cpu / bits] |= static_cast<size_t>(1) << (cpu % bits);
+        return *this;
+    }
+
+    cpu_mask& add(unsigned begin, unsigned end) noexcept {
+        // add begin to end - 1
+        while(begin < end)
+            add(begin++);
+        return *this;
+    }
+
+    cpu_mask& remove(unsigned cpu) noexcept {
+        if(cpu < size)
+            my[cpu / bits] &= ~(static_cast<size_t>(1) << (cpu % bits));
+        return *this;
+    }
+
+    bool has(unsigned cpu) const noexcept {
+        return cpu < size && ((my[cpu / bits] >> (cpu % bits)) & 1);
+    }
+
+    unsigned next(unsigned from) const noexcept {
+        // the first cpu that is from or larger, or size if none
+        for(; from < size; ++from)
+            if(!(from % bits) && !my[from / bits])
+                from += bits - 1;
+            else if(has(from))
+                return from;
+        return size;
+    }
+
+    unsigned count() const noexcept {
+        unsigned r = 0;
+        for(auto m : my)
+            for(; m; m &= m - 1)
+                ++r;
+        return r;
+    }
+
+    unsigned at(unsigned index) const noexcept {
+        // the cpu at index, counting only the cpus in this. index wraps around. size if this is empty
+        unsigned c = count();
+        if(!c)
+            return size;
+        index %= c;
+        unsigned r = next(0);
+        while(index--)
+            r = next(r + 1);
+        return r;
+    }
+
+    explicit operator bool() const noexcept {
+        // true if not empty
+        for(auto m : my)
+            if(m)
+                return true;
+        return false;
+    }
+
+    bool operator==(cpu_mask const& a) const noexcept {
+        for(unsigned i = 0; i != size / bits; ++i)
+            if(my[i] != a.my[i])
+                return false;
+        return true;
+    }
+
+    bool operator!=(cpu_mask const& a) const noexcept {
+        return !(*this == a);
+    }
+
+    cpu_mask& operator&=(cpu_mask const& a) noexcept {
+        for(unsigned i = 0; i != size / bits; ++i)
+            my[i] &= a.my[i];
+        return *this;
+    }
+
+    cpu_mask& operator|=(cpu_mask const& a) noexcept {
+        for(unsigned i = 0; i != size / bits; ++i)
+            my[i] |= a.my[i];
+        return *this;
+    }
+};
+
+}}
+#endif
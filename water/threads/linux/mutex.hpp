@@ -1,10 +1,11 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_THREADS_LINUX_MUTEX_HPP
 #define WATER_THREADS_LINUX_MUTEX_HPP
 #include <water/threads/linux/mutex_futex.hpp>
+#include <water/threads/linux/mutex_adaptive.hpp>
 #include <water/threads/posix/pthread_mutex.hpp>
 #include <water/threads/posix/mutex_sem.hpp>
 #include <water/threads/spin_mutex.hpp>
@@ -17,7 +18,8 @@ using mutex_list = list<
     mutex_futex<>,
     recursive<mutex_futex<>>,
     mutex_sem<>,
-    spin_mutex<>
+    spin_mutex<>,
+    mutex_adaptive<>
 >;
 
 }}
@@ -0,0 +1,141 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_LINUX_MUTEX_ADAPTIVE_HPP
+#define WATER_THREADS_LINUX_MUTEX_ADAPTIVE_HPP
+#include <water/threads/linux/futex.hpp>
+#include <water/threads/functions.hpp>
+#include <water/threads/pause.hpp>
+#include <water/threads/spin.hpp>
+#include <water/threads/deadline.hpp>
+namespace water { namespace threads {
+
+/*
+
+Futex mutex that spins before it sleeps. Select it with mutex<need_adaptive>.
+
+The same states as mutex_futex: 0 unlocked, 1 locked, 2 locked and threads could be sleeping.
+
+When the mutex is locked, lock spins at most 2 x spins() + spin_min times, reading the mutex until it
+looks unlocked. Then it sleeps on the futex like mutex_futex. spins() is an estimate of how long the
+mutex is held, tuned by each lock that had to spin:
+- if the lock was taken after n spins, spins() moves 1/8 of the way toward n
+- if spinning did not help, spins() is lowered by 1/4
+
+So short critical sections are spun on, long ones go to sleep quickly. The same idea as the glibc
+PTHREAD_MUTEX_ADAPTIVE_NP mutex.
+
+This cannot be used with condition, use mutex_for_condition.
+
+*/
+
+template<bool exists_ = futex_exists>
+class mutex_adaptive
+{
+public:
+    using needs = threads::needs<need_water, need_constexpr_constructor, need_trivial_destructor, need_timeout, need_adaptive>;
+
+    static unsigned constexpr
+        spin_min = 16, // always spin this much, to find out when spinning helps again
+        spin_max = 4096;
+
+private:
+    futex_atomic my{0};
+    atomic<unsigned> myspins{spin_min}; // relaxed, races only make the estimate a little off
+    ___water_threads_statistics(threads::statistics::reference mystatistics;)
+    ___water_threads_statistics(using add_ = threads::statistics::add;)
+
+public:
+    constexpr mutex_adaptive() noexcept = default;
+    mutex_adaptive(mutex_adaptive const&) = delete;
+    mutex_adaptive& operator=(mutex_adaptive const&) = delete;
+
+    void lock() noexcept {
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_adaptive"); add.wait(true).hold_begin();)
+        if(lock_once() || lock_spin())
+            return;
+        ___water_threads_statistics(add.wait(false));
+        pause p = pause_wait();
+        while(my.exchange(2, memory_order_acquire))
+            if(int e = futex_wait(my, 2))
+                if(e != futex_again && e != futex_signal)
+                    p();
+    }
+
+    bool lock(deadline_clock<clockid::monotonic_maybe> d) noexcept {
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_adaptive"); add.wait(true).timeout(true).hold_begin();)
+        if(lock_once() || lock_spin())
+            return true;
+        ___water_threads_statistics(add.wait(false));
+        double left;
+        while((left = d.left()) >= 1e-9) {
+            if(!my.exchange(2, memory_order_acquire))
+                return true;
+            int e = futex_wait(my, 2, left);
+            if(e && e != futex_again && e != futex_signal)
+                break;
+        }
+        ___water_threads_statistics(add.timeout(false));
+        return false;
+    }
+
+    bool try_lock() noexcept {
+        bool r = lock_once();
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_adaptive").wait(r).hold_begin(r));
+        return r;
+    }
+
+    void unlock() noexcept {
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_adaptive").hold_end(); add_ add(mystatistics, this, "mutex_adaptive"); add.wake(true));
+        if(my.exchange(0, memory_order_release) == 2) {
+            futex_wake(my);
+            ___water_threads_statistics(add.wake(false));
+        }
+    }
+
+    unsigned spins() const noexcept {
+        return myspins.load(memory_order_relaxed);
+    }
+
+    futex_atomic& underlying() noexcept {
+        return my;
+    }
+
+    ___water_threads_statistics(threads::statistics::data* statistics() noexcept { return get(mystatistics, this, "mutex_adaptive"); })
+
+private:
+
+    bool lock_once() noexcept {
+        decltype(my.load()) x = 0;
+        return my.compare_exchange_strong(x, 1, memory_order_acquire);
+    }
+
+    bool lock_spin() noexcept {
+        unsigned
+            spins = myspins.load(memory_order_relaxed),
+            max = spins * 2 + spin_min;
+        if(max > spin_max)
+            max = spin_max;
+        for(unsigned n = 1; n <= max; ++n) {
+            cpu_pause();
+            if(!my.load(memory_order_relaxed) && lock_once()) {
+                // move 1/8 toward n
+                myspins.store(n >= spins ? spins + (n - spins) / 8 : spins - (spins - n) / 8, memory_order_relaxed);
+                return true;
+            }
+        }
+        myspins.store(spins - spins / 4 > spin_min ? spins - spins / 4 : spin_min, memory_order_relaxed);
+        return false;
+    }
+};
+
+template<>
+class mutex_adaptive<false>
+{
+public:
+    using needs = threads::needs<>;
+};
+
+}}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -29,7 +29,7 @@ public:
 private:
 
     void lock_do(unsigned value) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_futex"); add.wait(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_futex"); add.wait(true).hold_begin();)
         decltype(my.load()) x = 0;
         if(my.compare_exchange_strong(x, value, memory_order_acquire))
             return;
@@ -56,7 +56,7 @@ public:
     }
 
     bool lock(deadline_clock<clockid::monotonic_maybe> d) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_futex"); add.wait(true).timeout(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_futex"); add.wait(true).timeout(true).hold_begin();)
         decltype(my.load()) x = 0;
         if(my.compare_exchange_strong(x, 1, memory_order_acquire))
             return true;
@@ -76,12 +76,12 @@ public:
     bool try_lock() noexcept {
         decltype(my.load()) x;
         bool r = my.compare_exchange_strong(x = 0, 1, memory_order_acquire);
-        ___water_threads_statistics(add_(mystatistics, this, "mutex_futex").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_futex").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_futex"); add.wake(true));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_futex").hold_end(); add_ add(mystatistics, this, "mutex_futex"); add.wake(true));
         if(my.exchange(0, memory_order_release) == 2) {
             futex_wake(my);
             ___water_threads_statistics(add.wake(false));
@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -29,7 +29,7 @@ public:
     read_write_count& operator=(read_write_count const&) = delete;
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true).hold_begin();)
         algorithm a(my);
         auto v = mywrite.load(memory_order_relaxed);
         if(a.write_lock(true)) return;
@@ -45,7 +45,7 @@ public:
     }
 
     bool lock(deadline_clock<clockid::monotonic_maybe> d) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true).timeout(true));
+        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wait(true).timeout(true).hold_begin());
         algorithm a(my);
         auto v = mywrite.load(memory_order_relaxed);
         if(a.write_lock(true)) return true;
@@ -73,12 +73,12 @@ public:
 
     bool try_lock() noexcept {
         bool r = algorithm(my).write_try_lock();
-        ___water_threads_statistics(add_(mystatistics, this, "read_write_count").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "read_write_count").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_count"); add.wake(true));
+        ___water_threads_statistics(add_(mystatistics, this, "read_write_count").hold_end(); add_ add(mystatistics, this, "read_write_count"); add.wake(true));
         if(algorithm(my).write_unlock()) {
             write_wake();
             futex_wake_all(my);
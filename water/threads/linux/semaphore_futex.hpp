@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -65,7 +65,7 @@ public:
         ___water_threads_statistics(add.wait(false));
         double left;
         while((left = d.left()) >= 1e-9) {
-            int e = futex_wait(my, 0, left);
+            int e = futex_wait(my, now, left);
             if(down_do(now, -1))
                 return true;
             if(e && e != futex_again && e != futex_signal)
@@ -0,0 +1,472 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_POOL_HPP
+#define WATER_THREADS_POOL_HPP
+#include <water/threads/bits.hpp>
+#include <water/threads/thread.hpp>
+#include <water/threads/thread_name.hpp>
+#include <water/threads/yield.hpp>
+#include <water/threads/functions.hpp>
+#include <water/hardware_interference_size.hpp>
+#include <water/allocator_nothrow.hpp>
+#include <water/new_here.hpp>
+#ifdef WATER_THREADS_LINUX
+    #include <water/threads/linux/futex.hpp>
+#else
+    #include <water/threads/condition.hpp>
+#endif
+namespace water { namespace threads {
+
+/*
+
+Work stealing thread pool.
+
+    threads::pool pool{8}; // 8 threads
+
+    pool.run([]{ work(); }); // the function is copied
+    pool.wait(); // until everything from run is done
+
+    pool.join([]{ left(); }, []{ right(); }); // run both, maybe at the same time, return when both are done
+
+    pool.for_range(0, size, 1000, [](size_t begin, size_t end) { ... }); // split into parts of at most 1000
+
+    threads::pool pinned{4, threads::node_cpus(0)}; // thread i runs on cpu i of the mask, wrapping around
+
+join and for_range can be used from any thread, also from a function running in the pool. The
+calling thread helps with the work while it waits, so join inside join is fine. wait should not be
+called from a function running in the pool.
+
+Each thread has its own queue (a Chase-Lev deque). A thread pushes and pops work at the bottom of its
+own queue, other threads steal from the top. Work from threads outside the pool is added to a lock free
+list that the pool threads take from. Threads without work spin for a short while, then sleep on a
+futex on Linux or a condition variable on other systems.
+
+If the queue of a thread is full, it runs the function at once instead.
+
+The functions must not throw.
+
+*/
+
+namespace _ {
+
+    struct pool_task {
+        void (*call)(pool_task*) = 0;
+        pool_task *next = 0; // for the list of tasks from outside the pool
+    };
+
+    template<typename function_>
+    struct pool_task_copy : pool_task {
+        function_ function;
+        atomic<size_t> *running;
+
+        template<typename from_>
+        pool_task_copy(from_&& f, atomic<size_t> *r) :
+            function{static_cast<from_&&>(f)},
+            running{r}
+        {
+            this->call = &do_call;
+        }
+
+        static void do_call(pool_task *t) {
+            auto me = static_cast<pool_task_copy*>(t);
+            auto running = me->running;
+            me->function();
+            me->~pool_task_copy();
+            allocator_nothrow{}.free(me, sizeof(pool_task_copy));
+            running->fetch_sub(1, memory_order_release);
+        }
+    };
+
+    template<typename function_>
+    struct pool_task_join : pool_task {
+        function_ *function;
+        atomic<bool> done {false};
+
+        pool_task_join(function_ *f) :
+            function{f}
+        {
+            this->call = &do_call;
+        }
+
+        static void do_call(pool_task *t) {
+            auto me = static_cast<pool_task_join*>(t);
+            (*me->function)();
+            me->done.store(true, memory_order_release);
+        }
+    };
+
+    // Chase-Lev deque with a fixed size.
+    // push and pop only from the owner thread, steal from any thread.
+    // "Correct and Efficient Work-Stealing for Weak Memory Models" Lê, Pop, Cohen, Nardelli 2013
+    // without fences, the operations that need them are seq_cst instead. push is seq_cst so the pool
+    // can see if a thread is sleeping after the push
+
+    class pool_deque
+    {
+    public:
+        static size_t constexpr size = 4096;
+
+    private:
+        alignas(hardware_destructive_interference_size) atomic<ptrdiff_t> mytop {0};
+        alignas(hardware_destructive_interference_size) atomic<ptrdiff_t> mybottom {0};
+        atomic<pool_task*> my[size] {};
+
+    public:
+        bool push(pool_task *a) noexcept {
+            auto b = mybottom.load(memory_order_relaxed);
+            auto t = mytop.load(memory_order_acquire);
+            if(b - t >= static_cast<ptrdiff_t>(size))
+                return false;
+            my[static_cast<size_t>(b) % size].store(a, memory_order_relaxed);
+            mybottom.store(b + 1, memory_order_seq_cst);
+            return true;
+        }
+
+        pool_task* pop() noexcept {
+            auto b = mybottom.load(memory_order_relaxed) - 1;
+            mybottom.exchange(b, memory_order_seq_cst);
+            auto t = mytop.load(memory_order_seq_cst);
+            if(t > b) {
+                mybottom.store(b + 1, memory_order_relaxed);
+                return 0;
+            }
+            auto r = my[static_cast<size_t>(b) % size].load(memory_order_relaxed);
+            if(t == b) {
+                // last one, race with steal
+                if(!mytop.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+                    r = 0;
+                mybottom.store(b + 1, memory_order_relaxed);
+            }
+            return r;
+        }
+
+        pool_task* steal() noexcept {
+            auto t = mytop.load(memory_order_seq_cst);
+            auto b = mybottom.load(memory_order_seq_cst);
+            if(t >= b)
+                return 0;
+            auto r = my[static_cast<size_t>(t) % size].load(memory_order_relaxed);
+            if(!mytop.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+                return 0; // another thread got it
+            return r;
+        }
+
+        bool empty() const noexcept {
+            return mybottom.load(memory_order_seq_cst) <= mytop.load(memory_order_seq_cst);
+        }
+    };
+
+    inline void pool_worker_name(char (&to)[16], unsigned index) noexcept {
+        // "water pool 12". linux allows 15 characters, if index has more than 4 digits the last are cut
+        char const begin[] = "water pool ";
+        char digits[16];
+        unsigned d = 0, at = 0;
+        do digits[d++] = static_cast<char>('0' + index % 10); while(index /= 10);
+        while(begin[at]) {
+            to[at] = begin[at];
+            ++at;
+        }
+        while(d && at != sizeof(to) - 1)
+            to[at++] = digits[--d];
+        to[at] = 0;
+    }
+
+    template<typename = void>
+    void*& pool_worker_current() noexcept {
+        static thread_local void *current = 0;
+        return current;
+    }
+
+}
+
+class pool
+{
+    using task = _::pool_task;
+
+    struct worker {
+        _::pool_deque deque;
+        pool *owner = 0;
+        unsigned index = 0;
+        unsigned random = 0;
+        join_t join {};
+        bool running = false;
+
+        void operator()() {
+            _::pool_worker_current() = this;
+            char name[16];
+            _::pool_worker_name(name, index);
+            thread_name(name);
+            owner->work(*this);
+        }
+    };
+
+    struct alignas(hardware_destructive_interference_size) aligned {
+        atomic<task*> list {}; // from outside the pool
+        atomic<unsigned> sleeping {0};
+        atomic<unsigned> event {0}; // a futex
+        atomic<size_t> running {0}; // number of tasks from run that are not done
+        atomic<bool> stop {false};
+    };
+
+    aligned my;
+    worker *myworkers = 0;
+    unsigned
+        mysize = 0,
+        myrunning = 0; // threads that started
+    #ifndef WATER_THREADS_LINUX
+    condition<> mycondition;
+    mutex_for_condition<condition<>> mylock;
+    #endif
+
+public:
+    static unsigned constexpr spin_before_sleep = 64;
+
+    explicit pool(unsigned threads) :
+        pool{threads, cpu_mask{}}
+    {}
+
+    pool(unsigned threads, cpu_mask const& cpus) {
+        // pin each thread to one of cpus. if pinning fails, or cpus is empty, the thread runs anywhere
+        if(!threads)
+            return;
+        myworkers = allocator_nothrow{}.allocate<worker>(threads);
+        if(!myworkers)
+            return;
+        for(; mysize != threads; ++mysize) {
+            auto &a = *new(here(myworkers + mysize)) worker;
+            a.owner = this;
+            a.index = mysize;
+            a.random = mysize * 2654435761u + 1;
+        }
+        using function = member_function<worker, &worker::operator()>;
+        cpu_mask allowed;
+        if(affinity_exists && cpus) {
+            allowed = affinity();
+            allowed &= cpus;
+        }
+        for(unsigned i = 0; i != mysize; ++i)
+            if((myworkers[i].running =
+                (allowed && threads::run<function>(myworkers + i, myworkers[i].join, run_options{}.cpu(allowed.at(i)))) ||
+                threads::run<function>(myworkers + i, myworkers[i].join)
+            ))
+                ++myrunning;
+    }
+
+    pool(pool const&) = delete;
+    pool& operator=(pool const&) = delete;
+
+    ~pool() {
+        wait();
+        my.stop.store(true, memory_order_seq_cst);
+        wake(true);
+        for(unsigned i = 0; i != mysize; ++i) {
+            if(myworkers[i].running)
+                threads::join(myworkers[i].join);
+            myworkers[i].~worker();
+        }
+        if(myworkers)
+            allocator_nothrow{}.free<worker>(myworkers, mysize);
+    }
+
+    unsigned size() const noexcept {
+        // number of threads
+        return mysize;
+    }
+
+    template<typename function_>
+    bool run(function_&& function) {
+        // copy function and run it on the pool. returns false if memory could not be allocated
+        using task_type = _::pool_task_copy<no_const_or_reference<function_>>;
+        void *m = allocator_nothrow{}.allocate(sizeof(task_type));
+        if(!m)
+            return false;
+        my.running.fetch_add(1, memory_order_relaxed);
+        push(new(here(m)) task_type{static_cast<function_&&>(function), &my.running});
+        return true;
+    }
+
+    void wait() noexcept {
+        // until all functions from run are done. helps with the work while waiting
+        unsigned spin = 0;
+        while(my.running.load(memory_order_acquire))
+            if(!help())
+                pause(spin);
+    }
+
+    template<typename a_, typename b_>
+    void join(a_&& a, b_&& b) {
+        // run a and b, maybe at the same time, return when both are done
+        // b is pushed to the own queue, if nobody steals it help() pops it back
+        _::pool_task_join<no_reference<b_>> t{&b};
+        push(&t);
+        a();
+        unsigned spin = 0;
+        while(!t.done.load(memory_order_acquire))
+            if(!help())
+                pause(spin);
+    }
+
+    template<typename function_>
+    void for_range(size_t begin, size_t end, size_t size, function_&& function) {
+        // call function(b, e) for parts of begin, end that are at most size long
+        if(!size)
+            size = 1;
+        if(end - begin > size) {
+            size_t middle = begin + (end - begin) / 2;
+            join(
+                [&] { for_range(begin, middle, size, function); },
+                [&] { for_range(middle, end, size, function); }
+            );
+        }
+        else if(begin != end)
+            function(begin, end);
+    }
+
+private:
+
+    worker* current() noexcept {
+        auto w = static_cast<worker*>(_::pool_worker_current());
+        return w && w->owner == this ? w : 0;
+    }
+
+    void push(task *t) noexcept {
+        auto w = current();
+        if(!myrunning) {
+            t->call(t);
+            return;
+        }
+        if(w) {
+            if(!w->deque.push(t)) {
+                t->call(t);
+                return;
+            }
+        }
+        else {
+            auto now = my.list.load(memory_order_relaxed);
+            do t->next = now; while(!my.list.compare_exchange_weak(now, t));
+        }
+        wake(false);
+    }
+
+    task* find(worker *w) noexcept {
+        // own queue, then the list from outside the pool, then steal.
+        // only pool threads take from the list
+        task *t = 0;
+        if(w && (t = w->deque.pop()))
+            return t;
+        if(w && my.list.load(memory_order_relaxed) && (t = my.list.exchange(0, memory_order_acquire))) {
+            // the list is newest first. run the oldest, queue the rest oldest first so others steal them in order
+            task *oldest = 0;
+            while(t) {
+                auto next = t->next;
+                t->next = oldest;
+                oldest = t;
+                t = next;
+            }
+            t = oldest;
+            bool queued = false;
+            for(auto q = oldest->next; q; ) {
+                auto next = q->next;
+                if(w->deque.push(q))
+                    queued = true;
+                else
+                    q->call(q);
+                q = next;
+            }
+            if(queued)
+                wake(false);
+            return t;
+        }
+        if(mysize) {
+            unsigned r = w ? (w->random = w->random * 1664525u + 1013904223u) >> 8 : 0;
+            for(unsigned i = 0; i != mysize; ++i) {
+                auto &victim = myworkers[(r + i) % mysize];
+                if(&victim != w && (t = victim.deque.steal()))
+                    return t;
+            }
+        }
+        return 0;
+    }
+
+    bool help() noexcept {
+        if(auto t = find(current())) {
+            t->call(t);
+            return true;
+        }
+        return false;
+    }
+
+    bool something() noexcept {
+        if(my.list.load(memory_order_seq_cst))
+            return true;
+        for(unsigned i = 0; i != mysize; ++i)
+            if(!myworkers[i].deque.empty())
+                return true;
+        return false;
+    }
+
+    static void pause(unsigned& spin) noexcept {
+        if(++spin > spin_before_sleep)
+            threads::yield();
+    }
+
+    void work(worker& w) noexcept {
+        unsigned spin = 0;
+        while(true) {
+            if(auto t = find(&w)) {
+                t->call(t);
+                spin = 0;
+                continue;
+            }
+            if(my.stop.load(memory_order_acquire))
+                return;
+            if(++spin < spin_before_sleep) {
+                if(spin > spin_before_sleep / 2)
+                    threads::yield();
+                continue;
+            }
+            unsigned event = my.event.load(memory_order_seq_cst);
+            my.sleeping.fetch_add(1, memory_order_seq_cst);
+            if(!something() && !my.stop.load(memory_order_seq_cst))
+                sleep(event);
+            my.sleeping.fetch_sub(1, memory_order_seq_cst);
+            spin = 0;
+        }
+    }
+
+    void wake(bool all) noexcept {
+        if(!my.sleeping.load(memory_order_seq_cst))
+            return;
+        #ifdef WATER_THREADS_LINUX
+        my.event.fetch_add(1, memory_order_seq_cst);
+        if(all)
+            futex_wake_all(my.event);
+        else
+            futex_wake(my.event, 1);
+        #else
+        {
+            auto l = lock_move(mylock);
+            my.event.fetch_add(1, memory_order_seq_cst);
+        }
+        if(all)
+            mycondition.wake_all();
+        else
+            mycondition.wake();
+        #endif
+    }
+
+    void sleep(unsigned event) noexcept {
+        #ifdef WATER_THREADS_LINUX
+        futex_wait(my.event, event);
+        #else
+        auto l = lock_move(mylock);
+        if(my.event.load(memory_order_relaxed) == event)
+            mycondition.wait(mylock);
+        #endif
+    }
+};
+
+}}
+#endif
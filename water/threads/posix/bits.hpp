@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -81,6 +81,15 @@
     #define WATER_POSIX_THREAD_ATTR_STACKSIZE
 #endif
 
+// pthread_attr_setaffinity_np, sched_getaffinity and sched_getcpu are gnu extensions, CPU_SETSIZE is
+// only defined with _GNU_SOURCE. g++ defines _GNU_SOURCE
+#if \
+!defined(WATER_POSIX_THREAD_AFFINITY) && \
+!defined(WATER_POSIX_NO_THREAD_AFFINITY) && \
+(defined(WATER_SYSTEM_LINUX) && defined(__GLIBC__) && defined(CPU_SETSIZE))
+    #define WATER_POSIX_THREAD_AFFINITY
+#endif
+
 #if \
 !defined(WATER_POSIX_MUTEX_RECURSIVE) && \
 !defined(WATER_POSIX_NO_MUTEX_RECURSIVE) && \
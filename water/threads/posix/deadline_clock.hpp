@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -100,10 +100,9 @@ public:
     deadline_clock(double seconds) noexcept :
         my(clock<clockid_>())
     {
-        if(seconds >= 1e-9) {
-            myleft = true;
+        myleft = seconds >= 1e-9;
+        if(myleft)
             timespec_add(my, seconds);
-        }
     }
 
     deadline_clock(timespec absolute_time) noexcept :
@@ -120,10 +119,8 @@ public:
     double left() noexcept {
         if(!myleft) return 0;
         auto now = clock<clockid_>();
-        double r = 0;
-        if(now.tv_sec > my.tv_sec)
-            r = now.tv_sec - my.tv_sec;
-        r += (now.tv_nsec - my.tv_nsec) / 1e9;
+        // the time from now to my, it is negative when my has passed
+        double r = static_cast<double>(my.tv_sec - now.tv_sec) + static_cast<double>(my.tv_nsec - now.tv_nsec) / 1e9;
         if(r >= 1e-9)
             return r;
         myleft = false;
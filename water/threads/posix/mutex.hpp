@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -14,7 +14,7 @@ using mutex_list = list<
     pthread_mutex,
     pthread_mutex_recursive,
     mutex_sem<>,
-    recrusive<mutex_sem<>>,
+    recursive<mutex_sem<>>,
     spin_mutex<>
 >;
 
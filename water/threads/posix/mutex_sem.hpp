@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -53,7 +53,7 @@ public:
     }
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_sem"); add.wait(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_sem"); add.wait(true).hold_begin();)
         if(!my.fetch_add(1, memory_order_acquire))
             return;
         ___water_threads_statistics(add.wait(false));
@@ -71,7 +71,7 @@ public:
 
     #ifdef WATER_POSIX_TIMEOUTS
     bool lock(deadline_clock<clockid::realtime> d) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_sem"); add.wait(true).timeout(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_sem"); add.wait(true).timeout(true).hold_begin();)
         if(!my.fetch_add(1, memory_order_acquire))
             return true;
         ___water_threads_statistics(add.wait(false).timeout(false));
@@ -89,12 +89,12 @@ public:
     bool try_lock() noexcept {
         decltype(my.load()) x = 0;
         bool r = my.compare_exchange_strong(x, 1, memory_order_acquire);
-        ___water_threads_statistics(add_(mystatistics, this, "mutex_sem").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_sem").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_sem"); add.wake(true));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_sem").hold_end(); add_ add(mystatistics, this, "mutex_sem"); add.wake(true));
         if(my.exchange(0, memory_order_release) > 1)
             if(myinit.load(memory_order_relaxed) == 1) {
                 up(mysem);
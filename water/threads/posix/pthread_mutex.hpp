@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -49,6 +49,7 @@ public:
 private:
     pthread_mutex_t my = PTHREAD_MUTEX_INITIALIZER;
     ___water_threads_statistics(threads::statistics::reference mystatistics;)
+    ___water_threads_statistics(using add_ = threads::statistics::add;)
 
 public:
     constexpr pthread_mutex() noexcept = default;
@@ -60,24 +61,27 @@ public:
     }
 
     void lock() {
-        ___water_threads_statistics(if(try_lock()) return;)
+        ___water_threads_statistics(add_ add(mystatistics, this, "pthread_mutex"); add.wait(true).hold_begin(); if(threads::try_lock(my)) return; add.wait(false);)
         threads::lock(my);
     }
 
     bool try_lock() noexcept {
         bool r = threads::try_lock(my);
-        ___water_threads_statistics(threads::statistics::add(mystatistics, this, "pthread_mutex").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "pthread_mutex").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() {
+        ___water_threads_statistics(add_(mystatistics, this, "pthread_mutex").hold_end());
         threads::unlock(my);
     }
 
     #ifdef WATER_POSIX_TIMEOUTS
     bool lock(deadline_clock<clockid::realtime> d) noexcept {
-        ___water_threads_statistics(if(try_lock()) return true;)
-        return threads::lock(my, d);
+        ___water_threads_statistics(add_ add(mystatistics, this, "pthread_mutex"); add.wait(true).timeout(true).hold_begin(); if(threads::try_lock(my)) return true; add.wait(false);)
+        bool r = threads::lock(my, d);
+        ___water_threads_statistics(add.timeout(r));
+        return r;
     }
 
     #endif
@@ -145,7 +149,7 @@ public:
     pthread_mutex_recursive& operator=(pthread_mutex_recursive const&) = delete;
 
     void lock() {
-        ___water_threads_statistics(if(try_lock()) return;)
+        ___water_threads_statistics(threads::statistics::add add(mystatistics, this, "pthread_mutex_recursive"); add.wait(true); if(threads::try_lock(my)) return; add.wait(false);)
         threads::lock(my);
     }
 
@@ -161,8 +165,10 @@ public:
 
     #ifdef WATER_POSIX_TIMEOUTS
     bool lock(deadline_clock<clockid::realtime> d) noexcept {
-        ___water_threads_statistics(if(try_lock()) return true;)
-        return threads::lock(my, d);
+        ___water_threads_statistics(threads::statistics::add add(mystatistics, this, "pthread_mutex_recursive"); add.wait(true).timeout(true); if(threads::try_lock(my)) return true; add.wait(false);)
+        bool r = threads::lock(my, d);
+        ___water_threads_statistics(add.timeout(r));
+        return r;
     }
 
     #endif
@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -70,6 +70,7 @@ public:
 private:
     pthread_rwlock_t my = PTHREAD_RWLOCK_INITIALIZER; // this is standard only from posix issue 7
     ___water_threads_statistics(threads::statistics::reference mystatistics;)
+    ___water_threads_statistics(using add_ = threads::statistics::add;)
 
 public:
     constexpr pthread_rwlock() noexcept = default;
@@ -81,28 +82,29 @@ public:
     }
 
     void lock() {
-        ___water_threads_statistics(if(try_lock()) return;)
+        ___water_threads_statistics(add_ add(mystatistics, this, "pthread_rwlock"); add.wait(true).hold_begin(); if(threads::try_lock(my)) return; add.wait(false);)
         threads::lock(my);
     }
 
     bool try_lock() noexcept {
         bool r = threads::try_lock(my);
-        ___water_threads_statistics(threads::statistics::add(mystatistics, this, "pthread_rwlock").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "pthread_rwlock").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() {
+        ___water_threads_statistics(add_(mystatistics, this, "pthread_rwlock").hold_end());
         threads::unlock(my);
     }
 
     void read_lock() {
-        ___water_threads_statistics(if(read_try_lock()) return;)
+        ___water_threads_statistics(add_ add(mystatistics, this, "pthread_rwlock"); add.wait(true); if(threads::read_try_lock(my)) return; add.wait(false);)
         threads::read_lock(my);
     }
 
     bool read_try_lock() noexcept {
         bool r = threads::read_try_lock(my);
-        ___water_threads_statistics(threads::statistics::add(mystatistics, this, "pthread_rwlock").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "pthread_rwlock").wait(r));
         return r;
     }
 
@@ -112,13 +114,17 @@ public:
 
     #ifdef WATER_POSIX_TIMEOUTS
     bool lock(deadline_clock<clockid::realtime> d) noexcept {
-        ___water_threads_statistics(if(try_lock()) return true;)
-        return threads::lock(my, d);
+        ___water_threads_statistics(add_ add(mystatistics, this, "pthread_rwlock"); add.wait(true).timeout(true).hold_begin(); if(threads::try_lock(my)) return true; add.wait(false);)
+        bool r = threads::lock(my, d);
+        ___water_threads_statistics(add.timeout(r));
+        return r;
     }
 
     bool read_lock(deadline_clock<clockid::realtime> d) noexcept {
-        ___water_threads_statistics(if(read_try_lock()) return true;)
-        return threads::read_lock(my, d);
+        ___water_threads_statistics(add_ add(mystatistics, this, "pthread_rwlock"); add.wait(true).timeout(true); if(threads::read_try_lock(my)) return true; add.wait(false);)
+        bool r = threads::read_lock(my, d);
+        ___water_threads_statistics(add.timeout(r));
+        return r;
     }
 
     #endif
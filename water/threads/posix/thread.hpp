@@ -1,10 +1,15 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_THREADS_POSIX_THREAD_HPP
 #define WATER_THREADS_POSIX_THREAD_HPP
 #include <water/threads/posix/bits.hpp>
+#include <water/threads/cpu_mask.hpp>
+#ifdef WATER_POSIX_THREAD_AFFINITY
+    #include <fcntl.h>
+    #include <sched.h>
+#endif
 namespace water { namespace threads {
 
 bool constexpr stack_size_exists =
@@ -28,6 +33,13 @@ bool constexpr qos_exists =
     false;
     #endif
 
+bool constexpr affinity_exists =
+    #ifdef WATER_POSIX_THREAD_AFFINITY
+    true;
+    #else
+    false;
+    #endif
+
 typedef pthread_t thread_t; // this could be a struct. then things below will break
 
 struct join_t {
@@ -396,12 +408,191 @@ bool constexpr relative_priority(relative_priority_t) {
 #endif
 
 
+// affinity and numa nodes
+
+unsigned constexpr cpu_unknown = static_cast<unsigned>(-1);
+
+inline unsigned cpu_count() noexcept {
+    // number of cpus that are online, 0 if unknown
+    long c = sysconf(_SC_NPROCESSORS_ONLN);
+    return c > 0 ? static_cast<unsigned>(c) : 0;
+}
+
+#ifdef WATER_POSIX_THREAD_AFFINITY
+
+namespace _ {
+
+    inline void affinity_from(cpu_set_t const& from, cpu_mask& to) noexcept {
+        for(unsigned c = 0; c != cpu_mask::size && c != CPU_SETSIZE; ++c)
+            if(CPU_ISSET(c, &from))
+                to.add(c);
+    }
+
+    inline void affinity_to(cpu_mask const& from, cpu_set_t& to) noexcept {
+        CPU_ZERO(&to);
+        for(unsigned c = from.next(0); c < cpu_mask::size && c < CPU_SETSIZE; c = from.next(c + 1))
+            CPU_SET(c, &to);
+    }
+
+    inline bool affinity_read_list(char const* path, cpu_mask& to) noexcept {
+        // read a linux list of cpus or nodes like "0-3,8,10-11" from /sys
+        int file;
+        do file = ::open(path, O_RDONLY | O_CLOEXEC); while(file == -1 && errno == EINTR);
+        if(file == -1)
+            return false;
+        char text[4096];
+        size_t size = 0;
+        while(size != sizeof(text)) {
+            auto r = ::read(file, text + size, sizeof(text) - size);
+            if(r < 0 && errno == EINTR)
+                continue;
+            if(r <= 0)
+                break;
+            size += static_cast<size_t>(r);
+        }
+        ::close(file);
+        unsigned
+            number = 0,
+            begin = 0;
+        bool
+            digits = false,
+            range = false;
+        for(size_t i = 0; i <= size; ++i) {
+            char c = i != size ? text[i] : 0;
+            if('0' <= c && c <= '9') {
+                number = number * 10 + static_cast<unsigned>(c - '0');
+                if(number > cpu_mask::size)
+                    number = cpu_mask::size;
+                digits = true;
+            }
+            else if(c == '-' && digits && !range) {
+                begin = number;
+                number = 0;
+                digits = false;
+                range = true;
+            }
+            else {
+                if(digits && number < cpu_mask::size)
+                    to.add(range ? begin : number, number + 1);
+                number = 0;
+                digits = range = false;
+            }
+        }
+        return true;
+    }
+
+}
+
+inline unsigned cpu() noexcept {
+    // the cpu the calling thread runs on, or cpu_unknown. it can change at any time
+    int c = sched_getcpu();
+    return c < 0 ? cpu_unknown : static_cast<unsigned>(c);
+}
+
+inline cpu_mask affinity(thread_t t) noexcept {
+    // the cpus the thread can run on, empty if error
+    cpu_mask r;
+    cpu_set_t s;
+    if(!pthread_getaffinity_np(t, sizeof(s), &s))
+        _::affinity_from(s, r);
+    return r;
+}
+
+inline bool affinity(thread_t t, cpu_mask const& a) noexcept {
+    cpu_set_t s;
+    _::affinity_to(a, s);
+    return CPU_COUNT(&s) && !pthread_setaffinity_np(t, sizeof(s), &s);
+}
+
+inline unsigned node_count() noexcept {
+    // number of numa nodes. 1 if the system has no numa information
+    cpu_mask n;
+    if(!_::affinity_read_list("/sys/devices/system/node/possible", n) || !n)
+        return 1;
+    unsigned last = 0;
+    for(unsigned c = n.next(0); c != cpu_mask::size; c = n.next(c + 1))
+        last = c;
+    return last + 1;
+}
+
+inline cpu_mask node_cpus(unsigned node) noexcept {
+    // the cpus of the numa node. if the system has no numa information, node 0 is all cpus
+    char path[64] = "/sys/devices/system/node/node";
+    unsigned at = 29, n = node;
+    char digits[16];
+    unsigned d = 0;
+    do digits[d++] = static_cast<char>('0' + n % 10); while(n /= 10);
+    while(d)
+        path[at++] = digits[--d];
+    for(auto c : "/cpulist")
+        path[at++] = c;
+    cpu_mask r;
+    if(!_::affinity_read_list(path, r) && !node && node_count() == 1)
+        r.add(0, cpu_count() < cpu_mask::size ? cpu_count() : cpu_mask::size);
+    return r;
+}
+
+#else
+
+inline unsigned cpu() noexcept {
+    return cpu_unknown;
+}
+
+inline cpu_mask affinity(thread_t) noexcept {
+    return {};
+}
+
+inline bool affinity(thread_t, cpu_mask const&) noexcept {
+    return false;
+}
+
+inline unsigned node_count() noexcept {
+    return 1;
+}
+
+inline cpu_mask node_cpus(unsigned node) noexcept {
+    cpu_mask r;
+    if(!node)
+        r.add(0, cpu_count() < cpu_mask::size ? cpu_count() : cpu_mask::size);
+    return r;
+}
+
+#endif
+
+inline cpu_mask affinity(join_t a) noexcept {
+    return affinity(a.thread);
+}
+
+inline cpu_mask affinity() noexcept {
+    return affinity(thread());
+}
+
+inline bool affinity(join_t a, cpu_mask const& cpus) noexcept {
+    return affinity(a.thread, cpus);
+}
+
+inline bool affinity(cpu_mask const& cpus) noexcept {
+    // set the affinity of the calling thread
+    return affinity(thread(), cpus);
+}
+
+inline unsigned cpu_node(unsigned cpu) noexcept {
+    // the numa node of the cpu, or cpu_unknown
+    for(unsigned n = 0, s = node_count(); n != s; ++n)
+        if(node_cpus(n).has(cpu))
+            return n;
+    return cpu_unknown;
+}
+
+
 class run_options
 {
     unsigned mypriority = 0;
     int myrelative = priority_lower - 1;
     size_t mysize = 0;
     qos_t myqos = qos_error;
+    cpu_mask myaffinity;
+    unsigned mynode = 0; // node + 1
 
 public:
     constexpr run_options() noexcept = default;
@@ -433,6 +624,23 @@ public:
         return *this;
     }
 
+    run_options& affinity(cpu_mask const& a) noexcept {
+        ___water_assert(!mynode && "use one of affinity, cpu, node");
+        myaffinity = a;
+        return *this;
+    }
+
+    run_options& cpu(unsigned a) noexcept {
+        return affinity(cpu_mask{}.add(a));
+    }
+
+    run_options& node(unsigned a) noexcept {
+        // run on the cpus of numa node a
+        ___water_assert(!myaffinity && "use one of affinity, cpu, node");
+        mynode = a + 1;
+        return *this;
+    }
+
     bool to(pthread_attr_t& a) const noexcept {
         bool r = true;
         
@@ -491,6 +699,16 @@ public:
             r = e == 0;
         }
         #endif
+        #ifdef WATER_POSIX_THREAD_AFFINITY
+        if(r && (myaffinity || mynode)) {
+            cpu_set_t s;
+            _::affinity_to(mynode ? node_cpus(mynode - 1) : myaffinity, s);
+            r = CPU_COUNT(&s) && !pthread_attr_setaffinity_np(&a, sizeof(s), &s);
+        }
+        #else
+        r = r && !myaffinity && !mynode;
+        ___water_assert(!myaffinity && !mynode && "affinity used, but affinity_exists = false");
+        #endif
         return r;
     }
 };
@@ -0,0 +1,159 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_READ_WRITE_DISTRIBUTED_HPP
+#define WATER_THREADS_READ_WRITE_DISTRIBUTED_HPP
+#include <water/threads/mutex.hpp>
+#include <water/threads/pause.hpp>
+#include <water/threads/spin.hpp>
+#include <water/hardware_interference_size.hpp>
+#include <water/thread_number.hpp>
+namespace water { namespace threads {
+
+/*
+
+Read write lock for things that are read very often and written rarely. Select it with
+read_write<need_distributed>.
+
+Readers do not share one counter. There are slots_ read counters, each on its own cache line, and
+each thread uses the slot for its thread number. A read lock is one atomic add on that slot and one
+load of the write flag, so readers on different CPUs do not make the same cache line bounce.
+
+A write lock is expensive:
+- lock the mutex_, so only one writer at a time, and new readers wait on it
+- set the write flag
+- wait until every slot is 0
+
+A reader that sees the write flag removes itself from the slot, waits for the writer by locking and
+unlocking the mutex_, and tries again. Writers are never starved by readers.
+
+The size is about slots_ x hardware_destructive_interference_size bytes.
+
+read_unlock must be called by the same thread that called read_lock.
+
+*/
+
+template<typename mutex_ = mutex<>, unsigned slots_ = 64>
+class read_write_distributed
+{
+    static_assert(slots_ > 0, "");
+
+public:
+    using needs = threads::needs<
+        need_water,
+        need_distributed,
+        ifel<has_constexpr_constructor<mutex_>(), need_constexpr_constructor, need_nothing>,
+        ifel<has_trivial_destructor<mutex_>(), need_trivial_destructor, need_nothing>
+    >;
+
+    static unsigned constexpr slots = slots_;
+
+private:
+    struct alignas(hardware_destructive_interference_size) slot {
+        atomic_uint readers{0};
+    };
+
+    slot myslots[slots_];
+    alignas(hardware_destructive_interference_size) atomic_uint mywrite{0};
+    mutex_ mymutex;
+    ___water_threads_statistics(threads::statistics::reference mystatistics;)
+    ___water_threads_statistics(using add_ = threads::statistics::add;)
+
+public:
+    constexpr read_write_distributed() noexcept = default;
+    read_write_distributed(read_write_distributed const&) = delete;
+    read_write_distributed& operator=(read_write_distributed const&) = delete;
+
+    void lock() noexcept {
+        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_distributed"); add.wait(true).hold_begin();)
+        mymutex.lock();
+        mywrite.store(1, memory_order_seq_cst);
+        bool waited = wait_for_readers();
+        ___water_threads_statistics(add.wait(!waited));
+        static_cast<void>(waited);
+    }
+
+    bool try_lock() noexcept {
+        bool r = mymutex.try_lock();
+        if(r) {
+            mywrite.store(1, memory_order_seq_cst);
+            for(auto& s : myslots)
+                if(s.readers.load(memory_order_seq_cst)) {
+                    r = false;
+                    break;
+                }
+            if(!r) {
+                mywrite.store(0, memory_order_release);
+                mymutex.unlock();
+            }
+        }
+        ___water_threads_statistics(add_(mystatistics, this, "read_write_distributed").wait(r).hold_begin(r));
+        return r;
+    }
+
+    void unlock() noexcept {
+        ___water_threads_statistics(add_(mystatistics, this, "read_write_distributed").wake(true).hold_end());
+        mywrite.store(0, memory_order_release);
+        mymutex.unlock();
+    }
+
+    void read_lock() noexcept {
+        ___water_threads_statistics(add_ add(mystatistics, this, "read_write_distributed"); add.wait(true);)
+        auto& s = slot_of_thread();
+        while(!read_once(s)) {
+            ___water_threads_statistics(add.wait(false));
+            // wait for the writer
+            mymutex.lock();
+            mymutex.unlock();
+        }
+    }
+
+    bool read_try_lock() noexcept {
+        bool r = read_once(slot_of_thread());
+        ___water_threads_statistics(add_(mystatistics, this, "read_write_distributed").wait(r));
+        return r;
+    }
+
+    void read_unlock() noexcept {
+        slot_of_thread().readers.fetch_sub(1, memory_order_release);
+    }
+
+    mutex_& underlying() noexcept {
+        return mymutex;
+    }
+
+    ___water_threads_statistics(threads::statistics::data* statistics() noexcept { return get(mystatistics, this, "read_write_distributed"); })
+
+private:
+    slot& slot_of_thread() noexcept {
+        return myslots[thread_number() % slots_];
+    }
+
+    bool read_once(slot& s) noexcept {
+        // seq_cst so this and lock cannot both miss each other
+        s.readers.fetch_add(1, memory_order_seq_cst);
+        if(!mywrite.load(memory_order_seq_cst))
+            return true;
+        s.readers.fetch_sub(1, memory_order_release);
+        return false;
+    }
+
+    bool wait_for_readers() noexcept {
+        // returns true if it had to wait
+        bool r = false;
+        for(auto& s : myslots)
+            if(s.readers.load(memory_order_seq_cst)) {
+                r = true;
+                pause p = pause{}.spin(spin_times()).yield(100).sleep(0.0001);
+                do {
+                    cpu_pause();
+                    p();
+                } while(s.readers.load(memory_order_acquire));
+            }
+        return r;
+    }
+};
+
+}}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -6,6 +6,9 @@
 #define WATER_THREADS_SPIN_HPP
 #include <water/threads/yield.hpp>
 #include <water/threads/bits.hpp>
+#if defined(WATER_COMPILER_MICROSOFT) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+#endif
 #ifdef WATER_THREADS_STATISTICS
     #include <water/threads/statistics/statistics.hpp>
 #endif
@@ -47,6 +50,17 @@ public:
     }
 };
 
+inline void cpu_pause() noexcept {
+    // tell the cpu this is a spin loop. does nothing if the cpu is unknown
+    #if (defined(WATER_COMPILER_GCC) || defined(WATER_COMPILER_CLANG)) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+    #elif (defined(WATER_COMPILER_GCC) || defined(WATER_COMPILER_CLANG)) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+    #elif defined(WATER_COMPILER_MICROSOFT) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+    #endif
+}
+
 inline unsigned spin_times() noexcept {
     #ifdef WATER_THREADS_SPIN_TIMES
     return WATER_THREADS_SPIN_TIMES;
@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -38,7 +38,7 @@ public:
     }
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "spin_mutex"); add.wait(true));
+        ___water_threads_statistics(add_ add(mystatistics, this, "spin_mutex"); add.wait(true).hold_begin());
         if(lock_once()) return;
         spin s(spin_times());
         do s(); while(!lock_once());
@@ -47,11 +47,12 @@ public:
 
     bool try_lock() noexcept {
         bool r = lock_once();
-        ___water_threads_statistics(add_(mystatistics, this, "spin_mutex").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "spin_mutex").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
+        ___water_threads_statistics(add_(mystatistics, this, "spin_mutex").hold_end());
         my.store(0, memory_order_release);
     }
 
@@ -1,4 +1,4 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -58,7 +58,7 @@ public:
     }
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "spin_read_write"); add.wait(true));
+        ___water_threads_statistics(add_ add(mystatistics, this, "spin_read_write"); add.wait(true).hold_begin());
         if(write_once(true))
             return;
         spin s(spin_times());
@@ -68,11 +68,12 @@ public:
 
     bool try_lock() noexcept {
         bool r = write_once(false);
-        ___water_threads_statistics(add_(mystatistics, this, "spin_read_write").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "spin_read_write").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
+        ___water_threads_statistics(add_(mystatistics, this, "spin_read_write").hold_end());
         my.store(0, memory_order_release);
     }
 
@@ -1,10 +1,11 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_THREADS_STATISTICS_DATA_HPP
 #define WATER_THREADS_STATISTICS_DATA_HPP
 #include <water/threads/statistics/name.hpp>
+#include <water/threads/statistics/histogram.hpp>
 #include <water/xtr/base.hpp>
 namespace water { namespace threads { namespace statistics {
 
@@ -35,6 +36,13 @@ if wait completed before timeout or not.
 wait_object_created
 just a bool, if the system wait object has been created
 
+wait_time
+histogram of the time each wait took, in nanoseconds. also the good waits
+
+hold_time
+histogram of the time a lock was held, in nanoseconds. only for exclusive locks, from when the lock
+was taken to when unlock was called
+
 */
 
 class data
@@ -45,7 +53,11 @@ class data
         mywait[2] {},
         mywake[2] {},
         mytimeout[2] {},
-        mycreated {};
+        mycreated {},
+        myhold_begin {}; // nanoseconds + 1, 0 if not locked
+    histogram
+        mywait_time,
+        myhold_time;
     void const* myaddress = 0;
     char const* myclass = 0;
     statistics::name myname;
@@ -113,6 +125,30 @@ public:
     bool wait_object_created() noexcept {
         return atomic_::get(mycreated) != 0;
     }
+
+    void wait_time_add(count_t nanoseconds) noexcept {
+        mywait_time.add(nanoseconds);
+    }
+
+    histogram& wait_time() noexcept {
+        return mywait_time;
+    }
+
+    void hold_begin(count_t nanoseconds) noexcept {
+        atomic_::set(myhold_begin, nanoseconds + 1);
+    }
+
+    void hold_end(count_t nanoseconds) noexcept {
+        // the lock calls this before it is released, so only the thread holding it gets here
+        if(count_t b = atomic_::get(myhold_begin)) {
+            atomic_::set(myhold_begin, 0);
+            myhold_time.add(nanoseconds - (b - 1));
+        }
+    }
+
+    histogram& hold_time() noexcept {
+        return myhold_time;
+    }
 };
 
 inline xtr::to_buffered<name_assign> name_if(data *a) noexcept {
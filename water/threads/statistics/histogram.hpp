@@ -0,0 +1,91 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_STATISTICS_HISTOGRAM_HPP
+#define WATER_THREADS_STATISTICS_HISTOGRAM_HPP
+#include <water/threads/statistics/bits.hpp>
+#ifndef WATER_NO_STD
+    #include <chrono>
+#endif
+namespace water { namespace threads { namespace statistics {
+
+/*
+
+log2 histogram of nanoseconds. bucket 0 is 0 and 1 ns, bucket b is 2^b to 2^(b+1) - 1 ns,
+the last bucket is everything larger. each add is one relaxed atomic increment.
+
+percentile returns the end of the bucket where the percentile is, so it is at most 2x too large.
+
+*/
+
+inline count_t nanoseconds() noexcept {
+    // monotonic. wraps around, only use the difference between two of these
+    #ifndef WATER_NO_STD
+    return static_cast<count_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+    );
+    #else
+    return 0;
+    #endif
+}
+
+class histogram
+{
+    using atomic_ = atomic_if<>;
+
+public:
+    static unsigned constexpr size = 36; // the last bucket starts at 2^35 ns, about 34 seconds
+
+private:
+    count my[size] {};
+
+public:
+    constexpr histogram() noexcept = default;
+
+    void add(count_t nanoseconds) noexcept {
+        unsigned b = 0;
+        while(nanoseconds >>= 1)
+            if(++b == size - 1)
+                break;
+        atomic_::add(my[b]);
+    }
+
+    count_t at(unsigned bucket) noexcept {
+        return bucket < size ? atomic_::get(my[bucket]) : 0;
+    }
+
+    count_t total() noexcept {
+        count_t r = 0;
+        for(auto& m : my)
+            r += atomic_::get(m);
+        return r;
+    }
+
+    static double bucket_end(unsigned bucket) noexcept {
+        // nanoseconds, the largest value in the bucket + 1
+        double r = 2;
+        while(bucket--)
+            r *= 2;
+        return r;
+    }
+
+    double percentile(double p) noexcept {
+        // nanoseconds, p is 0 to 1. returns 0 if empty
+        count_t copy[size];
+        count_t all = 0;
+        for(unsigned b = 0; b != size; ++b)
+            all += copy[b] = atomic_::get(my[b]);
+        if(!all)
+            return 0;
+        double want = p * static_cast<double>(all);
+        count_t sum = 0;
+        for(unsigned b = 0; b != size; ++b)
+            if(copy[b] && static_cast<double>(sum += copy[b]) >= want)
+                return bucket_end(b);
+        return bucket_end(size - 1);
+    }
+};
+
+}}}
+#endif
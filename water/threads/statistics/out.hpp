@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -14,6 +14,48 @@ inline double out_ratio(size_t good, size_t bad) {
     return 0;
 }
 
+template<typename o_>
+void out_nanoseconds(str::out<o_>& o, double nanoseconds) {
+    if(nanoseconds < 1e4)
+        o << nanoseconds << " ns";
+    else if(nanoseconds < 1e7)
+        o << nanoseconds / 1e3 << " us";
+    else
+        o << nanoseconds / 1e6 << " ms";
+}
+
+template<typename o_>
+void out_histogram(str::out<o_>& o, char const* name, histogram& h) {
+    // the percentiles are the end of a log2 bucket, at most 2x too large
+    struct {
+        char const *label;
+        double percentile;
+    } const lines[] = {
+        {" p50 ", 0.5},
+        {" p90 ", 0.9},
+        {" p99 ", 0.99},
+        {" p99.9 ", 0.999},
+        {" max ", 1}
+    };
+    auto label = [&o, name](char const* a) {
+        unsigned s = 0;
+        o << "  ";
+        for(auto n = name; *n; ++n, ++s) o << *n;
+        for(; *a; ++a, ++s) o << *a;
+        for(; s < 19; ++s) o << '.';
+        o << ' ';
+    };
+    label(" count ");
+    o << h.total() << '\n';
+    if(!h.total())
+        return;
+    for(auto& l : lines) {
+        label(l.label);
+        out_nanoseconds(o, h.percentile(l.percentile));
+        o << '\n';
+    }
+}
+
 template<typename o_>
 void out(str::out<o_>& o) {
     size_t i = 0;
@@ -35,7 +77,10 @@ void out(str::out<o_>& o) {
             << "  timeout true ...... " << timeout[true] << '\n'
             << "  timeout false ..... " << timeout[false] << '\n'
             << "  timeout good ratio  " << out_ratio(timeout[true], timeout[false]) << '\n'
-            << "  wait_object_created " << d->wait_object_created() << '\n' << str::flush;
+            << "  wait_object_created " << d->wait_object_created() << '\n';
+        out_histogram(o, "wait time", d->wait_time());
+        out_histogram(o, "hold time", d->hold_time());
+        o << str::flush;
         ++i;
     }
     if(!i)
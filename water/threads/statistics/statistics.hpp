@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -41,27 +41,34 @@ class add
     reference *myto;
     void const* myaddress;
     char const* myclass;
+    count_t mystart;
     signed char
         mywait = -1,
         mywake = -1,
         mytimeout = -1,
-        mycreated = 0;
+        mycreated = 0,
+        myhold = 0; // 1 begin, 2 end
 
 public:
     add(reference& to, void const* address, char const* class_name) noexcept :
         myto(&to),
         myaddress(address),
-        myclass(class_name)
+        myclass(class_name),
+        mystart(nanoseconds())
     {}
 
     ~add() noexcept {
         // do everything here, after locking.
         // otherwise the atomic operations will affect statistics more?
+        count_t now = nanoseconds();
         data *d = myto->get();
         if(!d)
             d = list<>::get().create(*myto, myaddress, myclass);
         if(d) {
             if(mywait != -1) d->wait_add(mywait != 0);
+            if(mywait != -1) d->wait_time_add(now - mystart);
+            if(myhold == 1 && mytimeout != 0) d->hold_begin(now); // not if it timed out
+            if(myhold == 2) d->hold_end(mystart);
             if(mywake != -1) d->wake_add(mywake != 0);
             if(mytimeout != -1) d->timeout_add(mytimeout != 0);
             if(mycreated) d->wait_object_created_set();
@@ -96,6 +103,19 @@ public:
         mycreated = mycreated || set;
         return *this;
     }
+
+    add& hold_begin(bool locked = true) noexcept {
+        // when an exclusive lock was taken. does nothing if timeout(false)
+        if(locked)
+            myhold = 1;
+        return *this;
+    }
+
+    add& hold_end() noexcept {
+        // when an exclusive lock is unlocked
+        myhold = 2;
+        return *this;
+    }
 };
 
 }}}
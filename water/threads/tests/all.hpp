@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -7,9 +7,11 @@
 #include <water/threads/tests/bits.hpp>
 #include <water/threads/tests/barrier_all.hpp>
 #include <water/threads/tests/condition_all.hpp>
+#include <water/threads/tests/histogram.hpp>
 #include <water/threads/tests/mutex_all.hpp>
 #include <water/threads/tests/need_all.hpp>
 #include <water/threads/tests/once_all.hpp>
+#include <water/threads/tests/pool.hpp>
 #include <water/threads/tests/read_write_all.hpp>
 #include <water/threads/tests/semaphore_all.hpp>
 #include <water/threads/tests/thread_all.hpp>
@@ -28,9 +30,11 @@ inline void all() {
     #endif
     barrier_all();
     condition_all();
+    histogram();
     mutex_all();
     need_all();
     once_all();
+    pool();
     read_write_all();
     semaphore_all();
     thread_all();
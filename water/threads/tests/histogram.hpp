@@ -0,0 +1,87 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_TESTS_HISTOGRAM_HPP
+#define WATER_THREADS_TESTS_HISTOGRAM_HPP
+#include <water/threads/tests/bits.hpp>
+#include <water/threads/statistics/out.hpp>
+namespace water { namespace threads { namespace tests {
+
+/*
+
+test statistics::histogram buckets and percentiles, and the text of statistics::out_histogram
+
+*/
+
+inline void histogram_buckets() {
+    using statistics::count_t;
+    statistics::histogram h;
+    ___water_test(h.total() == 0 && h.percentile(0.5) == 0);
+    // the first and last value of each bucket
+    h.add(0);
+    h.add(1);
+    for(unsigned b = 1; b != statistics::histogram::size - 1; ++b) {
+        h.add(static_cast<count_t>(1) << b);
+        h.add((static_cast<count_t>(2) << b) - 1);
+    }
+    h.add(static_cast<count_t>(1) << (statistics::histogram::size - 1));
+    h.add(static_cast<count_t>(1) << (statistics::histogram::size + 3));
+    for(unsigned b = 0; b != statistics::histogram::size; ++b)
+        ___water_test(h.at(b) == 2);
+    ___water_test(h.at(statistics::histogram::size) == 0);
+    ___water_test(h.total() == statistics::histogram::size * 2);
+    ___water_test(statistics::histogram::bucket_end(0) == 2);
+    ___water_test(statistics::histogram::bucket_end(10) == 2048);
+}
+
+inline void histogram_percentiles(statistics::histogram& h) {
+    using statistics::count_t;
+    // 2000 values, none of the percentiles is at the edge of a bucket
+    unsigned const
+        count[] = {800, 900, 296, 3, 1};
+    count_t const
+        value[] = {1, 100, 5000, 1 << 20, static_cast<count_t>(1) << 40};
+    for(unsigned i = 0; i != 5; ++i)
+        for(unsigned c = 0; c != count[i]; ++c)
+            h.add(value[i]);
+    ___water_test(h.total() == 2000);
+    ___water_test(h.at(0) == 800 && h.at(6) == 900 && h.at(12) == 296 && h.at(20) == 3 && h.at(statistics::histogram::size - 1) == 1);
+    ___water_test(h.percentile(0) == 2);
+    ___water_test(h.percentile(0.3) == 2);
+    ___water_test(h.percentile(0.5) == 128);
+    ___water_test(h.percentile(0.9) == 8192);
+    ___water_test(h.percentile(0.99) == 8192);
+    ___water_test(h.percentile(0.999) == 2097152);
+    ___water_test(h.percentile(1) == statistics::histogram::bucket_end(statistics::histogram::size - 1));
+}
+
+inline bool histogram_out_is(statistics::histogram& h, char const* expect) {
+    char text[1000];
+    auto o = str::to_begin_end(text, text + sizeof(text));
+    statistics::out_histogram(o, "hold time", h);
+    auto t = text + 0;
+    while(t != o.end() && *expect && *t == *expect) {
+        ++t;
+        ++expect;
+    }
+    return t == o.end() && !*expect;
+}
+
+inline void histogram() {
+    histogram_buckets();
+    statistics::histogram h;
+    ___water_test(histogram_out_is(h, "  hold time count ... 0\n"));
+    histogram_percentiles(h);
+    ___water_test(histogram_out_is(h,
+        "  hold time count ... 2000\n"
+        "  hold time p50 ..... 128 ns\n"
+        "  hold time p90 ..... 8192 ns\n"
+        "  hold time p99 ..... 8192 ns\n"
+        "  hold time p99.9 ... 2097.152 us\n"
+        "  hold time max ..... 68719.476736 ms\n"
+    ));
+}
+
+}}}
+#endif
@@ -1,10 +1,11 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_THREADS_TESTS_MUTEX_ALL_HPP
 #define WATER_THREADS_TESTS_MUTEX_ALL_HPP
 #include <water/threads/tests/bits.hpp>
+#include <water/threads/tests/mutex_contention.hpp>
 #include <water/threads/tests/mutex_count.hpp>
 #include <water/threads/tests/mutex_functions.hpp>
 #include <water/threads/mutex.hpp>
@@ -15,6 +16,7 @@ struct mutex_all_tests {
     mutex_all_tests() {
         mutex_functions<mutex_>();
         mutex_count<mutex_>();
+        mutex_contention_test<mutex_>();
     }
 };
 
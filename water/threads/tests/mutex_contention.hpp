@@ -0,0 +1,104 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_TESTS_MUTEX_CONTENTION_HPP
+#define WATER_THREADS_TESTS_MUTEX_CONTENTION_HPP
+#include <water/threads/tests/bits.hpp>
+#include <water/threads/tests/run_many.hpp>
+#include <water/threads/mutex.hpp>
+#ifndef WATER_NO_STD
+    #include <water/str/out_trace.hpp>
+    #include <chrono>
+#endif
+namespace water { namespace threads { namespace tests {
+
+/*
+
+many threads lock the same mutex for a short time, the case mutex<need_adaptive> spins for. each
+thread locks, counts inside the lock, unlocks, and does some work outside the lock. the count must
+be exact and only one thread can be inside at a time.
+
+mutex_contention_test is part of mutex_all. mutex_contention_all writes the nanoseconds per lock
+of each mutex with more threads and locks, to compare them.
+
+*/
+
+template<typename mutex_>
+class mutex_contention
+{
+    mutex_ mymutex;
+    unsigned
+        mylocks,
+        myinside,
+        myoutside,
+        mycount = 0,
+        myinside_now = 0;
+
+public:
+    mutex_contention(unsigned locks, unsigned inside, unsigned outside) :
+        mylocks{locks},
+        myinside{inside},
+        myoutside{outside}
+    {}
+
+    void run(unsigned threads) {
+        run_many_reference(*this, threads);
+        ___water_test(mycount == mylocks * threads * myinside);
+    }
+
+    #ifndef WATER_NO_STD
+    double nanoseconds_per_lock(unsigned threads) {
+        auto start = std::chrono::steady_clock::now();
+        run(threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return seconds * 1e9 / (static_cast<double>(mylocks) * threads);
+    }
+    #endif
+
+    void operator()() {
+        unsigned volatile work = 0;
+        for(unsigned l = 0; l != mylocks; ++l) {
+            lock(mymutex);
+            ___water_test(++myinside_now == 1);
+            for(unsigned i = 0; i != myinside; ++i)
+                ++mycount;
+            --myinside_now;
+            unlock(mymutex);
+            for(unsigned i = 0; i != myoutside; ++i)
+                work = work + 1;
+        }
+    }
+};
+
+template<typename mutex_>
+void mutex_contention_test() {
+    mutex_contention<mutex_>{2000, 10, 100}.run(8);
+}
+
+#ifndef WATER_NO_STD
+
+template<typename mutex_, typename o_>
+void mutex_contention_one(str::out<o_>& o, char const* name, unsigned threads, unsigned inside, unsigned outside) {
+    unsigned locks = 200000 / threads;
+    o << name << ' ' << mutex_contention<mutex_>{locks, inside, outside}.nanoseconds_per_lock(threads) << " ns per lock\n";
+}
+
+inline void mutex_contention_all() {
+    str::out_trace o;
+    unsigned const threads[] = {1, 2, 4, 8, 16};
+    unsigned const work[][2] = {{1, 0}, {10, 100}, {100, 1000}}; // inside, outside
+    for(auto w : work)
+        for(auto t : threads) {
+            o << "threads " << t << " inside " << w[0] << " outside " << w[1] << '\n';
+            mutex_contention_one<mutex<need_adaptive>>(o, "mutex<need_adaptive> .", t, w[0], w[1]);
+            mutex_contention_one<mutex<need_water>>(o, "mutex<need_water> ....", t, w[0], w[1]);
+            mutex_contention_one<mutex<need_spin>>(o, "mutex<need_spin> .....", t, w[0], w[1]);
+            mutex_contention_one<mutex<need_system>>(o, "mutex<need_system> ...", t, w[0], w[1]);
+        }
+}
+
+#endif
+
+}}}
+#endif
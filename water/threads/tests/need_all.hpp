@@ -1,4 +1,4 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -17,7 +17,9 @@ inline void need_all() {
             need_recursive,
             need_constexpr_constructor,
             need_trivial_destructor,
-            need_spin
+            need_spin,
+            need_adaptive,
+            need_distributed
         >::need,
         none = needs<>::need,
         some = needs<
@@ -25,7 +27,7 @@ inline void need_all() {
             need_recursive,
             need_trivial_destructor
         >::need;
-    static_assert(all == (1 << 7) - 1, "test");
+    static_assert(all == (1 << 9) - 1, "test");
     static_assert(none == 0, "test");
     static_assert(some != 0, "test");
 }
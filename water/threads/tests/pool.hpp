@@ -0,0 +1,94 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_TESTS_POOL_HPP
+#define WATER_THREADS_TESTS_POOL_HPP
+#include <water/threads/tests/bits.hpp>
+#include <water/threads/pool.hpp>
+namespace water { namespace threads { namespace tests {
+
+/*
+
+test threads::pool run, wait, join and for_range, with and without threads, and the worker thread names
+
+*/
+
+inline unsigned pool_fibonacci(threads::pool& p, unsigned n) {
+    if(n < 2)
+        return n;
+    unsigned a, b;
+    p.join(
+        [&] { a = pool_fibonacci(p, n - 1); },
+        [&] { b = pool_fibonacci(p, n - 2); }
+    );
+    return a + b;
+}
+
+inline void pool_test(unsigned threads) {
+    threads::pool p{threads};
+    ___water_test(p.size() == threads);
+
+    // run, also from inside the pool
+    atomic<unsigned> count{0};
+    for(unsigned i = 0; i != 1000; ++i)
+        ___water_test(p.run([&p, &count] {
+            count.fetch_add(1);
+            p.run([&count] { count.fetch_add(1); });
+        }));
+    p.wait();
+    ___water_test(count.load() == 2000);
+
+    ___water_test(pool_fibonacci(p, 20) == 6765);
+
+    unsigned char done[10000] {};
+    p.for_range(0, sizeof(done), 100, [&done](size_t begin, size_t end) {
+        ___water_test(end - begin <= 100);
+        while(begin != end)
+            ++done[begin++];
+    });
+    size_t ones = 0;
+    for(auto d : done)
+        ones += d == 1;
+    ___water_test(ones == sizeof(done));
+
+    // join from inside a function running in the pool
+    count.store(0);
+    p.run([&p, &count] {
+        count.fetch_add(pool_fibonacci(p, 15));
+    });
+    p.wait();
+    ___water_test(count.load() == 610);
+}
+
+inline bool pool_name_is(unsigned index, char const* expect) {
+    char name[16];
+    threads::_::pool_worker_name(name, index);
+    auto n = name + 0;
+    while(*n && *n == *expect) {
+        ++n;
+        ++expect;
+    }
+    return !*n && !*expect;
+}
+
+inline void pool_name() {
+    // the most significant digit first
+    ___water_test(pool_name_is(0, "water pool 0"));
+    ___water_test(pool_name_is(7, "water pool 7"));
+    ___water_test(pool_name_is(12, "water pool 12"));
+    ___water_test(pool_name_is(305, "water pool 305"));
+    ___water_test(pool_name_is(4321, "water pool 4321"));
+    ___water_test(pool_name_is(98765, "water pool 9876"));
+}
+
+inline void pool() {
+    pool_name();
+    pool_test(0);
+    pool_test(1);
+    pool_test(4);
+    pool_test(16);
+}
+
+}}}
+#endif
@@ -0,0 +1,111 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_TESTS_READ_WRITE_SCALING_HPP
+#define WATER_THREADS_TESTS_READ_WRITE_SCALING_HPP
+#include <water/threads/tests/bits.hpp>
+#include <water/threads/tests/run_many.hpp>
+#include <water/threads/read_write.hpp>
+#ifndef WATER_NO_STD
+    #include <water/str/out_trace.hpp>
+    #include <chrono>
+#endif
+namespace water { namespace threads { namespace tests {
+
+/*
+
+many threads read and almost nobody writes, what read_write<need_distributed> is for. each thread
+read locks, reads 8 values, read unlocks. one lock in every writes_every is a write lock that adds
+1 to each value. a read must see 8 equal values, and at the end each value is the number of writes.
+
+read_write_scaling_test is part of read_write_all. read_write_scaling_all writes the nanoseconds per
+lock of each read_write with up to 64 threads. if reads scale, it goes down as the threads go up,
+until there are more threads than CPUs.
+
+*/
+
+template<typename read_write_>
+class read_write_scaling
+{
+    read_write_ mylock;
+    unsigned
+        mylocks,
+        mywrites_every,
+        myvalue[8] {};
+
+public:
+    read_write_scaling(unsigned locks, unsigned writes_every) :
+        mylocks{locks},
+        mywrites_every{writes_every}
+    {}
+
+    void run(unsigned threads) {
+        run_many_reference(*this, threads);
+        unsigned writes = mywrites_every ? mylocks / mywrites_every * threads : 0;
+        for(auto v : myvalue)
+            ___water_test(v == writes);
+    }
+
+    #ifndef WATER_NO_STD
+    double nanoseconds_per_lock(unsigned threads) {
+        // for all threads together
+        auto start = std::chrono::steady_clock::now();
+        run(threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return seconds * 1e9 / (static_cast<double>(mylocks) * threads);
+    }
+    #endif
+
+    void operator()() {
+        unsigned volatile sum = 0;
+        for(unsigned l = 1; l <= mylocks; ++l)
+            if(mywrites_every && !(l % mywrites_every)) {
+                mylock.lock();
+                for(auto& v : myvalue)
+                    ++v;
+                mylock.unlock();
+            }
+            else {
+                mylock.read_lock();
+                unsigned s = 0;
+                for(auto v : myvalue)
+                    s += v;
+                ___water_test(s == myvalue[0] * 8);
+                sum = sum + s;
+                mylock.read_unlock();
+            }
+    }
+};
+
+template<typename read_write_>
+void read_write_scaling_test() {
+    read_write_scaling<read_write_>{5000, 100}.run(8);
+}
+
+#ifndef WATER_NO_STD
+
+template<typename read_write_, typename o_>
+void read_write_scaling_one(str::out<o_>& o, char const* name, unsigned threads, unsigned writes_every) {
+    unsigned locks = 1000000 / threads;
+    o << name << ' ' << read_write_scaling<read_write_>{locks, writes_every}.nanoseconds_per_lock(threads) << " ns per lock\n";
+}
+
+inline void read_write_scaling_all() {
+    str::out_trace o;
+    unsigned const threads[] = {1, 2, 4, 8, 16, 32, 64};
+    unsigned const writes_every[] = {0, 10000, 100};
+    for(auto w : writes_every)
+        for(auto t : threads) {
+            o << "threads " << t << " writes every " << w << '\n';
+            read_write_scaling_one<read_write<need_distributed>>(o, "read_write<need_distributed> .", t, w);
+            read_write_scaling_one<read_write<need_water>>(o, "read_write<need_water> .......", t, w);
+            read_write_scaling_one<read_write<need_spin>>(o, "read_write<need_spin> ........", t, w);
+            read_write_scaling_one<read_write<need_system>>(o, "read_write<need_system> ......", t, w);
+        }
+}
+
+#endif
+
+}}}
+#endif
@@ -1,15 +1,17 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_THREADS_TESTS_SEMAPHORE_ALL_HPP
 #define WATER_THREADS_TESTS_SEMAPHORE_ALL_HPP
+#include <water/threads/tests/semaphore_functions.hpp>
 #include <water/threads/tests/semaphore_pong.hpp>
 namespace water { namespace threads { namespace tests {
 
 template<typename semaphore_>
 struct semaphore_all_tests {
     semaphore_all_tests() {
+        semaphore_functions<semaphore_>();
         semaphore_pong<semaphore_>();
     }
 };
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -25,18 +25,18 @@ public:
         ___water_test(a);
         ___water_test(b);
         ___water_test(down(b));
-        spin_if(b);
+        spin_if(b, static_cast<ifel<is_spin<semaphore_>(), bool, void>*>(0));
         ___water_test(b.down());
         ___water_test(!a.try_down());
         ___water_test(!b.try_down());
         ___water_test(a.up());
         ___water_test(up(b));
-        timeout_if(a);
+        timeout_if(a, static_cast<ifel<has_timeout<semaphore_>(), bool, void>*>(0));
     }
 
 private:
     template<typename a_>
-    void timeout_if(a_& a, ifel<has_timeout<m_>(), int> = 0) {
+    void timeout_if(a_& a, bool*) {
         ___water_test(down(a, 0.01));
         ___water_test(up(a));
         ___water_test(a.down(0.01));
@@ -46,19 +46,24 @@ private:
         ___water_test(a.down(deadline(0.01)));
         ___water_test(!a.down(0.001));
         ___water_test(!a.down(deadline(0.001)));
+        // the timeout must not return much too early, and it must return
+        deadline d(1);
+        ___water_test(!a.down(0.02));
+        double left = d.left();
+        ___water_test(0.5 < left && left < 0.99);
     }
 
-    template<typename s_>
-    void timeout_if(s_&, ifel<!has_timeout<m_>(), int> = 0) {
+    template<typename a_>
+    void timeout_if(a_&, void*) {
     }
 
     template<typename a_>
-    void spin_if(a_& a, ifel<is_spin<m_>(), int> = 0) {
+    void spin_if(a_& a, bool*) {
         a.spin_times(1000);
     }
 
     template<typename a_>
-    void spin_if(a_& a, ifel<!is_spin<m_>(), int> = 0) {
+    void spin_if(a_&, void*) {
     }
 };
 
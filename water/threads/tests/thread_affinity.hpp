@@ -0,0 +1,80 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_THREADS_TESTS_THREAD_AFFINITY_HPP
+#define WATER_THREADS_TESTS_THREAD_AFFINITY_HPP
+#include <water/threads/tests/bits.hpp>
+#include <water/threads/thread.hpp>
+namespace water { namespace threads { namespace tests {
+
+// each thread reads its own affinity and the cpu it runs on
+
+class thread_affinity
+{
+    cpu_mask myaffinity;
+    unsigned mycpu = cpu_unknown;
+
+public:
+    thread_affinity() {
+        cpu_mask m;
+        ___water_test(!m && !m.count() && m.next(0) == m.size && m.at(0) == m.size);
+        m.add(3).add(70).add(5, 7);
+        ___water_test(m && m.count() == 4 && m.has(3) && m.has(5) && m.has(6) && m.has(70) && !m.has(4));
+        ___water_test(m.next(0) == 3 && m.next(4) == 5 && m.next(7) == 70 && m.next(71) == m.size);
+        ___water_test(m.at(0) == 3 && m.at(3) == 70 && m.at(4) == 3);
+        m.remove(70);
+        ___water_test(m.count() == 3 && m.next(7) == m.size);
+
+        unsigned nodes = node_count();
+        ___water_test(nodes >= 1);
+        ___water_test(node_cpus(nodes) == cpu_mask{} || !affinity_exists);
+
+        if(!affinity_exists)
+            return;
+
+        ___water_test(cpu_count() >= 1);
+        cpu_mask allowed = affinity();
+        ___water_test(allowed);
+        ___water_test(cpu() == cpu_unknown || allowed.has(cpu()));
+        ___water_test(cpu_node(allowed.next(0)) < nodes);
+
+        // pin to each allowed cpu, at most 4
+        unsigned c = allowed.next(0);
+        for(unsigned i = 0; i != 4 && c != allowed.size; ++i, c = allowed.next(c + 1)) {
+            join_t j;
+            bool ok = run(*this, j, run_options{}.cpu(c));
+            ___water_test(ok);
+            if(ok) {
+                ___water_test(join(j));
+                ___water_test(myaffinity == cpu_mask{}.add(c));
+                ___water_test(mycpu == c || mycpu == cpu_unknown);
+            }
+        }
+
+        // node 0 if it has cpus this process can use
+        cpu_mask node = node_cpus(cpu_node(allowed.next(0)));
+        node &= allowed;
+        join_t j;
+        bool ok = run(*this, j, run_options{}.node(cpu_node(allowed.next(0))));
+        ___water_test(ok);
+        if(ok) {
+            ___water_test(join(j));
+            cpu_mask mine = myaffinity;
+            mine &= node;
+            ___water_test(mine && mine.count() <= node_cpus(cpu_node(allowed.next(0))).count());
+        }
+
+        // the calling thread
+        ___water_test(affinity(allowed));
+        ___water_test(affinity() == allowed);
+    }
+
+    void operator()() {
+        myaffinity = affinity();
+        mycpu = cpu();
+    }
+};
+
+}}}
+#endif
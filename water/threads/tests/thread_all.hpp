@@ -1,9 +1,10 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_THREADS_TESTS_THREAD_ALL_HPP
 #define WATER_THREADS_TESTS_THREAD_ALL_HPP
+#include <water/threads/tests/thread_affinity.hpp>
 #include <water/threads/tests/thread_priority.hpp>
 #include <water/threads/tests/thread_relative_priority.hpp>
 #include <water/threads/tests/thread_run.hpp>
@@ -14,6 +15,7 @@
 namespace water { namespace threads { namespace tests {
 
 inline void thread_all() {
+    thread_affinity();
     thread_priority();
     thread_relative_priority();
     thread_run();
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -33,7 +33,8 @@ bool constexpr
     priority_exists = true,
     stack_size_exists = true,
     qos_exists = true,
-    relative_priority_exists = true;
+    relative_priority_exists = true,
+    affinity_exists = true;
 
 thread_t thread() noexcept;
 
@@ -54,6 +55,10 @@ public:
     run_options& relative_priority(relative_priority_t a) noexcept;
     run_options& qos(qos_t a) noexcept;
     // use one of priority, qos, relative_priority. they cannot be combined
+    run_options& affinity(cpu_mask const& a) noexcept;
+    run_options& cpu(unsigned a) noexcept;
+    run_options& node(unsigned a) noexcept;
+    // use one of affinity, cpu, node. if affinity_exists is false, run fails if they are used
 };
 
 template<typename call_> bool run(typename call_::pointer pointer, run_options const& options = {}) noexcept;
@@ -111,6 +116,27 @@ enum relative_priority_t {
 
 inline bool relative_priority(relative_priority_t);
 
+// affinity, the cpus a thread can run on. only linux for now, see affinity_exists.
+// cpu_mask is in cpu_mask.hpp
+
+unsigned constexpr cpu_unknown = static_cast<unsigned>(-1);
+
+unsigned cpu_count() noexcept; // online cpus, 0 if unknown
+unsigned cpu() noexcept; // the cpu the calling thread runs on now, or cpu_unknown
+
+cpu_mask affinity(thread_t) noexcept; // empty if error
+cpu_mask affinity(join_t) noexcept;
+cpu_mask affinity() noexcept;
+bool affinity(thread_t, cpu_mask const&) noexcept;
+bool affinity(join_t, cpu_mask const&) noexcept;
+bool affinity(cpu_mask const&) noexcept;
+
+// numa nodes are 0 to node_count() - 1. without numa information there is 1 node with all cpus
+
+unsigned node_count() noexcept;
+cpu_mask node_cpus(unsigned node) noexcept; // empty if the node does not exist
+unsigned cpu_node(unsigned cpu) noexcept; // or cpu_unknown
+
 #endif
 
 
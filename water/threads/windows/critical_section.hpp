@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -59,7 +59,7 @@ public:
     critical_section& operator=(critical_section const&) = delete;
 
     void lock() noexcept {
-        ___water_threads_statistics(if(try_lock()) return;)
+        ___water_threads_statistics(threads::statistics::add add(mystatistics, this, "critical_section"); add.wait(true); if(threads::try_lock(my)) return; add.wait(false);)
         threads::lock(my);
     }
 
@@ -1,4 +1,4 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -31,7 +31,7 @@ public:
     }
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event"); add.wait(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event"); add.wait(true).hold_begin();)
         if(!mylock.fetch_add(1, memory_order_acquire))
             return;
         ___water_threads_statistics(add.wait(false));
@@ -50,7 +50,7 @@ public:
     }
 
     bool lock(deadline d) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event"); add.wait(true).timeout(true));
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event"); add.wait(true).timeout(true).hold_begin());
         if(!mylock.fetch_add(1, memory_order_acquire))
             return true;
         ___water_threads_statistics(add.wait(false).timeout(false));
@@ -75,12 +75,12 @@ public:
     bool try_lock() noexcept {
         decltype(mylock.load()) x;
         bool r = mylock.compare_exchange_strong(x = 0, 1, memory_order_acquire);
-        ___water_threads_statistics(add_(mystatistics, this, "mutex_event").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_event").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event"); add.wake(true));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_event").hold_end(); add_ add(mystatistics, this, "mutex_event"); add.wake(true));
         if(mylock.exchange(0, memory_order_release) > 1) {
             void *e = myevent.load(memory_order_relaxed);
             if(e && e != handle_bad) {
@@ -119,7 +119,7 @@ public:
     mutex_event_named& operator=(mutex_event_named const&) = delete;
 
     void lock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event_named"); add.wait(true);)
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event_named"); add.wait(true).hold_begin();)
         if(!mylock.fetch_add(1, memory_order_acquire))
             return;
         ___water_threads_statistics(add.wait(false));
@@ -138,7 +138,7 @@ public:
     }
 
     bool lock(deadline d) noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event_named"); add.wait(true).timeout(true));
+        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event_named"); add.wait(true).timeout(true).hold_begin());
         if(!mylock.fetch_add(1, memory_order_acquire))
             return true;
         ___water_threads_statistics(add.wait(false).timeout(false));
@@ -161,12 +161,12 @@ public:
     bool try_lock() noexcept {
         decltype(mylock.load()) x;
         bool r = mylock.compare_exchange_strong(x = 0, 1, memory_order_acquire);
-        ___water_threads_statistics(add_(mystatistics, this, "mutex_event_named").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_event_named").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
-        ___water_threads_statistics(add_ add(mystatistics, this, "mutex_event_named"); add.wake(true));
+        ___water_threads_statistics(add_(mystatistics, this, "mutex_event_named").hold_end(); add_ add(mystatistics, this, "mutex_event_named"); add.wake(true));
         if(mylock.exchange(0, memory_order_release) > 1) {
             handle_close e(OpenEventW(event_modify_state, 0, name("mutex_event_named", this)));
             if(e.get()) {
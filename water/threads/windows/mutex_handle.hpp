@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -32,7 +32,7 @@ public:
     mutex_handle& operator=(mutex_handle const&) = delete;
 
     void lock() {
-        ___water_threads_statistics(if(try_lock()) return;)
+        ___water_threads_statistics(threads::statistics::add add(mystatistics, this, "mutex_handle"); add.wait(true); if(handle_wait(my, 0) == 0) return; add.wait(false);)
         panic_if(handle_wait(my));
     }
 
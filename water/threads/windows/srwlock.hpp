@@ -1,4 +1,4 @@
-// Copyright 2017 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -39,6 +39,7 @@ public:
 private:
     srwlock_t my{};
     ___water_threads_statistics(threads::statistics::reference mystatistics;)
+    ___water_threads_statistics(using add_ = threads::statistics::add;)
 
 public:
     constexpr srwlock() = default;
@@ -46,28 +47,29 @@ public:
     srwlock& operator=(srwlock const&) = delete;
 
     void lock() noexcept {
-        ___water_threads_statistics(if(try_lock()) return;)
+        ___water_threads_statistics(add_ add(mystatistics, this, "srwlock"); add.wait(true).hold_begin(); if(threads::try_lock(my)) return; add.wait(false);)
         threads::lock(my);
     }
 
     bool try_lock() noexcept {
         bool r = threads::try_lock(my);
-        ___water_threads_statistics(threads::statistics::add(mystatistics, this, "srwlock").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "srwlock").wait(r).hold_begin(r));
         return r;
     }
 
     void unlock() noexcept {
+        ___water_threads_statistics(add_(mystatistics, this, "srwlock").hold_end());
         threads::unlock(my);
     }
 
     void read_lock() noexcept {
-        ___water_threads_statistics(if(read_try_lock()) return;)
+        ___water_threads_statistics(add_ add(mystatistics, this, "srwlock"); add.wait(true); if(threads::read_try_lock(my)) return; add.wait(false);)
         threads::read_lock(my);
     }
 
     bool read_try_lock() noexcept {
         bool r = threads::read_try_lock(my);
-        ___water_threads_statistics(threads::statistics::add(mystatistics, this, "srwlock").wait(r));
+        ___water_threads_statistics(add_(mystatistics, this, "srwlock").wait(r));
         return r;
     }
 
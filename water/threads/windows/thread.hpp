@@ -1,10 +1,11 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_THREADS_WINDOWS_THREAD_HPP
 #define WATER_THREADS_WINDOWS_THREAD_HPP
 #include <water/threads/windows/bits.hpp>
+#include <water/threads/cpu_mask.hpp>
 #if \
 defined(__MINGW32__) && \
 !defined(WATER_THREADS_USE_BEGINTHREADEX) && \
@@ -20,7 +21,8 @@ bool constexpr
     priority_exists = true,
     stack_size_exists = true,
     qos_exists = false,
-    relative_priority_exists = true;
+    relative_priority_exists = true,
+    affinity_exists = false;
 
 using thread_t = dword_t;
 // 0 is not a valid thread id because GetThreadId(handle) returns 0 if it fails
@@ -251,6 +253,54 @@ inline bool qos(qos_t) noexcept {
     return false;
 }
 
+// affinity is not implemented on windows
+
+unsigned constexpr cpu_unknown = static_cast<unsigned>(-1);
+
+inline unsigned cpu_count() noexcept {
+    return 0;
+}
+
+inline unsigned cpu() noexcept {
+    return cpu_unknown;
+}
+
+inline cpu_mask affinity(thread_t) noexcept {
+    return {};
+}
+
+inline cpu_mask affinity(join_t) noexcept {
+    return {};
+}
+
+inline cpu_mask affinity() noexcept {
+    return {};
+}
+
+inline bool affinity(thread_t, cpu_mask const&) noexcept {
+    return false;
+}
+
+inline bool affinity(join_t, cpu_mask const&) noexcept {
+    return false;
+}
+
+inline bool affinity(cpu_mask const&) noexcept {
+    return false;
+}
+
+inline unsigned node_count() noexcept {
+    return 1;
+}
+
+inline cpu_mask node_cpus(unsigned) noexcept {
+    return {};
+}
+
+inline unsigned cpu_node(unsigned) noexcept {
+    return cpu_unknown;
+}
+
 template<typename call_>
 #ifdef WATER_THREADS_NO_BEGINTHREADEX
 dword_t WATER_WINDOWS_CALLTYPE
@@ -316,6 +366,7 @@ class run_options
     int mypriority = thread_priority_normal; // is 0
     security_attributes_t *mysecurity = 0;
     size_t mysize = 0;
+    bool myaffinity = false;
 
 public:
     constexpr run_options() noexcept = default;
@@ -342,6 +393,25 @@ public:
         return *this;
     }
 
+    run_options& affinity(cpu_mask const& a) noexcept {
+        ___water_assert(!a && "affinity used, but affinity_exists = false");
+        myaffinity = static_cast<bool>(a);
+        return *this;
+    }
+
+    run_options& cpu(unsigned) noexcept {
+        return affinity(cpu_mask{}.add(0));
+    }
+
+    run_options& node(unsigned) noexcept {
+        return affinity(cpu_mask{}.add(0));
+    }
+
+    bool affinity() const noexcept {
+        // true if affinity, cpu or node was used. then run will fail
+        return myaffinity;
+    }
+
     int priority_windows() const noexcept {
         // returns the windows priority, or int-min if error
         return mypriority;
@@ -378,11 +448,15 @@ public:
 template<typename call_>
 bool run(typename call_::pointer p, join_t& j, run_options const& o = run_options()) noexcept {
     thread_t id;
+    if(o.affinity())
+        return false;
     return (j.handle = run<call_>(id, p, o.security(), o.stack_size(), o.flags(), o.priority_windows())) != 0;
 }
 
 template<typename call_>
 bool run(typename call_::pointer p, thread_t& t, run_options const& o = run_options()) noexcept {
+    if(o.affinity())
+        return false;
     if(void *h = run<call_>(t, p, o.security(), o.stack_size(), o.flags(), o.priority_windows())) {
         CloseHandle(h);
         return true;
@@ -1,4 +1,4 @@
-// Copyright 2018-2023 Johan Paulsson
+// Copyright 2018-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -7,12 +7,14 @@
 #include <water/unicode/tests/conversion.hpp>
 #include <water/unicode/tests/adjust_end.hpp>
 #include <water/unicode/tests/template_deduction.hpp>
+#include <water/unicode/tests/utf_bulk.hpp>
 namespace water { namespace unicode { namespace tests {
 
 inline void all() {
     conversion{};
     adjust_end();
     template_deduction();
+    utf_bulk();
 }
 
 }}}
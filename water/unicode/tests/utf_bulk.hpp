@@ -0,0 +1,225 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_UNICODE_TESTS_UTF_BULK_HPP
+#define WATER_UNICODE_TESTS_UTF_BULK_HPP
+#include <water/unicode/unicode.hpp>
+#include <water/downgrade_iterators/downgrade_iterators.hpp>
+#include <water/vector.hpp>
+#include <water/int.hpp>
+#include <water/test.hpp>
+namespace water { namespace unicode { namespace tests {
+
+/*
+
+utf_length<8> and utf_from_utf use utf_bulk.hpp when they get pointers. compare them to the same
+thing with downgrade_iterators::forward, that never uses it.
+
+random text with ascii, latin, cjk and emoji, the same text with one byte changed, and invalid
+sequences at every position around the 16 byte blocks.
+
+*/
+
+class utf_bulk_random {
+    uint32_t my = 0x9e3779b9u;
+public:
+    unsigned operator()(unsigned n) {
+        my ^= my << 13;
+        my ^= my >> 17;
+        my ^= my << 5;
+        return static_cast<unsigned>(my % n);
+    }
+};
+
+inline char32_t utf_bulk_codepoint(utf_bulk_random& random, unsigned kind) {
+    switch(kind) {
+        case 0: return static_cast<char32_t>(random(0x80));
+        case 1: return static_cast<char32_t>(0x80 + random(0x800 - 0x80));
+        case 2: {
+            char32_t c = static_cast<char32_t>(0x800 + random(0x10000 - 0x800));
+            return 0xd800 <= c && c <= 0xdfff ? c - 0x800 : c;
+        }
+    }
+    return static_cast<char32_t>(0x10000 + random(0x110000 - 0x10000));
+}
+
+template<typename a_, typename b_>
+bool utf_bulk_equal(a_ const* ab, a_ const* ae, b_ const* bb, b_ const* be) {
+    if(ae - ab != be - bb)
+        return false;
+    while(ab != ae)
+        if(*ab++ != *bb++)
+            return false;
+    return true;
+}
+
+inline void utf_bulk_length_test(uchar_t const* text, size_t size) {
+    auto forward = [](uchar_t const* a) { return downgrade_iterators::forward<uchar_t const*>(a); };
+    utf_length<8>
+        a{text, size},
+        b{forward(text), size},
+        c{text, text + size},
+        d{text, size, utf_verify_not_0{}},
+        e{forward(text), size, utf_verify_not_0{}},
+        f{text, text + size, utf_verify_not_0{}};
+    ___water_test(static_cast<bool>(a) == static_cast<bool>(b));
+    ___water_test(a.utf8_until_error() == b.utf8_until_error());
+    ___water_test(a.utf16_until_error() == b.utf16_until_error());
+    ___water_test(a.utf32_until_error() == b.utf32_until_error());
+    ___water_test(static_cast<bool>(c) == static_cast<bool>(b));
+    ___water_test(c.utf8_until_error() == b.utf8_until_error());
+    ___water_test(c.utf16_until_error() == b.utf16_until_error());
+    ___water_test(c.utf32_until_error() == b.utf32_until_error());
+    ___water_test(static_cast<bool>(d) == static_cast<bool>(e));
+    ___water_test(d.utf8_until_error() == e.utf8_until_error());
+    ___water_test(d.utf16_until_error() == e.utf16_until_error());
+    ___water_test(d.utf32_until_error() == e.utf32_until_error());
+    ___water_test(static_cast<bool>(f) == static_cast<bool>(e));
+    ___water_test(f.utf8_until_error() == e.utf8_until_error());
+    ___water_test(f.utf16_until_error() == e.utf16_until_error());
+    ___water_test(f.utf32_until_error() == e.utf32_until_error());
+}
+
+template<unsigned to_, typename to_char_>
+void utf_bulk_from_8_test(uchar_t const* text, size_t size) {
+    auto forward = [](uchar_t const* a) { return downgrade_iterators::forward<uchar_t const*>(a); };
+    vector<to_char_>
+        a(size + 1),
+        b(size + 1);
+    auto ae = utf_from_utf_verify<to_, 8>(a.begin(), text, size);
+    auto be = utf_from_utf_verify<to_, 8>(b.begin(), forward(text), size);
+    ___water_test(ae.size() == be.size());
+    ___water_test(utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+    ae = utf_from_utf_verify<to_, 8>(a.begin(), text, text + size);
+    ___water_test(ae.size() == be.size());
+    ___water_test(utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+    if(!be.size() && size)
+        return;
+    ae = utf_from_utf<to_, 8>(a.begin(), text, size);
+    ___water_test(ae.size() == be.size() && ae.end() == a.begin() + ae.size());
+    ___water_test(utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+    ae = utf_from_utf<to_, 8>(a.begin(), text, text + size);
+    ___water_test(ae.size() == be.size() && ae.end() == a.begin() + ae.size());
+    ___water_test(utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+    // and back to utf-8
+    vector<uchar_t> c(size + 1);
+    to_char_ const *from = a.begin();
+    auto ce = utf_from_utf<8, to_>(c.begin(), from, ae.size());
+    ___water_test(ce.size() == size && utf_bulk_equal(c.begin(), c.begin() + size, text, text + size));
+    ce = utf_from_utf_verify<8, to_>(c.begin(), from, from + ae.size());
+    ___water_test(ce.size() == size && utf_bulk_equal(c.begin(), c.begin() + size, text, text + size));
+}
+
+inline void utf_bulk_test(uchar_t const* text, size_t size) {
+    utf_bulk_length_test(text, size);
+    utf_bulk_from_8_test<16, char16_t>(text, size);
+    utf_bulk_from_8_test<32, char32_t>(text, size);
+}
+
+inline void utf_bulk() {
+    utf_bulk_random random;
+    vector<uchar_t> text;
+    for(unsigned repeat = 0; repeat != 2000; ++repeat) {
+        // mostly one kind of text, with some of the others
+        text.clear();
+        unsigned
+            main = random(4),
+            codepoints = random(200);
+        while(codepoints--) {
+            unsigned kind = random(4) ? main : random(4);
+            unsigned run = kind ? 1 : 1 + random(40);
+            while(run--) {
+                uchar_t e[4];
+                unsigned n = utf8_encode(e, utf_bulk_codepoint(random, kind));
+                text.insert(text.end(), e, e + n);
+            }
+        }
+        utf_bulk_test(text.begin(), text.size());
+        if(!text.size())
+            continue;
+        // change one byte, or remove the end
+        size_t at = random(static_cast<unsigned>(text.size()));
+        switch(random(4)) {
+            case 0: text[at] = static_cast<uchar_t>(random(0x100)); break;
+            case 1: text[at] = static_cast<uchar_t>(0x80 + random(0x40)); break;
+            case 2: text[at] = 0; break;
+            default: text.resize(at);
+        }
+        utf_bulk_test(text.begin(), text.size());
+    }
+    uchar_t const invalid[][5] = {
+        {1, 0x80},
+        {1, 0xbf},
+        {2, 0xc0, 0x80},
+        {2, 0xc1, 0xbf},
+        {2, 0xe0, 0xa0},
+        {3, 0xe0, 0x9f, 0x80},
+        {3, 0xed, 0xa0, 0x80},
+        {3, 0xed, 0xbf, 0xbf},
+        {2, 0xef, 0xbf},
+        {4, 0xf0, 0x8f, 0xbf, 0xbf},
+        {3, 0xf0, 0x90, 0x80},
+        {4, 0xf4, 0x90, 0x80, 0x80},
+        {4, 0xf5, 0x80, 0x80, 0x80},
+        {1, 0xff},
+        {2, 0xc2, 0xc2},
+        {3, 0xe1, 0x80, 'a'},
+        {4, 0xf1, 0x80, 0x80, 0xc2},
+        {1, 0}
+    };
+    uchar_t const valid[][5] = {
+        {2, 0xc2, 0x80},
+        {3, 0xe0, 0xa0, 0x80},
+        {3, 0xed, 0x9f, 0xbf},
+        {3, 0xee, 0x80, 0x80},
+        {4, 0xf0, 0x90, 0x80, 0x80},
+        {4, 0xf4, 0x8f, 0xbf, 0xbf}
+    };
+    auto sequence_test = [&text](uchar_t const* sequence) {
+        for(size_t size = sequence[0]; size != 80; ++size)
+            for(size_t at = 0; at <= size - sequence[0]; ++at) {
+                text.clear();
+                text.resize(size, 'a');
+                for(size_t i = 0; i != sequence[0]; ++i)
+                    text[at + i] = sequence[1 + i];
+                utf_bulk_test(text.begin(), text.size());
+            }
+    };
+    for(auto& sequence : valid)
+        sequence_test(sequence);
+    for(auto& sequence : invalid)
+        sequence_test(sequence);
+    // from utf-16 and utf-32 to utf-8
+    for(unsigned repeat = 0; repeat != 200; ++repeat) {
+        vector<char32_t> text32;
+        unsigned codepoints = random(300);
+        while(codepoints--)
+            text32.push_back(utf_bulk_codepoint(random, random(8) < 6 ? 0 : random(4)));
+        vector<char16_t> text16(text32.size() * 2);
+        text16.resize(utf_from_utf<16, 32>(text16.begin(), text32.begin(), text32.size()).size());
+        vector<uchar_t>
+            a(text32.size() * 4),
+            b(text32.size() * 4);
+        char32_t const *from32 = text32.begin();
+        char16_t const *from16 = text16.begin();
+        auto be = utf_from_utf<8, 32>(b.begin(), downgrade_iterators::forward<char32_t const*>(from32), text32.size());
+        auto ae = utf_from_utf<8, 32>(a.begin(), from32, text32.size());
+        ___water_test(ae.size() == be.size() && utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+        ae = utf_from_utf_verify<8, 32>(a.begin(), from32, from32 + text32.size());
+        ___water_test(ae.size() == be.size() && utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+        ae = utf_from_utf<8, 16>(a.begin(), from16, text16.size());
+        ___water_test(ae.size() == be.size() && utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+        ae = utf_from_utf_verify<8, 16>(a.begin(), from16, from16 + text16.size());
+        ___water_test(ae.size() == be.size() && utf_bulk_equal(a.begin(), a.begin() + ae.size(), b.begin(), b.begin() + be.size()));
+        if(text32.size()) {
+            // an invalid codepoint somewhere
+            size_t at = random(static_cast<unsigned>(text32.size()));
+            text32[at] = 0xd800;
+            ___water_test(!utf_from_utf_verify<8, 32>(a.begin(), from32, text32.size()).size());
+        }
+    }
+}
+
+}}}
+#endif
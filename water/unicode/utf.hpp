@@ -1,10 +1,11 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_UNICODE_UTF_HPP
 #define WATER_UNICODE_UTF_HPP
 #include <water/unicode/bits.hpp>
+#include <water/unicode/utf_bulk.hpp>
 namespace water { namespace unicode {
 
 /*
@@ -1157,8 +1158,12 @@ utf_from_utf_return<to_iterator_> utf_from_utf(
     static_assert(from_ == 8 || from_ == 16 || from_ == 32, "from_ must be 8, 16, 32");
     size_t to_size = 0;
     char32_t c;
-    while(utf_decode_and_move<from_>(c, from, from_size))
+    while(true) {
+        to_size += _::utf_bulk_ascii<to_, from_>(to, from, from_size);
+        if(!utf_decode_and_move<from_>(c, from, from_size))
+            break;
         to_size += utf_encode_and_move<to_>(to, c);
+    }
     return { to, to_size };
 }
 
@@ -1172,8 +1177,12 @@ utf_from_utf_return<to_iterator_> utf_from_utf(
     static_assert(from_ == 8 || from_ == 16 || from_ == 32, "from_ must be 8, 16, 32");
     size_t to_size = 0;
     char32_t c;
-    while(utf_decode_and_move<from_>(c, from, from_end))
+    while(true) {
+        to_size += _::utf_bulk_ascii<to_, from_>(to, from, from_end);
+        if(!utf_decode_and_move<from_>(c, from, from_end))
+            break;
         to_size += utf_encode_and_move<to_>(to, c);
+    }
     return { to, to_size };
 }
 
@@ -1219,6 +1228,9 @@ utf_from_utf_return<to_iterator_> utf_from_utf_verify(
     static_assert(from_ == 8 || from_ == 16 || from_ == 32, "from_ must be 8, 16, 32");
     size_t to_size = 0;
     while(from_size) {
+        to_size += _::utf_bulk_ascii<to_, from_>(to, from, from_size);
+        if(!from_size)
+            break;
         char32_t c;
         if(!utf_decode_verify_and_move<from_>(c, from, from_size))
             return { to, 0 };
@@ -1237,6 +1249,9 @@ utf_from_utf_return<to_iterator_> utf_from_utf_verify(
     static_assert(from_ == 8 || from_ == 16 || from_ == 32, "from_ must be 8, 16, 32");
     size_t to_size = 0;
     while(from != from_end) {
+        to_size += _::utf_bulk_ascii<to_, from_>(to, from, from_end);
+        if(from == from_end)
+            break;
         char32_t c;
         if(!utf_decode_verify_and_move<from_>(c, from, from_end))
             return { to, 0 };
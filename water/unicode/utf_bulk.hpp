@@ -0,0 +1,387 @@
+// Copyright 2026 Johan Paulsson
+// This file is part of the Water C++ Library. It is licensed under the MIT License.
+// See the license.txt file in this distribution or https://watercpp.com/license.txt
+//\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
+#ifndef WATER_UNICODE_UTF_BULK_HPP
+#define WATER_UNICODE_UTF_BULK_HPP
+#include <water/unicode/bits.hpp>
+#include <water/simd.hpp>
+namespace water { namespace unicode {
+
+/*
+
+Used by utf_from_utf and utf_length<8> when the input and output are pointers, to look at 16 bytes
+at a time with SSE2, SSSE3 or AVX2 when water/simd.hpp says they can be used.
+
+- utf_from_utf copies ASCII between UTF-8 and UTF-16 or UTF-32 one block at a time. Everything else
+  is still converted one codepoint at a time.
+- utf_length<8> verifies and counts UTF-8 with the lookup tables from "Validating UTF-8 In Less
+  Than One Instruction Per Byte" by John Keiser and Daniel Lemire, when SSSE3 can be used. With
+  only SSE2 it skips ASCII one block at a time.
+
+The result is always the same as without this.
+
+*/
+
+namespace _ {
+
+    template<typename iterator_>
+    struct utf_bulk_pointer {
+        static unsigned constexpr bits = 0;
+    };
+
+    template<typename char_>
+    struct utf_bulk_pointer<char_*> {
+        static unsigned constexpr bits = sizeof(char_) * 8;
+    };
+
+    template<unsigned to_, unsigned from_, typename to_iterator_, typename from_iterator_>
+    bool constexpr utf_bulk =
+        #ifdef WATER_SIMD_SSE2
+        to_ != from_ && (to_ == 8 || from_ == 8) &&
+        utf_bulk_pointer<to_iterator_>::bits == to_ &&
+        utf_bulk_pointer<from_iterator_>::bits == from_;
+        #else
+        false;
+        #endif
+
+    template<typename iterator_>
+    bool constexpr utf8_bulk =
+        #ifdef WATER_SIMD_SSE2
+        utf_bulk_pointer<iterator_>::bits == 8;
+        #else
+        false;
+        #endif
+
+    #ifdef WATER_SIMD_SSE2
+
+    inline __m128i utf_bulk_load(void const* at) {
+        return _mm_loadu_si128(static_cast<__m128i const*>(at));
+    }
+
+    inline void utf_bulk_store(void *at, __m128i a) {
+        _mm_storeu_si128(static_cast<__m128i*>(at), a);
+    }
+
+    template<typename to_, typename from_>
+    size_t utf_bulk_ascii_prefix(to_ *to, from_ const* from, size_t size) {
+        // copy the ascii before the first non-ascii in a block
+        size_t r = 0;
+        while(r != size && from[r] < 0x80) {
+            to[r] = static_cast<to_>(from[r]);
+            ++r;
+        }
+        return r;
+    }
+
+    template<typename to_>
+    size_t utf_bulk_ascii_from_8(to_ *to, uchar_t const* from, size_t size) {
+        // to_ is 16 or 32 bit
+        __m128i const zero = _mm_setzero_si128();
+        size_t r = 0;
+        while(size - r >= 16) {
+            __m128i v = utf_bulk_load(from + r);
+            if(_mm_movemask_epi8(v))
+                return r + utf_bulk_ascii_prefix(to + r, from + r, 16);
+            __m128i
+                lo = _mm_unpacklo_epi8(v, zero),
+                hi = _mm_unpackhi_epi8(v, zero);
+            if(sizeof(to_) == 2) {
+                utf_bulk_store(to + r, lo);
+                utf_bulk_store(to + r + 8, hi);
+            }
+            else {
+                utf_bulk_store(to + r, _mm_unpacklo_epi16(lo, zero));
+                utf_bulk_store(to + r + 4, _mm_unpackhi_epi16(lo, zero));
+                utf_bulk_store(to + r + 8, _mm_unpacklo_epi16(hi, zero));
+                utf_bulk_store(to + r + 12, _mm_unpackhi_epi16(hi, zero));
+            }
+            r += 16;
+        }
+        return r;
+    }
+
+    inline size_t utf_bulk_ascii_to_8(uchar_t *to, char16_t const* from, size_t size) {
+        __m128i const high = _mm_set1_epi16(static_cast<short>(0xff80));
+        size_t r = 0;
+        while(size - r >= 16) {
+            __m128i
+                a = utf_bulk_load(from + r),
+                b = utf_bulk_load(from + r + 8);
+            if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), high), _mm_setzero_si128())) != 0xffff)
+                return r + utf_bulk_ascii_prefix(to + r, from + r, 16);
+            utf_bulk_store(to + r, _mm_packus_epi16(a, b));
+            r += 16;
+        }
+        return r;
+    }
+
+    inline size_t utf_bulk_ascii_to_8(uchar_t *to, char32_t const* from, size_t size) {
+        __m128i const high = _mm_set1_epi32(static_cast<int>(0xffffff80));
+        size_t r = 0;
+        while(size - r >= 16) {
+            __m128i
+                a = utf_bulk_load(from + r),
+                b = utf_bulk_load(from + r + 4),
+                c = utf_bulk_load(from + r + 8),
+                d = utf_bulk_load(from + r + 12);
+            __m128i x = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+            if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(x, high), _mm_setzero_si128())) != 0xffff)
+                return r + utf_bulk_ascii_prefix(to + r, from + r, 16);
+            utf_bulk_store(to + r, _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+            r += 16;
+        }
+        return r;
+    }
+
+    template<unsigned utf_, typename to_>
+    ifel<utf_ == 8, uchar_t*> utf_bulk_to_8(to_ *to) {
+        return static_cast<uchar_t*>(static_cast<void*>(to));
+    }
+
+    template<unsigned utf_, typename to_>
+    ifel<utf_ != 8, to_*> utf_bulk_to_8(to_ *to) {
+        return to;
+    }
+
+    template<typename to_, typename from_>
+    size_t utf_bulk_ascii_do(to_ *to, from_ const* from, size_t size) {
+        using to_char = ifel<sizeof(to_) == 2, char16_t, char32_t>;
+        return utf_bulk_ascii_from_8(static_cast<to_char*>(static_cast<void*>(to)), static_cast<uchar_t const*>(static_cast<void const*>(from)), size);
+    }
+
+    template<typename from_>
+    size_t utf_bulk_ascii_do(uchar_t *to, from_ const* from, size_t size) {
+        using from_char = ifel<sizeof(from_) == 2, char16_t, char32_t>;
+        return utf_bulk_ascii_to_8(to, static_cast<from_char const*>(static_cast<void const*>(from)), size);
+    }
+
+    #endif
+
+    // copy ascii from the pointer from to the pointer to, as long as 16 codepoints at a time are ascii.
+    // returns how many it copied. if the iterators are not pointers it does nothing
+
+    template<unsigned to_, unsigned from_, typename to_iterator_, typename from_iterator_>
+    ifel<utf_bulk<to_, from_, to_iterator_, from_iterator_>, size_t> utf_bulk_ascii(to_iterator_& to, from_iterator_& from, size_t& size) {
+        size_t r = 0;
+        #ifdef WATER_SIMD_SSE2
+        if(size >= 16 && cast(*from) < 0x80) {
+            r = utf_bulk_ascii_do(utf_bulk_to_8<to_>(to), from, size);
+            to += r;
+            from += r;
+            size -= r;
+        }
+        #endif
+        return r;
+    }
+
+    template<unsigned to_, unsigned from_, typename to_iterator_, typename from_iterator_>
+    ifel<utf_bulk<to_, from_, to_iterator_, from_iterator_>, size_t> utf_bulk_ascii(to_iterator_& to, from_iterator_& from, from_iterator_ const& end) {
+        size_t r = 0;
+        #ifdef WATER_SIMD_SSE2
+        if(end - from >= 16 && cast(*from) < 0x80) {
+            r = utf_bulk_ascii_do(utf_bulk_to_8<to_>(to), from, static_cast<size_t>(end - from));
+            to += r;
+            from += r;
+        }
+        #endif
+        return r;
+    }
+
+    template<unsigned to_, unsigned from_, typename to_iterator_, typename from_iterator_, typename size_or_end_>
+    ifel<!utf_bulk<to_, from_, to_iterator_, from_iterator_>, size_t> utf_bulk_ascii(to_iterator_&, from_iterator_&, size_or_end_&) {
+        return 0;
+    }
+
+    #ifdef WATER_SIMD_SSSE3
+
+    class utf8_bulk_verify_block
+    {
+        // keiser and lemire. each bit in the tables is one kind of error, an error is found when the
+        // same bit is set in all 3 lookups. 3 and 4 byte sequences are found by looking 2 and 3 bytes
+        // back.
+        //
+        // 1 too short, lead byte followed by lead byte or ascii
+        // 2 too long, ascii followed by continuation
+        // 4 overlong 3 byte, e0 80-9f
+        // 8 too large, f4 90-bf or f5-ff
+        // 16 surrogate, ed a0-bf
+        // 32 overlong 2 byte, c0-c1
+        // 64 too large 1000 (f4 90-bf) or overlong 4 byte (f0 80-8f)
+        // 128 two continuations, a continuation after a continuation that is not part of a 3 or 4 byte sequence
+
+        __m128i
+            myerror = _mm_setzero_si128(),
+            myprevious = _mm_setzero_si128(),
+            myincomplete = _mm_setzero_si128();
+
+    public:
+        void add(__m128i v) {
+            if(!_mm_movemask_epi8(v)) {
+                // all ascii. if the previous block ended inside a sequence that is an error
+                myerror = _mm_or_si128(myerror, myincomplete);
+                myprevious = v;
+                myincomplete = _mm_setzero_si128();
+                return;
+            }
+            __m128i const
+                low = _mm_set1_epi8(0x0f),
+                byte_1_high = _mm_setr_epi8(
+                    2, 2, 2, 2, 2, 2, 2, 2, // 0-7 ascii
+                    -128, -128, -128, -128, // 8-b continuation
+                    1|32, // c
+                    1, // d
+                    1|4|16, // e
+                    1|8|64 // f
+                ),
+                byte_1_low = _mm_setr_epi8(
+                    -128|1|2|4|32|64, // 0
+                    -128|1|2|32, // 1
+                    -128|1|2, -128|1|2, // 2-3
+                    -128|1|2|8, // 4
+                    -128|1|2|8|64, -128|1|2|8|64, -128|1|2|8|64, -128|1|2|8|64, // 5-8
+                    -128|1|2|8|64, -128|1|2|8|64, -128|1|2|8|64, -128|1|2|8|64, // 9-c
+                    -128|1|2|8|64|16, // d
+                    -128|1|2|8|64, -128|1|2|8|64 // e-f
+                ),
+                byte_2_high = _mm_setr_epi8(
+                    1, 1, 1, 1, 1, 1, 1, 1, // 0-7 ascii
+                    2|-128|4|32|64, // 8
+                    2|-128|4|32|8, // 9
+                    2|-128|16|32|8, 2|-128|16|32|8, // a-b
+                    1, 1, 1, 1 // c-f
+                );
+            __m128i
+                previous1 = _mm_alignr_epi8(v, myprevious, 15),
+                previous2 = _mm_alignr_epi8(v, myprevious, 14),
+                previous3 = _mm_alignr_epi8(v, myprevious, 13);
+            __m128i special = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(previous1, 4), low)),
+                    _mm_shuffle_epi8(byte_1_low, _mm_and_si128(previous1, low))
+                ),
+                _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(v, 4), low))
+            );
+            // bytes 2 and 3 after e0-ef, and 2, 3 and 4 after f0-ff, must be continuations
+            __m128i must_continue = _mm_and_si128(
+                _mm_or_si128(
+                    _mm_subs_epu8(previous2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80))),
+                    _mm_subs_epu8(previous3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)))
+                ),
+                _mm_set1_epi8(static_cast<char>(0x80))
+            );
+            myerror = _mm_or_si128(myerror, _mm_xor_si128(must_continue, special));
+            myprevious = v;
+            // the last 3 bytes can start a sequence that continues in the next block
+            myincomplete = _mm_subs_epu8(v, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1)));
+        }
+
+        bool error() const {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(myerror, _mm_setzero_si128())) != 0xffff;
+        }
+
+        bool incomplete() const {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(myincomplete, _mm_setzero_si128())) != 0xffff;
+        }
+    };
+
+    #endif
+
+    #ifdef WATER_SIMD_SSE2
+
+    inline uchar_t const* utf8_bulk_ascii_end(uchar_t const* begin, uchar_t const* end, bool zero) {
+        // skip ascii 16 bytes at a time. stops at the first non-ascii byte, or a 0 if zero is
+        // false, or when less than a block is left
+        uchar_t const *at = begin;
+        if(at == end || *at >= 0x80)
+            return at;
+        __m128i const zero16 = _mm_setzero_si128();
+        while(end - at >= 16) {
+            __m128i v = utf_bulk_load(at);
+            unsigned m = static_cast<unsigned>(_mm_movemask_epi8(v));
+            if(!zero)
+                m |= static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero16)));
+            if(m)
+                return at + simd_first_bit(m);
+            at += 16;
+        }
+        return at;
+    }
+
+    inline bool utf8_bulk_verify(uchar_t const*& begin, uchar_t const* end, bool zero, size_t& utf16, size_t& utf32) {
+        // verify and count utf-8 from begin, and move begin to where it stopped. it always stops
+        // between codepoints. returns false if it found an error, then begin is not moved.
+        // zero is false if 0 is an error
+        #ifdef WATER_SIMD_SSSE3
+        if(end - begin < 16)
+            return true;
+        utf8_bulk_verify_block verify;
+        __m128i const
+            zero16 = _mm_setzero_si128(),
+            continuation = _mm_set1_epi8(static_cast<char>(0xbf)),
+            four = _mm_set1_epi8(static_cast<char>(0xf0));
+        uchar_t const *at = begin;
+        size_t
+            count16 = 0,
+            count32 = 0;
+        do {
+            __m128i v = utf_bulk_load(at);
+            if(!zero && _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero16)))
+                return false;
+            verify.add(v);
+            // everything that is not a continuation is a codepoint, 4 byte sequences are 2 utf-16
+            unsigned
+                c = simd_count_bits(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, continuation)))),
+                f = simd_count_bits(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, four), v))));
+            count32 += c;
+            count16 += c + f;
+            at += 16;
+        } while(end - at >= 16);
+        if(verify.error())
+            return false;
+        if(verify.incomplete()) {
+            // move back to the first byte of the last sequence
+            do --at; while(*at < 0xc0);
+            --count32;
+            count16 -= *at >= 0xf0 ? 2 : 1;
+        }
+        utf16 += count16;
+        utf32 += count32;
+        begin = at;
+        #else
+        uchar_t const *at = utf8_bulk_ascii_end(begin, end, zero);
+        utf16 += static_cast<size_t>(at - begin);
+        utf32 += static_cast<size_t>(at - begin);
+        begin = at;
+        #endif
+        return true;
+    }
+
+    #endif
+
+    template<typename char_>
+    bool utf8_bulk_length(char_*& begin, char_ *end, bool zero, size_t& utf8, size_t& utf16, size_t& utf32) {
+        // utf8_bulk_verify for utf_length. returns false when it should not be used again
+        #ifdef WATER_SIMD_SSE2
+        uchar_t const
+            *b = static_cast<uchar_t const*>(static_cast<void const*>(begin)),
+            *at = b;
+        bool r = utf8_bulk_verify(at, static_cast<uchar_t const*>(static_cast<void const*>(end)), zero, utf16, utf32);
+        utf8 += static_cast<size_t>(at - b);
+        begin += at - b;
+        return r;
+        #else
+        static_cast<void>(begin);
+        static_cast<void>(end);
+        static_cast<void>(zero);
+        static_cast<void>(utf8);
+        static_cast<void>(utf16);
+        static_cast<void>(utf32);
+        return false;
+        #endif
+    }
+
+}
+
+}}
+#endif
@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -16,8 +16,17 @@ For example this checks that its not 0:
 
 utf_lenght<8> length{begin, end, [](char32_t a) { return a != 0; }};
 
+utf_verify_not_0 does the same. For utf_length<8> with pointers, use it or no verify argument so it
+can look at many bytes at a time, see utf_bulk.hpp.
+
 */
 
+
+struct utf_verify_not_0 {
+    bool operator()(char32_t a) const { return a != 0; }
+};
+
+
 template<unsigned utf_>
 class utf_length
 {
@@ -89,9 +98,48 @@ private:
         bool operator()(char32_t) { return true; }
     };
     
+    template<typename iterator_, typename size_or_end_, typename verify_>
+    bool bulk(iterator_&, size_or_end_ const&, verify_ const&) {
+        return false;
+    }
+
+    template<typename iterator_>
+    ifel<_::utf8_bulk<iterator_>, bool> bulk(iterator_& b, size_t& s, no_verify const&) {
+        return bulk_size(b, s, true);
+    }
+
+    template<typename iterator_>
+    ifel<_::utf8_bulk<iterator_>, bool> bulk(iterator_& b, size_t& s, utf_verify_not_0 const&) {
+        return bulk_size(b, s, false);
+    }
+
+    template<typename iterator_>
+    ifel<_::utf8_bulk<iterator_>, bool> bulk(iterator_& b, iterator_ const& e, no_verify const&) {
+        return _::utf8_bulk_length(b, e, true, my8, my16, my32);
+    }
+
+    template<typename iterator_>
+    ifel<_::utf8_bulk<iterator_>, bool> bulk(iterator_& b, iterator_ const& e, utf_verify_not_0 const&) {
+        return _::utf8_bulk_length(b, e, false, my8, my16, my32);
+    }
+
+    template<typename iterator_>
+    bool bulk_size(iterator_& b, size_t& s, bool zero) {
+        iterator_ a = b;
+        bool r = _::utf8_bulk_length(b, a + s, zero, my8, my16, my32);
+        s -= static_cast<size_t>(b - a);
+        return r;
+    }
+
     template<typename iterator_, typename verify_>
     void length(uchar_t*, iterator_ b, size_t s, verify_&& verify) {
+        bool bulk8 = true;
         while(s) {
+            if(bulk8) {
+                bulk8 = bulk(b, s, verify);
+                if(!s)
+                    return;
+            }
             char32_t c;
             unsigned n = utf8_decode_verify_and_move(c, b, s);
             if(!n || !verify(c)) {
@@ -106,7 +154,13 @@ private:
 
     template<typename iterator_, typename verify_>
     void length(uchar_t*, iterator_ b, iterator_ e, verify_&& verify) {
+        bool bulk8 = true;
         while(b != e) {
+            if(bulk8) {
+                bulk8 = bulk(b, e, verify);
+                if(b == e)
+                    return;
+            }
             char32_t c;
             unsigned n = utf8_decode_verify_and_move(c, b, e);
             if(!n || !verify(c)) {
@@ -1,10 +1,11 @@
-// Copyright 2017-2018 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
 #ifndef WATER_URL_ENCODE_DECODE_HPP
 #define WATER_URL_ENCODE_DECODE_HPP
 #include <water/iterator.hpp> // only need this for forward_iterator_tag
+#include <water/simd.hpp>
 namespace water {
 
 /*
@@ -38,6 +39,21 @@ application/x-www-form-urlencoded says
 
 This will always decode + to space, but url_encode_iterator encodes only if space_as_plus_ is true
 
+The iterators work one character at a time. For text in memory, url_encode and url_decode with
+pointers are faster. They copy 16 bytes at a time when there is nothing to encode or decode, with
+SSE2 if water/simd.hpp says it can be used:
+
+    size_t size = water::url_encode_size(text, text_size);
+    water::vector<char> encoded(size);
+    water::url_encode(encoded.begin(), text, text_size); // returns size
+
+    water::vector<char> decoded(water::url_decode_size(encoded.begin(), size));
+    auto r = water::url_decode(decoded.begin(), encoded.begin(), size);
+    if(r.error())
+        trace() << "error at " << r.used();
+
+url_decode can decode in place, the to and from pointers can be the same.
+
 */
 
 namespace _ {
@@ -417,5 +433,237 @@ auto url_decode_range_from(range_ const& range) -> url_decode_range<decltype(ran
     return {range.begin(), range.end()};
 }
 
+
+
+// url_encode and url_decode with pointers
+
+class url_decode_return {
+    size_t
+        mysize,
+        myused;
+    bool myerror;
+public:
+    url_decode_return() :
+        mysize{},
+        myused{},
+        myerror{}
+    {}
+    url_decode_return(size_t size, size_t used, bool error) :
+        mysize{size},
+        myused{used},
+        myerror{error}
+    {}
+    explicit operator bool() const {
+        return !myerror;
+    }
+    bool error() const {
+        return myerror;
+    }
+    size_t size() const {
+        // bytes written
+        return mysize;
+    }
+    size_t used() const {
+        // bytes used from the input. if error() this is where the error is
+        return myused;
+    }
+};
+
+namespace _ {
+
+    #ifdef WATER_SIMD_SSE2
+
+    inline __m128i url_bulk_load(void const* at) {
+        return _mm_loadu_si128(static_cast<__m128i const*>(at));
+    }
+
+    inline unsigned url_bulk_plain(__m128i v, bool decode) {
+        // a bit for each byte that is not encoded: - . 0-9 A-Z _ a-z, and ~ if decode
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20)); // A-Z to a-z
+        __m128i r = _mm_or_si128(
+            _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), lower)),
+            _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), v))
+        );
+        r = _mm_or_si128(r, _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')), _mm_cmpeq_epi8(v, _mm_set1_epi8('.'))),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('_'))
+        ));
+        if(decode)
+            r = _mm_or_si128(r, _mm_cmpeq_epi8(v, _mm_set1_epi8('~')));
+        return static_cast<unsigned>(_mm_movemask_epi8(r));
+    }
+
+    inline unsigned url_bulk_equal(__m128i v, char a) {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(a))));
+    }
+
+    #endif
+
+    inline void url_encode_byte(unsigned char*& to, unsigned char from, bool space_as_plus) {
+        if(space_as_plus && from == ' ')
+            *to++ = '+';
+        else if(url_encode(from)) {
+            url_encode(to[0], to[1], to[2], from);
+            to += 3;
+        }
+        else
+            *to++ = from;
+    }
+
+    inline size_t url_decode_percent(unsigned char const* at, unsigned char const* end) {
+        // 1 if the % at is followed by two hexadecimal digits
+        unsigned char u = 0;
+        ++at;
+        return url_decode_digit(u, at, end) && url_decode_digit(u, at, end) ? 1 : 0;
+    }
+
+    inline bool url_decode_byte(unsigned char*& to, unsigned char const*& from, unsigned char const* end) {
+        unsigned char c;
+        if(!url_decode(c, from, end))
+            return false;
+        *to++ = c;
+        return true;
+    }
+
+}
+
+inline size_t url_encode_size(void const* from, size_t bytes, bool space_as_plus = false) {
+    // the exact size url_encode will write
+    auto
+        f = static_cast<unsigned char const*>(from),
+        e = f + bytes;
+    size_t r = bytes;
+    #ifdef WATER_SIMD_SSE2
+    while(e - f >= 16) {
+        __m128i v = _::url_bulk_load(f);
+        unsigned m = _::url_bulk_plain(v, false) ^ 0xffff;
+        if(space_as_plus)
+            m &= ~_::url_bulk_equal(v, ' ');
+        r += simd_count_bits(m) * 2;
+        f += 16;
+    }
+    #endif
+    while(f != e) {
+        if(url_encode(*f) && !(space_as_plus && *f == ' '))
+            r += 2;
+        ++f;
+    }
+    return r;
+}
+
+inline size_t url_encode(void *to, void const* from, size_t bytes, bool space_as_plus = false) {
+    // to must have space for url_encode_size(from, bytes, space_as_plus) bytes. returns that size
+    auto t = static_cast<unsigned char*>(to);
+    auto
+        f = static_cast<unsigned char const*>(from),
+        e = f + bytes;
+    #ifdef WATER_SIMD_SSE2
+    while(e - f >= 16) {
+        __m128i v = _::url_bulk_load(f);
+        unsigned m = _::url_bulk_plain(v, false);
+        if(m == 0xffff) {
+            _mm_storeu_si128(static_cast<__m128i*>(static_cast<void*>(t)), v);
+            t += 16;
+        }
+        else {
+            // copy each run of plain bytes, encode the byte after it
+            unsigned encode = m ^ 0xffff, i = 0;
+            if(simd_count_bits(encode) > 4)
+                encode = 0xffff; // the runs are short, one byte at a time
+            while(i != 16) {
+                unsigned n = encode >> i ? simd_first_bit(encode >> i) : 16 - i;
+                for(auto r = f + i, re = r + n; r != re; ++r)
+                    *t++ = *r;
+                i += n;
+                if(i != 16)
+                    _::url_encode_byte(t, f[i++], space_as_plus);
+            }
+        }
+        f += 16;
+    }
+    #endif
+    while(f != e)
+        _::url_encode_byte(t, *f++, space_as_plus);
+    return static_cast<size_t>(t - static_cast<unsigned char*>(to));
+}
+
+inline size_t url_decode_size(void const* from, size_t bytes) {
+    // the exact size url_decode will write if from is valid. if it is not, url_decode writes less
+    //
+    // only a % followed by two hexadecimal digits is counted, url_decode stops at any other %
+    auto
+        f = static_cast<unsigned char const*>(from),
+        e = f + bytes;
+    size_t percent = 0;
+    #ifdef WATER_SIMD_SSE2
+    while(e - f >= 16) {
+        unsigned m = _::url_bulk_equal(_::url_bulk_load(f), '%');
+        while(m) {
+            percent += _::url_decode_percent(f + simd_first_bit(m), e);
+            m &= m - 1;
+        }
+        f += 16;
+    }
+    #endif
+    for(; f != e; ++f)
+        if(*f == '%')
+            percent += _::url_decode_percent(f, e);
+    return bytes - percent * 2;
+}
+
+inline url_decode_return url_decode(void *to, void const* from, size_t bytes) {
+    // to must have space for url_decode_size(from, bytes) bytes. to can be the same as from
+    //
+    // stops at the first error, then to has the bytes decoded before it
+    auto t = static_cast<unsigned char*>(to);
+    auto
+        f = static_cast<unsigned char const*>(from),
+        e = f + bytes;
+    #ifdef WATER_SIMD_SSE2
+    while(e - f >= 16) {
+        __m128i v = _::url_bulk_load(f);
+        unsigned m = _::url_bulk_plain(v, true);
+        if(m == 0xffff) {
+            _mm_storeu_si128(static_cast<__m128i*>(static_cast<void*>(t)), v);
+            t += 16;
+            f += 16;
+        }
+        else {
+            // copy each run of plain bytes, decode the character after it. %XX can end after this block
+            unsigned decode = m ^ 0xffff, i = 0;
+            if(simd_count_bits(decode) > 4) {
+                // the runs are short, one character at a time
+                auto block_end = f + 16;
+                while(f < block_end)
+                    if(!_::url_decode_byte(t, f, e))
+                        return {static_cast<size_t>(t - static_cast<unsigned char*>(to)), static_cast<size_t>(f - static_cast<unsigned char const*>(from)), true};
+                continue;
+            }
+            while(i < 16) {
+                unsigned n = decode >> i ? simd_first_bit(decode >> i) : 16 - i;
+                for(auto r = f + i, re = r + n; r != re; ++r)
+                    *t++ = *r;
+                i += n;
+                if(i < 16) {
+                    auto at = f + i;
+                    if(!_::url_decode_byte(t, at, e))
+                        return {static_cast<size_t>(t - static_cast<unsigned char*>(to)), static_cast<size_t>(at - static_cast<unsigned char const*>(from)), true};
+                    i = static_cast<unsigned>(at - f);
+                }
+            }
+            f += i;
+        }
+    }
+    #endif
+    while(f != e)
+        if(!_::url_decode_byte(t, f, e))
+            return {static_cast<size_t>(t - static_cast<unsigned char*>(to)), static_cast<size_t>(f - static_cast<unsigned char const*>(from)), true};
+    return {static_cast<size_t>(t - static_cast<unsigned char*>(to)), bytes, false};
+}
+
+inline url_decode_return url_decode_in_place(void *text, size_t bytes) {
+    return url_decode(text, text, bytes);
+}
+
 }
 #endif
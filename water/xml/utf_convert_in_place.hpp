@@ -1,4 +1,4 @@
-// Copyright 2018-2023 Johan Paulsson
+// Copyright 2018-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -46,13 +46,13 @@ public:
         mypointer = static_cast<char*>(pointer) + myencoding.byte_order_mark();
         bytes -= myencoding.byte_order_mark();
         if(myencoding.utf8()) {
-            unicode::utf_length<8> length{static_cast<unsigned char*>(mypointer), bytes, [](char32_t a) { return a != 0; }};
+            unicode::utf_length<8> length{static_cast<unsigned char*>(mypointer), bytes, unicode::utf_verify_not_0{}};
             if(length)
                 convert(length, static_cast<unsigned char*>(mypointer), select<utf == 8 ? 1 : 0>{});
         }
         else if(myencoding.utf16() && !(bytes % 2)) {
             auto from = unicode::byterator<16>(mypointer, myencoding.big_endian());
-            unicode::utf_length<16> length{from, bytes / 2, [](char32_t a) { return a != 0; }};
+            unicode::utf_length<16> length{from, bytes / 2, unicode::utf_verify_not_0{}};
             if(length)
                 convert(
                     length,
@@ -62,7 +62,7 @@ public:
         }
         else if(myencoding.utf32() && !(bytes % 4)) {
             auto from = unicode::byterator<32>(mypointer, myencoding.big_endian());
-            unicode::utf_length<32> length{from, bytes / 4, [](char32_t a) { return a != 0; }};
+            unicode::utf_length<32> length{from, bytes / 4, unicode::utf_verify_not_0{}};
             if(length)
                 convert(
                     length,
@@ -1,4 +1,4 @@
-// Copyright 2017-2024 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -81,7 +81,8 @@ unsigned constexpr
     number_lowercase = 1 << 1,
     number_mixedcase = number_uppercase | number_lowercase, // also 0
     number_show_plus = 1 << 2,
-    number_hide_base = 1 << 3;
+    number_hide_base = 1 << 3,
+    number_shortest = 1 << 4;
 
 // number_format
 //
@@ -109,6 +110,7 @@ unsigned constexpr
 // number_mixedcase: (default) will use uppercase hex-digits, exponent EP, nan as NaN, the rest lowercase
 // number_show_plus: write +
 // number_hide_base: do not write 0x 0o 0b
+// number_shortest: base 10 floatingpoint uses the fewest digits that read back as the same value, digits_ is not used
 
 template<
     unsigned base_ = 0,
@@ -130,7 +132,8 @@ struct number_format {
         lowercase = (flags & number_mixedcase) == number_lowercase,
         mixedcase = !uppercase && !lowercase,
         show_plus = (flags & number_show_plus) != 0,
-        hide_base = (flags & number_hide_base) != 0;
+        hide_base = (flags & number_hide_base) != 0,
+        shortest = (flags & number_shortest) != 0;
 };
 
 template<unsigned base_, typename number_format_ = number_format<>>
@@ -187,6 +190,12 @@ using number_format_hide_base = number_format_flags<
     number_format_
 >;
 
+template<bool shortest_, typename number_format_ = number_format<>>
+using number_format_shortest = number_format_flags<
+    shortest_ ? number_format_::flags | number_shortest : number_format_::flags & ~number_shortest,
+    number_format_
+>;
+
 template<typename number_format_ = number_format<>, typename settings_ = settings<>>
 struct configuration {
     using settings = settings_;
@@ -1290,6 +1299,18 @@ auto operator<<(expression<p_, w_>&& x, hide_base_set<hide_base_>* (*)()) -> exp
     return {x};
 }
 
+// o << shortest
+// o << rounded
+
+template<bool> struct shortest_set;
+inline shortest_set<true>* shortest() { return 0; }
+inline shortest_set<false>* rounded() { return 0; }
+
+template<typename p_, typename w_, bool shortest_>
+auto operator<<(expression<p_, w_>&& x, shortest_set<shortest_>* (*)()) -> expression<expression<p_, w_>, set_number_format<number_format_shortest<shortest_, typename expression<p_, w_>::number_format>>> {
+    return {x};
+}
+
 
 
 // bytes
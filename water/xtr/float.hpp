@@ -1,4 +1,4 @@
-// Copyright 2017-2023 Johan Paulsson
+// Copyright 2017-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -7,6 +7,7 @@
 #include <water/xtr/base.hpp>
 #include <water/numeric_limits.hpp>
 #include <water/cmath.hpp>
+#include <water/numbers/shortest.hpp>
 namespace water { namespace xtr {
 
 /*
@@ -34,6 +35,9 @@ Base 10, uses 7 for float and 14 for double and long double (usually, depending
 This should result in somethig that humans expect, 12345 instead of 12344.99999.
 For debugging or for something that computers will convert back into floatingpoint, use digits<> to increase precision.
 
+number_format::shortest writes base 10 float and double with the fewest digits that read back as exactly the
+same value, see numbers/shortest.hpp. Other types use numeric_limits<type>::max_digits10 significant digits.
+
 Always assume exponent can use all digits of int and not that it is limited to max_exponent10 or
 min_exponent from numeric_limts. When there are no real long-double math functions strange things
 happen.
@@ -134,16 +138,27 @@ class write_float
     
     static constexpr unsigned largest(unsigned a, unsigned b) { return a >= b ? a : b; }
     
+    static bool constexpr
+        shortest = number_format_::shortest && number_format_::base == 10,
+        shortest_exact = shortest && numbers::shortest_can<type_>;
+    
     static int constexpr
         digits2 = static_cast<int>(float_digits2<type_>()),
         
         mantissa_digits = // without sign or dot or base-prefix
+            shortest ? numeric_limits<type_>::max_digits10 :
             number_format_::digits > 0 ? number_format_::digits :
             number_format_::base == 2 ? digits2 :
             number_format_::base == 8 ? 1 + (digits2 - 1) / 3 + ((digits2 - 1) % 3 ? 1 : 0) : // 1.777 without dot
             number_format_::base == 16 ? 1 + (digits2 - 1) / 4 + ((digits2 - 1) % 4 ? 1 : 0) : // 1.fff without dot
             numeric_limits<type_>::digits10 < numeric_limits<double>::digits10 - 1 ? numeric_limits<type_>::digits10 + 1 :
             numeric_limits<double>::digits10 - 1,
+        
+        // no exponent when 0 <= exponent < this, if no_exponent_max is -1
+        no_exponent_below =
+            !shortest ? mantissa_digits :
+            numeric_limits<type_>::digits10 < numeric_limits<double>::digits10 - 1 ? numeric_limits<type_>::digits10 + 1 :
+            numeric_limits<double>::digits10 - 1,
             
         // if base 10 the no exponent form could be larger than the maximum exponent form
         // no_exponent_max is the number of digits
@@ -199,19 +214,33 @@ public:
                 leading_zeros = 0,
                 trailing_zeros = 0,
                 digits;
+            uint_bits_at_least<64>
+                exact = 0, // digits from numbers::shortest
+                exact_divide = 1;
             if(!m) {
                 digits = 1;
                 exponent = base != 10 || number_format_::no_exponent_max == 0;
             }
             else if(constant(base == 10)) {
-                e = static_cast<int>(log10(m));
-                int p = e;
-                if(m < numeric_limits<double_>::min()) // subnormal
-                    do ++p; while((m *= static_cast<double_>(10)) < numeric_limits<double_>::min());
-                m /= pow(static_cast<double_>(10), static_cast<double_>(p));
-                digits = round(m, e, round_last_digit);
+                if(constant(shortest_exact)) {
+                    numbers::shortest s{static_cast<type_>(m)};
+                    exact = s.digits();
+                    digits = static_cast<int>(s.size());
+                    e = s.exponent() + digits - 1;
+                    for(int d = 1; d != digits; ++d)
+                        exact_divide *= 10;
+                    m = 0; // float_digits is not used
+                }
+                else {
+                    e = static_cast<int>(log10(m));
+                    int p = e;
+                    if(m < numeric_limits<double_>::min()) // subnormal
+                        do ++p; while((m *= static_cast<double_>(10)) < numeric_limits<double_>::min());
+                    m /= pow(static_cast<double_>(10), static_cast<double_>(p));
+                    digits = round(m, e, round_last_digit);
+                }
                 if(
-                    (constant(number_format_::no_exponent_max) < 0 && 0 <= e && e < mantissa_digits) ||
+                    (constant(number_format_::no_exponent_max) < 0 && 0 <= e && e < no_exponent_below) ||
                     (constant(number_format_::no_exponent_max) > 0 && e >= 0 && number_format_::no_exponent_max >= e)
                 ) {
                     // 123000 or 123.456
@@ -247,7 +276,14 @@ public:
             do {
                 if(at == point_at)
                     write(static_cast<char>(u'.'));
-                unsigned d = *i;
+                unsigned d;
+                if(constant(shortest_exact)) {
+                    d = static_cast<unsigned>(exact / exact_divide);
+                    exact %= exact_divide;
+                    exact_divide /= 10;
+                }
+                else
+                    d = *i;
                 if(++at == digits && round_last_digit)
                     ++d;
                 write(_::digits[!number_format_::lowercase][d & 0xf]);
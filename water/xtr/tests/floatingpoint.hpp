@@ -1,4 +1,4 @@
-// Copyright 2023 Johan Paulsson
+// Copyright 2023-2026 Johan Paulsson
 // This file is part of the Water C++ Library. It is licensed under the MIT License.
 // See the license.txt file in this distribution or https://watercpp.com/license.txt
 //\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_/\_
@@ -108,6 +108,23 @@ inline void floatingpoint() {
         "1234.5 1.2345E3 1234.5"
     ));
     
+    // shortest
+    
+    ___water_test(equal(
+        no << shortest << 1.1 << ' ' << -0.1 << ' ' << 1.0 / 3 << ' ' << 5e-324 << ' ' << 1.7976931348623157e308 << ' ' << 0.0 << ' ' << 1e13 << ' ' << 1e14,
+        "1.1 -1E-1 3.333333333333333E-1 5E-324 1.7976931348623157E308 0 10000000000000 1E14"
+    ));
+    
+    ___water_test(equal(
+        no << shortest << 1.1f << ' ' << 1.0f / 3 << ' ' << 16777216.f << ' ' << 1e-45f << ' ' << digits<3> << 123.456f,
+        "1.1 3.3333334E-1 1.6777216E7 1E-45 123.456"
+    ));
+    
+    ___water_test(equal(
+        no << shortest << no_exponent_min_max<-20, 20> << 0.001 << ' ' << 1.5e20 << ' ' << 0.1 + 0.2 << ' ' << rounded << 0.1 + 0.2,
+        "0.001 150000000000000000000 0.30000000000000004 0.3"
+    ));
+    
 }
 
 }}}